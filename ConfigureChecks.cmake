@@ -103,6 +103,37 @@ check_cxx_source_compiles("
   }
 " HAVE_ISO_STRDUP)
 
+# Determine whether the system can copy file data in the kernel.
+
+check_cxx_source_compiles("
+  #include <unistd.h>
+  int main() {
+    off_t offset = 0;
+    copy_file_range(0, &offset, 1, 0, 0, 0);
+    return 0;
+  }
+" HAVE_COPY_FILE_RANGE)
+
+check_cxx_source_compiles("
+  #include <sys/sendfile.h>
+  int main() {
+    off_t offset = 0;
+    sendfile(1, 0, &offset, 0);
+    return 0;
+  }
+" HAVE_SENDFILE)
+
+# Determine whether the file system can remove a range without moving data.
+
+check_cxx_source_compiles("
+  #include <fcntl.h>
+  #include <linux/falloc.h>
+  int main() {
+    fallocate(0, FALLOC_FL_COLLAPSE_RANGE, 0, 0);
+    return 0;
+  }
+" HAVE_FALLOC_FL_COLLAPSE_RANGE)
+
 # Detect WinRT mode
 if(CMAKE_SYSTEM_NAME STREQUAL "WindowsStore")
   set(PLATFORM_WINRT 1)
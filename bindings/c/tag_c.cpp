@@ -35,26 +35,6 @@
 #include "tfile.h"
 #include "tpropertymap.h"
 #include "fileref.h"
-#include "asffile.h"
-#include "vorbisfile.h"
-#include "mpegfile.h"
-#include "flacfile.h"
-#include "oggflacfile.h"
-#include "mpcfile.h"
-#include "wavpackfile.h"
-#include "speexfile.h"
-#include "trueaudiofile.h"
-#include "mp4file.h"
-#include "aifffile.h"
-#include "wavfile.h"
-#include "apefile.h"
-#include "itfile.h"
-#include "modfile.h"
-#include "s3mfile.h"
-#include "xmfile.h"
-#include "opusfile.h"
-#include "dsffile.h"
-#include "dsdifffile.h"
 #include "tag.h"
 #include "id3v2framefactory.h"
 
@@ -128,71 +108,17 @@ TagLib_File *taglib_file_new(const char *filename)
 
 TagLib_File *taglib_file_new_type(const char *filename, TagLib_File_Type type)
 {
-  File *file = NULL;
-  switch(type) {
-  case TagLib_File_MPEG:
-    file = new MPEG::File(filename);
-      break;
-  case TagLib_File_OggVorbis:
-    file = new Ogg::Vorbis::File(filename);
-    break;
-  case TagLib_File_FLAC:
-    file = new FLAC::File(filename);
-    break;
-  case TagLib_File_MPC:
-    file = new MPC::File(filename);
-    break;
-  case TagLib_File_OggFlac:
-    file = new Ogg::FLAC::File(filename);
-    break;
-  case TagLib_File_WavPack:
-    file = new WavPack::File(filename);
-    break;
-  case TagLib_File_Speex:
-    file = new Ogg::Speex::File(filename);
-    break;
-  case TagLib_File_TrueAudio:
-    file = new TrueAudio::File(filename);
-    break;
-  case TagLib_File_MP4:
-    file = new MP4::File(filename);
-    break;
-  case TagLib_File_ASF:
-    file = new ASF::File(filename);
-    break;
-  case TagLib_File_AIFF:
-    file = new RIFF::AIFF::File(filename);
-    break;
-  case TagLib_File_WAV:
-    file = new RIFF::WAV::File(filename);
-    break;
-  case TagLib_File_APE:
-    file = new APE::File(filename);
-    break;
-  case TagLib_File_IT:
-    file = new IT::File(filename);
-    break;
-  case TagLib_File_Mod:
-    file = new Mod::File(filename);
-    break;
-  case TagLib_File_S3M:
-    file = new S3M::File(filename);
-    break;
-  case TagLib_File_XM:
-    file = new XM::File(filename);
-    break;
-  case TagLib_File_Opus:
-    file = new Ogg::Opus::File(filename);
-    break;
-  case TagLib_File_DSF:
-    file = new DSF::File(filename);
-    break;
-  case TagLib_File_DSDIFF:
-    file = new DSDIFF::File(filename);
-    break;
-  default:
-    break;
-  }
+  // Names of the formats in the FileRef registry in the order of TagLib_File_Type
+  static const char *const formatNames[] = {
+    "MPEG", "OggVorbis", "FLAC", "MPC", "OggFLAC", "WavPack", "Speex",
+    "TrueAudio", "MP4", "ASF", "AIFF", "WAV", "APE", "IT", "Mod", "S3M", "XM",
+    "Opus", "DSF", "DSDIFF"
+  };
+
+  if(type < 0 || type >= static_cast<int>(sizeof(formatNames) / sizeof(formatNames[0])))
+    return NULL;
+
+  File *file = FileRef::createFile(formatNames[type], filename);
   return file ? reinterpret_cast<TagLib_File *>(new FileRef(file)) : NULL;
 }
 
@@ -290,6 +216,28 @@ unsigned int taglib_tag_track(const TagLib_Tag *tag)
   return t->track();
 }
 
+void taglib_tag_basic_fields(const TagLib_Tag *tag, TagLib_Basic_Fields *fields)
+{
+  auto t = reinterpret_cast<const Tag *>(tag);
+  Tag::BasicFields basicFields;
+  t->basicFields(basicFields);
+
+  const auto toCharArray = [](const String &str) {
+    char *s = stringToCharArray(str);
+    if(stringManagementEnabled)
+      strings.append(s);
+    return s;
+  };
+
+  fields->title = toCharArray(basicFields.title);
+  fields->artist = toCharArray(basicFields.artist);
+  fields->album = toCharArray(basicFields.album);
+  fields->comment = toCharArray(basicFields.comment);
+  fields->genre = toCharArray(basicFields.genre);
+  fields->year = basicFields.year;
+  fields->track = basicFields.track;
+}
+
 void taglib_tag_set_title(TagLib_Tag *tag, const char *title)
 {
   auto t = reinterpret_cast<Tag *>(tag);
@@ -241,6 +241,30 @@ TAGLIB_C_EXPORT unsigned int taglib_tag_year(const TagLib_Tag *tag);
  */
 TAGLIB_C_EXPORT unsigned int taglib_tag_track(const TagLib_Tag *tag);
 
+/*!
+ * The basic fields of a tag as returned by taglib_tag_basic_fields().
+ */
+typedef struct {
+  char *title;
+  char *artist;
+  char *album;
+  char *comment;
+  char *genre;
+  unsigned int year;
+  unsigned int track;
+} TagLib_Basic_Fields;
+
+/*!
+ * Sets \a fields to the title, artist, album, comment, genre, year and track
+ * of \a tag.  This is faster than calling taglib_tag_title() and the other
+ * functions one by one.
+ *
+ * \note By default the strings should be UTF8 encoded and their memory should
+ * be freed using taglib_tag_free_strings().
+ */
+TAGLIB_C_EXPORT void taglib_tag_basic_fields(const TagLib_Tag *tag,
+                                             TagLib_Basic_Fields *fields);
+
 /*!
  * Sets the tag's title.
  *
@@ -13,6 +13,13 @@
 /* Defined if your compiler supports ISO _strdup */
 #cmakedefine   HAVE_ISO_STRDUP 1
 
+/* Defined if the system supports copying file data in the kernel */
+#cmakedefine   HAVE_COPY_FILE_RANGE 1
+#cmakedefine   HAVE_SENDFILE 1
+
+/* Defined if the file system can collapse a range of a file */
+#cmakedefine   HAVE_FALLOC_FL_COLLAPSE_RANGE 1
+
 /* Defined if zlib is installed */
 #cmakedefine   HAVE_ZLIB 1
 
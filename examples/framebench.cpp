@@ -0,0 +1,136 @@
+/* Copyright (C) 2026 agent <agent@local>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Measures the time needed to parse an ID3v2 tag with 300 frames of
+// different types, i.e. mainly the frame dispatch of the FrameFactory.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "tbytevectorstream.h"
+#include "mpegfile.h"
+#include "id3v2tag.h"
+#include "attachedpictureframe.h"
+#include "commentsframe.h"
+#include "privateframe.h"
+#include "textidentificationframe.h"
+#include "urllinkframe.h"
+
+using namespace TagLib;
+
+namespace
+{
+  ByteVector createTag()
+  {
+    static const char *const textFrameIDs[] = {
+      "TIT2", "TPE1", "TALB", "TCON", "TRCK", "TPOS", "TCOM", "TSOP",
+      "TXXX", "MVNM"
+    };
+    static const char *const urlFrameIDs[] = {
+      "WOAR", "WOAF", "WCOM", "WXXX"
+    };
+
+    ByteVectorStream stream((ByteVector()));
+    MPEG::File file(&stream, false);
+    ID3v2::Tag *tag = file.ID3v2Tag(true);
+    for(int i = 0; i < 300; ++i) {
+      const String value = String::number(i);
+      switch(i % 5) {
+      case 0:
+      case 1:
+      {
+        const char *frameID = textFrameIDs[i % std::size(textFrameIDs)];
+        ID3v2::TextIdentificationFrame *frame = ByteVector(frameID) == "TXXX"
+          ? new ID3v2::UserTextIdentificationFrame("Description " + value, {value})
+          : new ID3v2::TextIdentificationFrame(frameID);
+        frame->setText(value);
+        tag->addFrame(frame);
+        break;
+      }
+      case 2:
+      {
+        const char *frameID = urlFrameIDs[i % std::size(urlFrameIDs)];
+        if(ByteVector(frameID) == "WXXX") {
+          auto frame = new ID3v2::UserUrlLinkFrame;
+          frame->setUrl("https://example.com/" + value);
+          tag->addFrame(frame);
+        }
+        else {
+          auto frame = new ID3v2::UrlLinkFrame(frameID);
+          frame->setUrl("https://example.com/" + value);
+          tag->addFrame(frame);
+        }
+        break;
+      }
+      case 3:
+      {
+        auto frame = new ID3v2::CommentsFrame;
+        frame->setDescription(value);
+        frame->setText("Comment " + value);
+        tag->addFrame(frame);
+        break;
+      }
+      default:
+      {
+        auto frame = new ID3v2::PrivateFrame;
+        frame->setOwner("owner" + value);
+        frame->setData(ByteVector(16, 'x'));
+        tag->addFrame(frame);
+        break;
+      }
+      }
+    }
+    return tag->render();
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 1000;
+  if(iterations <= 0) {
+    std::cout << "Usage: framebench [ITERATIONS]" << std::endl;
+    return 1;
+  }
+
+  const ByteVector tagData = createTag();
+
+  unsigned int frameCount = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < iterations; ++i) {
+    ByteVectorStream stream(tagData);
+    MPEG::File file(&stream, false);
+    frameCount += file.ID3v2Tag()->frameList().size();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - start).count();
+
+  std::cout << "Parsed " << iterations << " tags with "
+            << frameCount / iterations << " frames ("
+            << tagData.size() << " bytes)" << std::endl;
+  std::cout << elapsed / iterations / 1000 << " us per tag, "
+            << elapsed / frameCount << " ns per frame" << std::endl;
+
+  return 0;
+}
@@ -23,19 +23,62 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstring>
 
 #include "tstring.h"
+#include "tfilestream.h"
 #include "mpegfile.h"
 
 using namespace TagLib;
 
+namespace
+{
+  // Writes the file without the ID3v1 tag to a temporary file, which then
+  // replaces the original file, instead of modifying the file in place.
+
+  bool stripToCopy(const char *fileName)
+  {
+    const std::string copyName = std::string(fileName) + ".strip";
+    std::ofstream(copyName, std::ios::binary | std::ios::trunc);
+
+    bool stripped;
+    {
+      MPEG::File f(fileName, false);
+      FileStream copy(copyName.c_str());
+      stripped = f.isValid() && copy.isOpen() && f.stripTo(MPEG::File::ID3v1, &copy);
+    }
+
+    if(!stripped || std::rename(copyName.c_str(), fileName) != 0) {
+      std::remove(copyName.c_str());
+      return false;
+    }
+    return true;
+  }
+}  // namespace
+
 int main(int argc, char *argv[])
 {
+  bool copy = false;
+
   for(int i = 1; i < argc; i++) {
 
+    if(std::strcmp(argv[i], "-c") == 0) {
+      copy = true;
+      continue;
+    }
+
     std::cout << "******************** Stripping ID3v1 Tag From: \"" << argv[i] << "\"********************" << std::endl;
 
-    MPEG::File f(argv[i]);
-    f.strip(MPEG::File::ID3v1);
+    if(copy) {
+      if(!stripToCopy(argv[i]))
+        std::cout << "Could not write the stripped file." << std::endl;
+    }
+    else {
+      MPEG::File f(argv[i]);
+      f.strip(MPEG::File::ID3v1);
+    }
   }
 }
@@ -47,13 +47,16 @@ int main(int argc, char *argv[])
       TagLib::Tag *tag = f.tag();
 
       cout << "-- TAG (basic) --" << endl;
-      cout << "title   - \"" << tag->title()   << "\"" << endl;
-      cout << "artist  - \"" << tag->artist()  << "\"" << endl;
-      cout << "album   - \"" << tag->album()   << "\"" << endl;
-      cout << "year    - \"" << tag->year()    << "\"" << endl;
-      cout << "comment - \"" << tag->comment() << "\"" << endl;
-      cout << "track   - \"" << tag->track()   << "\"" << endl;
-      cout << "genre   - \"" << tag->genre()   << "\"" << endl;
+      TagLib::Tag::BasicFields fields;
+      tag->basicFields(fields);
+
+      cout << "title   - \"" << fields.title   << "\"" << endl;
+      cout << "artist  - \"" << fields.artist  << "\"" << endl;
+      cout << "album   - \"" << fields.album   << "\"" << endl;
+      cout << "year    - \"" << fields.year    << "\"" << endl;
+      cout << "comment - \"" << fields.comment << "\"" << endl;
+      cout << "track   - \"" << fields.track   << "\"" << endl;
+      cout << "genre   - \"" << fields.genre   << "\"" << endl;
 
       TagLib::PropertyMap tags = f.properties();
       if(!tags.isEmpty()) {
@@ -57,14 +57,17 @@ int main(int argc, char *argv[])
     complexKeys = taglib_complex_property_keys(file);
 
     if(tag != NULL) {
+      TagLib_Basic_Fields fields;
+      taglib_tag_basic_fields(tag, &fields);
+
       printf("-- TAG (basic) --\n");
-      printf("title   - \"%s\"\n", taglib_tag_title(tag));
-      printf("artist  - \"%s\"\n", taglib_tag_artist(tag));
-      printf("album   - \"%s\"\n", taglib_tag_album(tag));
-      printf("year    - \"%u\"\n", taglib_tag_year(tag));
-      printf("comment - \"%s\"\n", taglib_tag_comment(tag));
-      printf("track   - \"%u\"\n", taglib_tag_track(tag));
-      printf("genre   - \"%s\"\n", taglib_tag_genre(tag));
+      printf("title   - \"%s\"\n", fields.title);
+      printf("artist  - \"%s\"\n", fields.artist);
+      printf("album   - \"%s\"\n", fields.album);
+      printf("year    - \"%u\"\n", fields.year);
+      printf("comment - \"%s\"\n", fields.comment);
+      printf("track   - \"%u\"\n", fields.track);
+      printf("genre   - \"%s\"\n", fields.genre);
     }
 
 
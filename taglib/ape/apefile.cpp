@@ -82,20 +82,20 @@ bool APE::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-APE::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+APE::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-APE::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
+APE::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 APE::File::~File() = default;
@@ -222,6 +222,19 @@ void APE::File::strip(int tags)
     APETag(true);
 }
 
+bool APE::File::stripTo(int tags, IOStream *target)
+{
+  Map<offset_t, size_t> skippedBlocks;
+
+  if((tags & APE) && d->APELocation >= 0)
+    skippedBlocks.insert(d->APELocation, d->APESize);
+
+  if((tags & ID3v1) && d->ID3v1Location >= 0)
+    skippedBlocks.insert(d->ID3v1Location, 128);
+
+  return copyTo(target, skippedBlocks);
+}
+
 bool APE::File::hasAPETag() const
 {
   return d->APELocation >= 0;
@@ -200,6 +200,18 @@ namespace TagLib {
        */
       void strip(int tags = AllTags);
 
+      /*!
+       * Writes the file without the tags that match the OR-ed together
+       * TagTypes to \a target, which is overwritten.  The rest of the file is
+       * copied sequentially, so no part of the file has to be moved in place.
+       * This file and its tags are not modified, unsaved changes are not
+       * written to \a target.  It returns \c true if the file has been written
+       * successfully.
+       *
+       * \see TagLib::File::copyTo()
+       */
+      bool stripTo(int tags, IOStream *target);
+
       /*!
        * Returns whether or not the file on disk actually has an APE tag.
        *
@@ -93,6 +93,15 @@ APE::Tag::Tag(TagLib::File *file, offset_t footerLocation) :
   read();
 }
 
+APE::Tag::Tag(TagLib::File *file, offset_t footerLocation, const ByteVector &data) :
+  d(std::make_unique<TagPrivate>())
+{
+  d->file = file;
+  d->footerLocation = footerLocation;
+
+  read(data);
+}
+
 APE::Tag::~Tag() = default;
 
 ByteVector APE::Tag::fileIdentifier()
@@ -142,6 +151,31 @@ unsigned int APE::Tag::track() const
   return val.isEmpty() ? 0 : val.toString().toInt();
 }
 
+void APE::Tag::basicFields(BasicFields &fields) const
+{
+  // The items are accessed by reference instead of copying them as the
+  // accessors do.
+
+  const auto item = [this](const char *key) -> const Item * {
+    const auto it = d->itemListMap.find(key);
+    return it != d->itemListMap.end() && !it->second.isEmpty() ? &it->second : nullptr;
+  };
+  const auto text = [&item](const char *key) {
+    const Item *val = item(key);
+    return val ? joinTagValues(val->values()) : String();
+  };
+
+  fields.title = text("TITLE");
+  fields.artist = text("ARTIST");
+  fields.album = text("ALBUM");
+  fields.comment = text("COMMENT");
+  fields.genre = text("GENRE");
+  const Item *year = item("YEAR");
+  fields.year = year ? year->toString().toInt() : 0;
+  const Item *track = item("TRACK");
+  fields.track = track ? track->toString().toInt() : 0;
+}
+
 void APE::Tag::setTitle(const String &s)
 {
   addValue("TITLE", s, true);
@@ -428,18 +462,41 @@ bool APE::Tag::isEmpty() const
 ////////////////////////////////////////////////////////////////////////////////
 
 void APE::Tag::read()
+{
+  read(ByteVector());
+}
+
+void APE::Tag::read(const ByteVector &data)
 {
   if(d->file && d->file->isValid()) {
 
-    d->file->seek(d->footerLocation);
-    d->footer.setData(d->file->readBlock(Footer::size()));
+    ByteVector tagData = data;
+    if(tagData.size() < Footer::size()) {
+      d->file->seek(d->footerLocation);
+      tagData = d->file->readBlock(Footer::size());
+      if(tagData.size() < Footer::size())
+        return;
+    }
+
+    const unsigned int available = tagData.size() - Footer::size();
+    d->footer.setData(tagData.mid(available));
 
     if(d->footer.tagSize() <= Footer::size() ||
        d->footer.tagSize() > static_cast<unsigned long>(d->file->length()))
       return;
 
-    d->file->seek(d->footerLocation + Footer::size() - d->footer.tagSize());
-    parse(d->file->readBlock(d->footer.tagSize() - Footer::size()));
+    // Only read the part of the tag which precedes the data we already have.
+
+    const unsigned int bodySize = d->footer.tagSize() - Footer::size();
+    if(available >= bodySize) {
+      parse(tagData.mid(available - bodySize, bodySize));
+    }
+    else {
+      d->file->seek(d->footerLocation + Footer::size() - d->footer.tagSize());
+      ByteVector body = d->file->readBlock(bodySize - available);
+      body.append(tagData.mid(0, available));
+      parse(body);
+    }
   }
 }
 
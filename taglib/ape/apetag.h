@@ -67,6 +67,16 @@ namespace TagLib {
        */
       Tag(TagLib::File *file, offset_t footerLocation);
 
+      /*!
+       * Create an APE tag with APE footer at \a footerLocation in \a file as
+       * above, but take the footer and the end of the tag from \a data, which
+       * the caller has already read and which ends with the footer.  Only the
+       * part of the tag which is not covered by \a data is read from the file.
+       *
+       * \see read(const ByteVector &)
+       */
+      Tag(TagLib::File *file, offset_t footerLocation, const ByteVector &data);
+
       /*!
        * Destroys this Tag instance.
        */
@@ -96,6 +106,7 @@ namespace TagLib {
       String genre() const override;
       unsigned int year() const override;
       unsigned int track() const override;
+      void basicFields(BasicFields &fields) const override;
 
       void setTitle(const String &s) override;
       void setArtist(const String &s) override;
@@ -197,6 +208,12 @@ namespace TagLib {
        */
       void read();
 
+      /*!
+       * Reads the tag like read(), using \a data, which ends with the footer,
+       * as the end of the tag.
+       */
+      void read(const ByteVector &data);
+
       /*!
        * Parses the body of the tag in \a data.
        */
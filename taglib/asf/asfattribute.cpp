@@ -166,6 +166,7 @@ String ASF::Attribute::parse(ASF::File &file, int kind)
 {
   unsigned int size, nameLength;
   String name;
+  offset_t valueOffset = 0;
   d->pictureValue = Picture::fromInvalid();
   // extended content descriptor
   if(kind == 0) {
@@ -220,6 +221,7 @@ String ASF::Attribute::parse(ASF::File &file, int kind)
 
   case BytesType:
   case GuidType:
+    valueOffset = file.tell();
     d->byteVectorValue = file.readBlock(size);
     break;
   }
@@ -227,6 +229,10 @@ String ASF::Attribute::parse(ASF::File &file, int kind)
   if(d->type == BytesType && name == "WM/Picture") {
     d->pictureValue.parse(d->byteVectorValue);
     if(d->pictureValue.isValid()) {
+      // The image data is at the end of the value.
+      const unsigned int dataSize = d->pictureValue.picture().size();
+      d->pictureValue.setPictureReference(PictureReference(
+        &file, valueOffset + d->byteVectorValue.size() - dataSize, dataSize));
       d->byteVectorValue.clear();
     }
   }
@@ -25,6 +25,7 @@
 
 #include "asffile.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "tdebug.h"
@@ -73,6 +74,10 @@ public:
   HeaderExtensionObject *headerExtensionObject { nullptr };
   MetadataObject *metadataObject { nullptr };
   MetadataLibraryObject *metadataLibraryObject { nullptr };
+
+  void updateObjects(offset_t paddingSize);
+
+  static ByteVector renderAttributes(const ASF::Tag *tag, int kind);
 };
 
 namespace
@@ -89,6 +94,7 @@ namespace
   const ByteVector contentEncryptionGuid("\xFB\xB3\x11\x22\x23\xBD\xD2\x11\xB4\xB7\x00\xA0\xC9\x55\xFC\x6E", 16);
   const ByteVector extendedContentEncryptionGuid("\x14\xE6\x8A\x29\x22\x26 \x17\x4C\xB9\x35\xDA\xE0\x7E\xE9\x28\x9C", 16);
   const ByteVector advancedContentEncryptionGuid("\xB6\x9B\x07\x7A\xA4\xDA\x12\x4E\xA5\xCA\x91\xD3\x8D\xC1\x1A\x8D", 16);
+  const ByteVector paddingGuid("\x74\xD4\x06\x18\xDF\xCA\x09\x45\xA4\xBA\x9A\xAB\xCB\x96\xAA\xE8", 16);
 }  // namespace
 
 class ASF::File::FilePrivate::BaseObject
@@ -98,7 +104,10 @@ public:
   virtual ~BaseObject() = default;
   virtual ByteVector guid() const = 0;
   virtual void parse(ASF::File *file, long long size);
-  virtual ByteVector render(ASF::File *file);
+  virtual ByteVector render(const ASF::File *file) const;
+
+protected:
+  ByteVector render(const ByteVector &objectData) const;
 };
 
 class ASF::File::FilePrivate::UnknownObject : public ASF::File::FilePrivate::BaseObject
@@ -128,34 +137,31 @@ class ASF::File::FilePrivate::ContentDescriptionObject : public ASF::File::FileP
 public:
   ByteVector guid() const override;
   void parse(ASF::File *file, long long size) override;
-  ByteVector render(ASF::File *file) override;
+  ByteVector render(const ASF::File *file) const override;
 };
 
 class ASF::File::FilePrivate::ExtendedContentDescriptionObject : public ASF::File::FilePrivate::BaseObject
 {
 public:
-  ByteVectorList attributeData;
   ByteVector guid() const override;
   void parse(ASF::File *file, long long size) override;
-  ByteVector render(ASF::File *file) override;
+  ByteVector render(const ASF::File *file) const override;
 };
 
 class ASF::File::FilePrivate::MetadataObject : public ASF::File::FilePrivate::BaseObject
 {
 public:
-  ByteVectorList attributeData;
   ByteVector guid() const override;
   void parse(ASF::File *file, long long size) override;
-  ByteVector render(ASF::File *file) override;
+  ByteVector render(const ASF::File *file) const override;
 };
 
 class ASF::File::FilePrivate::MetadataLibraryObject : public ASF::File::FilePrivate::BaseObject
 {
 public:
-  ByteVectorList attributeData;
   ByteVector guid() const override;
   void parse(ASF::File *file, long long size) override;
-  ByteVector render(ASF::File *file) override;
+  ByteVector render(const ASF::File *file) const override;
 };
 
 class ASF::File::FilePrivate::HeaderExtensionObject : public ASF::File::FilePrivate::BaseObject
@@ -165,7 +171,7 @@ public:
   HeaderExtensionObject();
   ByteVector guid() const override;
   void parse(ASF::File *file, long long size) override;
-  ByteVector render(ASF::File *file) override;
+  ByteVector render(const ASF::File *file) const override;
 };
 
 class ASF::File::FilePrivate::CodecListObject : public ASF::File::FilePrivate::BaseObject
@@ -192,9 +198,14 @@ void ASF::File::FilePrivate::BaseObject::parse(ASF::File *file, long long size)
     data = ByteVector();
 }
 
-ByteVector ASF::File::FilePrivate::BaseObject::render(ASF::File * /*file*/)
+ByteVector ASF::File::FilePrivate::BaseObject::render(const ASF::File * /*file*/) const
 {
-  return guid() + ByteVector::fromLongLong(data.size() + 24, false) + data;
+  return render(data);
+}
+
+ByteVector ASF::File::FilePrivate::BaseObject::render(const ByteVector &objectData) const
+{
+  return guid() + ByteVector::fromLongLong(objectData.size() + 24, false) + objectData;
 }
 
 ASF::File::FilePrivate::UnknownObject::UnknownObject(const ByteVector &guid) : myGuid(guid)
@@ -219,6 +230,9 @@ void ASF::File::FilePrivate::FilePropertiesObject::parse(ASF::File *file, long l
     return;
   }
 
+  if(!file->d->properties)
+    return;
+
   const long long duration = data.toLongLong(40, false);
   const long long preroll  = data.toLongLong(56, false);
   file->d->properties->setLengthInMilliseconds(static_cast<int>(duration / 10000.0 - preroll + 0.5));
@@ -237,6 +251,9 @@ void ASF::File::FilePrivate::StreamPropertiesObject::parse(ASF::File *file, long
     return;
   }
 
+  if(!file->d->properties)
+    return;
+
   file->d->properties->setCodec(data.toUShort(54, false));
   file->d->properties->setChannels(data.toUShort(56, false));
   file->d->properties->setSampleRate(data.toUInt(58, false));
@@ -263,25 +280,25 @@ void ASF::File::FilePrivate::ContentDescriptionObject::parse(ASF::File *file, lo
   file->d->tag->setRating(readString(file,ratingLength));
 }
 
-ByteVector ASF::File::FilePrivate::ContentDescriptionObject::render(ASF::File *file)
+ByteVector ASF::File::FilePrivate::ContentDescriptionObject::render(const ASF::File *file) const
 {
   const ByteVector v1 = renderString(file->d->tag->title());
   const ByteVector v2 = renderString(file->d->tag->artist());
   const ByteVector v3 = renderString(file->d->tag->copyright());
   const ByteVector v4 = renderString(file->d->tag->comment());
   const ByteVector v5 = renderString(file->d->tag->rating());
-  data.clear();
-  data.append(ByteVector::fromShort(v1.size(), false));
-  data.append(ByteVector::fromShort(v2.size(), false));
-  data.append(ByteVector::fromShort(v3.size(), false));
-  data.append(ByteVector::fromShort(v4.size(), false));
-  data.append(ByteVector::fromShort(v5.size(), false));
-  data.append(v1);
-  data.append(v2);
-  data.append(v3);
-  data.append(v4);
-  data.append(v5);
-  return BaseObject::render(file);
+  ByteVector objectData;
+  objectData.append(ByteVector::fromShort(v1.size(), false));
+  objectData.append(ByteVector::fromShort(v2.size(), false));
+  objectData.append(ByteVector::fromShort(v3.size(), false));
+  objectData.append(ByteVector::fromShort(v4.size(), false));
+  objectData.append(ByteVector::fromShort(v5.size(), false));
+  objectData.append(v1);
+  objectData.append(v2);
+  objectData.append(v3);
+  objectData.append(v4);
+  objectData.append(v5);
+  return BaseObject::render(objectData);
 }
 
 ByteVector ASF::File::FilePrivate::ExtendedContentDescriptionObject::guid() const
@@ -299,12 +316,9 @@ void ASF::File::FilePrivate::ExtendedContentDescriptionObject::parse(ASF::File *
   }
 }
 
-ByteVector ASF::File::FilePrivate::ExtendedContentDescriptionObject::render(ASF::File *file)
+ByteVector ASF::File::FilePrivate::ExtendedContentDescriptionObject::render(const ASF::File *file) const
 {
-  data.clear();
-  data.append(ByteVector::fromShort(attributeData.size(), false));
-  data.append(attributeData.toByteVector(""));
-  return BaseObject::render(file);
+  return BaseObject::render(FilePrivate::renderAttributes(file->d->tag.get(), 0));
 }
 
 ByteVector ASF::File::FilePrivate::MetadataObject::guid() const
@@ -322,12 +336,9 @@ void ASF::File::FilePrivate::MetadataObject::parse(ASF::File *file, long long /*
   }
 }
 
-ByteVector ASF::File::FilePrivate::MetadataObject::render(ASF::File *file)
+ByteVector ASF::File::FilePrivate::MetadataObject::render(const ASF::File *file) const
 {
-  data.clear();
-  data.append(ByteVector::fromShort(attributeData.size(), false));
-  data.append(attributeData.toByteVector(""));
-  return BaseObject::render(file);
+  return BaseObject::render(FilePrivate::renderAttributes(file->d->tag.get(), 1));
 }
 
 ByteVector ASF::File::FilePrivate::MetadataLibraryObject::guid() const
@@ -345,12 +356,9 @@ void ASF::File::FilePrivate::MetadataLibraryObject::parse(ASF::File *file, long
   }
 }
 
-ByteVector ASF::File::FilePrivate::MetadataLibraryObject::render(ASF::File *file)
+ByteVector ASF::File::FilePrivate::MetadataLibraryObject::render(const ASF::File *file) const
 {
-  data.clear();
-  data.append(ByteVector::fromShort(attributeData.size(), false));
-  data.append(attributeData.toByteVector(""));
-  return BaseObject::render(file);
+  return BaseObject::render(FilePrivate::renderAttributes(file->d->tag.get(), 2));
 }
 
 ASF::File::FilePrivate::HeaderExtensionObject::HeaderExtensionObject()
@@ -398,14 +406,22 @@ void ASF::File::FilePrivate::HeaderExtensionObject::parse(ASF::File *file, long
   }
 }
 
-ByteVector ASF::File::FilePrivate::HeaderExtensionObject::render(ASF::File *file)
+ByteVector ASF::File::FilePrivate::HeaderExtensionObject::render(const ASF::File *file) const
 {
-  data.clear();
+  // Padding objects are replaced by the padding at the end of the header,
+  // the objects for the tag are added if they do not exist yet.
+
+  ByteVector objectData;
   for(const auto &object : std::as_const(objects)) {
-    data.append(object->render(file));
+    if(object->guid() != paddingGuid)
+      objectData.append(object->render(file));
   }
-  data = ByteVector("\x11\xD2\xD3\xAB\xBA\xA9\xcf\x11\x8E\xE6\x00\xC0\x0C\x20\x53\x65\x06\x00", 18) + ByteVector::fromUInt(data.size(), false) + data;
-  return BaseObject::render(file);
+  if(!file->d->metadataObject)
+    objectData.append(MetadataObject().render(file));
+  if(!file->d->metadataLibraryObject)
+    objectData.append(MetadataLibraryObject().render(file));
+  objectData = ByteVector("\x11\xD2\xD3\xAB\xBA\xA9\xcf\x11\x8E\xE6\x00\xC0\x0C\x20\x53\x65\x06\x00", 18) + ByteVector::fromUInt(objectData.size(), false) + objectData;
+  return BaseObject::render(objectData);
 }
 
 ByteVector ASF::File::FilePrivate::CodecListObject::guid() const
@@ -421,6 +437,9 @@ void ASF::File::FilePrivate::CodecListObject::parse(ASF::File *file, long long s
     return;
   }
 
+  if(!file->d->properties)
+    return;
+
   unsigned int pos = 16;
 
   const int count = data.toUInt(pos, false);
@@ -463,6 +482,84 @@ void ASF::File::FilePrivate::CodecListObject::parse(ASF::File *file, long long s
   }
 }
 
+// Renders the attributes of tag which are stored in the object of the given
+// kind: 0 for the Extended Content Description Object, 1 for the Metadata
+// Object and 2 for the Metadata Library Object.
+ByteVector ASF::File::FilePrivate::renderAttributes(const ASF::Tag *tag, int kind)
+{
+  ByteVectorList attributeData;
+  for(const auto &[name, attributes] : tag->attributeListMap()) {
+    bool inExtendedContentDescriptionObject = false;
+    bool inMetadataObject = false;
+
+    for(const auto &attribute : attributes) {
+      const bool largeValue = attribute.dataSize() > 65535;
+      const bool guid       = attribute.type() == Attribute::GuidType;
+
+      int attributeKind = 2;
+      if(!inExtendedContentDescriptionObject && !guid && !largeValue && attribute.language() == 0 && attribute.stream() == 0) {
+        attributeKind = 0;
+        inExtendedContentDescriptionObject = true;
+      }
+      else if(!inMetadataObject && !guid && !largeValue && attribute.language() == 0 && attribute.stream() != 0) {
+        attributeKind = 1;
+        inMetadataObject = true;
+      }
+
+      if(attributeKind == kind)
+        attributeData.append(attribute.render(name, kind));
+    }
+  }
+  return ByteVector::fromShort(attributeData.size(), false) +
+         attributeData.toByteVector("");
+}
+
+void ASF::File::FilePrivate::updateObjects(offset_t paddingSize)
+{
+  // Make the objects match the header rendered by ASF::File::renderHeader().
+
+  if(!contentDescriptionObject) {
+    contentDescriptionObject = new ContentDescriptionObject();
+    objects.append(contentDescriptionObject);
+  }
+  if(!extendedContentDescriptionObject) {
+    extendedContentDescriptionObject = new ExtendedContentDescriptionObject();
+    objects.append(extendedContentDescriptionObject);
+  }
+  if(!headerExtensionObject) {
+    headerExtensionObject = new HeaderExtensionObject();
+    objects.append(headerExtensionObject);
+  }
+  if(!metadataObject) {
+    metadataObject = new MetadataObject();
+    headerExtensionObject->objects.append(metadataObject);
+  }
+  if(!metadataLibraryObject) {
+    metadataLibraryObject = new MetadataLibraryObject();
+    headerExtensionObject->objects.append(metadataLibraryObject);
+  }
+
+  const auto removePadding = [](List<BaseObject *> &objectList) {
+    for(auto it = objectList.begin(); it != objectList.end();) {
+      if((*it)->guid() == paddingGuid) {
+        delete *it;
+        it = objectList.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  };
+  removePadding(objects);
+  removePadding(headerExtensionObject->objects);
+
+  if(paddingSize >= 0) {
+    auto padding = new UnknownObject(paddingGuid);
+    padding->data = ByteVector(static_cast<unsigned int>(paddingSize), '\0');
+    objects.append(padding);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // static members
 ////////////////////////////////////////////////////////////////////////////////
@@ -479,20 +576,22 @@ bool ASF::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-ASF::File::File(FileName file, bool, Properties::ReadStyle) :
+ASF::File::File(FileName file, bool readProperties,
+                Properties::ReadStyle propertiesStyle) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read();
+    read(readProperties && propertiesStyle != Properties::TagsOnly);
 }
 
-ASF::File::File(IOStream *stream, bool, Properties::ReadStyle) :
+ASF::File::File(IOStream *stream, bool readProperties,
+                Properties::ReadStyle propertiesStyle) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read();
+    read(readProperties && propertiesStyle != Properties::TagsOnly);
 }
 
 ASF::File::~File() = default;
@@ -534,75 +633,36 @@ bool ASF::File::save()
     return false;
   }
 
-  if(!d->contentDescriptionObject) {
-    d->contentDescriptionObject = new FilePrivate::ContentDescriptionObject();
-    d->objects.append(d->contentDescriptionObject);
-  }
-  if(!d->extendedContentDescriptionObject) {
-    d->extendedContentDescriptionObject = new FilePrivate::ExtendedContentDescriptionObject();
-    d->objects.append(d->extendedContentDescriptionObject);
-  }
-  if(!d->headerExtensionObject) {
-    d->headerExtensionObject = new FilePrivate::HeaderExtensionObject();
-    d->objects.append(d->headerExtensionObject);
-  }
-  if(!d->metadataObject) {
-    d->metadataObject = new FilePrivate::MetadataObject();
-    d->headerExtensionObject->objects.append(d->metadataObject);
-  }
-  if(!d->metadataLibraryObject) {
-    d->metadataLibraryObject = new FilePrivate::MetadataLibraryObject();
-    d->headerExtensionObject->objects.append(d->metadataLibraryObject);
-  }
-
-  d->extendedContentDescriptionObject->attributeData.clear();
-  d->metadataObject->attributeData.clear();
-  d->metadataLibraryObject->attributeData.clear();
-
-  for(const auto &[name, attributes] : std::as_const(d->tag->attributeListMap())) {
-    bool inExtendedContentDescriptionObject = false;
-    bool inMetadataObject = false;
-
-    for(const auto &attribute : attributes) {
-      const bool largeValue = attribute.dataSize() > 65535;
-      const bool guid       = attribute.type() == Attribute::GuidType;
-
-      if(!inExtendedContentDescriptionObject && !guid && !largeValue && attribute.language() == 0 && attribute.stream() == 0) {
-        d->extendedContentDescriptionObject->attributeData.append(attribute.render(name));
-        inExtendedContentDescriptionObject = true;
-      }
-      else if(!inMetadataObject && !guid && !largeValue && attribute.language() == 0 && attribute.stream() != 0) {
-        d->metadataObject->attributeData.append(attribute.render(name, 1));
-        inMetadataObject = true;
-      }
-      else {
-        d->metadataLibraryObject->attributeData.append(attribute.render(name, 2));
-      }
-    }
-  }
+  offset_t paddingSize;
+  const ByteVector data = renderHeader(&paddingSize);
+  if(!containsBlock(data, 16, static_cast<size_t>(d->headerSize - 16)))
+    insert(data, 16, static_cast<size_t>(d->headerSize - 16));
 
-  ByteVector data;
-  for(const auto &object : std::as_const(d->objects)) {
-    data.append(object->render(this));
-  }
+  d->headerSize = data.size() + 16;
+  d->updateObjects(paddingSize);
 
-  seek(16);
-  writeBlock(ByteVector::fromLongLong(data.size() + 30, false));
-  writeBlock(ByteVector::fromUInt(d->objects.size(), false));
-  writeBlock(ByteVector("\x01\x02", 2));
+  return true;
+}
 
-  insert(data, 30, static_cast<unsigned long>(d->headerSize - 30));
+bool ASF::File::isModified() const
+{
+  if(!isValid())
+    return false;
 
-  d->headerSize = data.size() + 30;
+  // The stream is shared with the file, its position is restored.
 
-  return true;
+  const offset_t position = tell();
+  const ByteVector data = renderHeader();
+  const bool modified = !containsBlock(data, 16, static_cast<size_t>(d->headerSize - 16));
+  stream()->seek(position);
+  return modified;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-void ASF::File::read()
+void ASF::File::read(bool readProperties)
 {
   if(!isValid())
     return;
@@ -614,7 +674,8 @@ void ASF::File::read()
   }
 
   d->tag = std::make_unique<ASF::Tag>();
-  d->properties = std::make_unique<ASF::Properties>();
+  if(readProperties)
+    d->properties = std::make_unique<ASF::Properties>();
 
   bool ok;
   d->headerSize = readQWORD(this, &ok);
@@ -670,7 +731,8 @@ void ASF::File::read()
       if(guid == contentEncryptionGuid ||
          guid == extendedContentEncryptionGuid ||
          guid == advancedContentEncryptionGuid) {
-        d->properties->setEncrypted(true);
+        if(d->properties)
+          d->properties->setEncrypted(true);
       }
       obj = new FilePrivate::UnknownObject(guid);
     }
@@ -683,3 +745,64 @@ void ASF::File::read()
     setValid(false);
   }
 }
+
+ByteVector ASF::File::renderHeader(offset_t *paddingSize) const
+{
+  // The objects which do not exist yet are added after the existing ones.
+  // Existing padding objects are replaced by a single padding object at the
+  // end of the header as determined by the padding policy.  By default, it
+  // has the size of the existing padding.
+
+  ByteVector data;
+  unsigned int objectCount = 0;
+  offset_t existingPadding = -24;
+
+  for(const auto &object : std::as_const(d->objects)) {
+    if(object->guid() == paddingGuid) {
+      existingPadding += object->data.size() + 24;
+      continue;
+    }
+    data.append(object->render(this));
+    ++objectCount;
+  }
+  if(d->headerExtensionObject) {
+    for(const auto &object : std::as_const(d->headerExtensionObject->objects)) {
+      if(object->guid() == paddingGuid)
+        existingPadding += object->data.size() + 24;
+    }
+  }
+
+  if(!d->contentDescriptionObject) {
+    data.append(FilePrivate::ContentDescriptionObject().render(this));
+    ++objectCount;
+  }
+  if(!d->extendedContentDescriptionObject) {
+    data.append(FilePrivate::ExtendedContentDescriptionObject().render(this));
+    ++objectCount;
+  }
+  if(!d->headerExtensionObject) {
+    data.append(FilePrivate::HeaderExtensionObject().render(this));
+    ++objectCount;
+  }
+
+  const offset_t available = d->headerSize - 30 - data.size() - 24;
+  offset_t padding = paddingPolicy().padding(
+    available, stream()->length(), std::max<offset_t>(existingPadding, 0),
+    PaddingPolicy::AlwaysShrink);
+  if(padding > 0 || padding == available || existingPadding >= 0) {
+    FilePrivate::UnknownObject paddingObject(paddingGuid);
+    paddingObject.data = ByteVector(static_cast<unsigned int>(padding), '\0');
+    data.append(paddingObject.render(this));
+    ++objectCount;
+  }
+  else {
+    padding = -1;
+  }
+
+  if(paddingSize)
+    *paddingSize = padding;
+
+  return ByteVector::fromLongLong(data.size() + 30, false) +
+         ByteVector::fromUInt(objectCount, false) +
+         ByteVector("\x01\x02", 2) + data;
+}
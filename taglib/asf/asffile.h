@@ -50,9 +50,10 @@ namespace TagLib {
       /*!
        * Constructs an ASF file from \a file.
        *
-       * \note In the current implementation, both \a readProperties and
-       * \a propertiesStyle are ignored.  The audio properties are always
-       * read.
+       * If \a readProperties is \c true and \a propertiesStyle is not
+       * Properties::TagsOnly the file's audio properties will also be read.
+       * The header objects holding them are still read, as they are written
+       * back when the file is saved.
        */
       File(FileName file, bool readProperties = true,
            Properties::ReadStyle propertiesStyle = Properties::Average);
@@ -60,9 +61,10 @@ namespace TagLib {
       /*!
        * Constructs an ASF file from \a stream.
        *
-       * \note In the current implementation, both \a readProperties and
-       * \a propertiesStyle are ignored.  The audio properties are always
-       * read.
+       * If \a readProperties is \c true and \a propertiesStyle is not
+       * Properties::TagsOnly the file's audio properties will also be read.
+       * The header objects holding them are still read, as they are written
+       * back when the file is saved.
        *
        * \note TagLib will *not* take ownership of the stream, the caller is
        * responsible for deleting it after the File object.
@@ -118,6 +120,14 @@ namespace TagLib {
        */
       bool save() override;
 
+      /*!
+       * Returns \c true if the header objects differ from the ones stored in
+       * the file.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * Returns whether or not the given \a stream can be opened as an ASF
        * file.
@@ -128,7 +138,8 @@ namespace TagLib {
       static bool isSupported(IOStream *stream);
 
     private:
-      void read();
+      void read(bool readProperties);
+      ByteVector renderHeader(offset_t *paddingSize = nullptr) const;
 
       class FilePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -38,6 +38,7 @@ public:
   String mimeType;
   String description;
   ByteVector picture;
+  PictureReference pictureReference;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +97,17 @@ ByteVector ASF::Picture::picture() const
 void ASF::Picture::setPicture(const ByteVector &p)
 {
   d->picture = p;
+  d->pictureReference = PictureReference();
+}
+
+PictureReference ASF::Picture::pictureReference() const
+{
+  return d->pictureReference;
+}
+
+void ASF::Picture::setPictureReference(const PictureReference &reference)
+{
+  d->pictureReference = reference;
 }
 
 int ASF::Picture::dataSize() const
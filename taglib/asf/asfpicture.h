@@ -29,6 +29,7 @@
 #include "tstring.h"
 #include "tbytevector.h"
 #include "tpicturetype.h"
+#include "tpicturereference.h"
 #include "taglib_export.h"
 
 namespace TagLib
@@ -153,6 +154,14 @@ namespace TagLib
        */
       void setPicture(const ByteVector &p);
 
+      /*!
+       * Returns the location of the image data in the file it was read from,
+       * which can be used to copy it in chunks.  A null reference is returned
+       * if the picture was not read from a file or setPicture() has been
+       * called.
+       */
+      PictureReference pictureReference() const;
+
       /*!
        * Returns picture as binary raw data \a value
        */
@@ -170,6 +179,10 @@ namespace TagLib
 #endif
 
       private:
+        friend class Attribute;
+
+        void setPictureReference(const PictureReference &reference);
+
         class PicturePrivate;
         TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
         std::shared_ptr<PicturePrivate> d;
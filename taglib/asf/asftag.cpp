@@ -117,6 +117,37 @@ unsigned int ASF::Tag::track() const
   return 0;
 }
 
+void ASF::Tag::basicFields(BasicFields &fields) const
+{
+  const auto attributes = [this](const char *name) -> const AttributeList * {
+    const auto it = d->attributeListMap.find(name);
+    return it != d->attributeListMap.end() && !it->second.isEmpty() ? &it->second : nullptr;
+  };
+
+  fields.title = d->title;
+  fields.artist = d->artist;
+  fields.comment = d->comment;
+
+  const AttributeList *album = attributes("WM/AlbumTitle");
+  fields.album = album ? joinTagValues(attributeListToStringList(*album)) : String();
+  const AttributeList *genre = attributes("WM/Genre");
+  fields.genre = genre ? joinTagValues(attributeListToStringList(*genre)) : String();
+  const AttributeList *year = attributes("WM/Year");
+  fields.year = year ? year->front().toString().toInt() : 0;
+
+  if(const AttributeList *trackNumber = attributes("WM/TrackNumber")) {
+    const Attribute &attr = trackNumber->front();
+    fields.track = attr.type() == Attribute::DWordType
+      ? attr.toUInt() : attr.toString().toInt();
+  }
+  else if(const AttributeList *track = attributes("WM/Track")) {
+    fields.track = track->front().toUInt();
+  }
+  else {
+    fields.track = 0;
+  }
+}
+
 String ASF::Tag::genre() const
 {
   if(d->attributeListMap.contains("WM/Genre"))
@@ -103,6 +103,12 @@ namespace TagLib {
        */
       unsigned int track() const override;
 
+      /*!
+       * Sets \a fields to the values of the basic fields, looking up each
+       * attribute only once.
+       */
+      void basicFields(BasicFields &fields) const override;
+
       /*!
        * Sets the title to \a value.
        */
@@ -58,8 +58,16 @@ namespace TagLib {
       Fast,
       //! Read more of the file and make better values guesses
       Average,
-      //! Read as much of the file as needed to report accurate values
-      Accurate
+      //! Read as much of the file as needed to report accurate values, this
+      //! can mean reading all frames of the audio data, e.g. for VBR MPEG
+      //! streams without a VBR header
+      Accurate,
+      //! Do not read audio properties at all and only read the tags and the
+      //! headers needed to locate them, regardless of the \a readProperties
+      //! argument of the file constructors.  No scans depending on the size
+      //! of the audio data are performed, parts of the file which are needed
+      //! to save it are read when the file is saved.
+      TagsOnly
     };
 
     /*!
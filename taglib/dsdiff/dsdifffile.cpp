@@ -609,6 +609,9 @@ void DSDIFF::File::read(bool readProperties, Properties::ReadStyle propertiesSty
 {
   bool bigEndian = d->endianness == BigEndian;
 
+  if(propertiesStyle == Properties::TagsOnly)
+    readProperties = false;
+
   d->type = readBlock(4);
   d->size = readBlock(8).toLongLong(bigEndian);
   d->format = readBlock(4);
@@ -668,7 +671,7 @@ void DSDIFF::File::read(bool readProperties, Properties::ReadStyle propertiesSty
       lengthDSDSamplesTimeChannels = d->chunks[i].size * 8;
       audioDataSizeinBytes = d->chunks[i].size;
     }
-    else if(d->chunks[i].name == "DST ") {
+    else if(d->chunks[i].name == "DST " && readProperties) {
       // Now decode the chunks inside the DST chunk to read the DST Frame Information one
       long long dstChunkEnd = d->chunks[i].offset + d->chunks[i].size;
       seek(d->chunks[i].offset);
@@ -839,12 +842,12 @@ void DSDIFF::File::read(bool readProperties, Properties::ReadStyle propertiesSty
       d->isID3InPropChunk = true;
       d->hasID3v2 = true;
     }
-    else if(d->childChunks[PROPChunk][i].name == "FS  ") {
+    else if(d->childChunks[PROPChunk][i].name == "FS  " && readProperties) {
       // Sample rate
       seek(d->childChunks[PROPChunk][i].offset);
       sampleRate = readBlock(4).toUInt(0, 4, bigEndian);
     }
-    else if(d->childChunks[PROPChunk][i].name == "CHNL") {
+    else if(d->childChunks[PROPChunk][i].name == "CHNL" && readProperties) {
       // Channels
       seek(d->childChunks[PROPChunk][i].offset);
       channels = readBlock(2).toShort(0, bigEndian);
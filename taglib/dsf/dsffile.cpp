@@ -217,7 +217,8 @@ void DSF::File::read(AudioProperties::ReadStyle propertiesStyle)
     return;
   }
 
-  d->properties = std::make_unique<Properties>(readBlock(fmtHeaderSize), propertiesStyle);
+  if(propertiesStyle != AudioProperties::TagsOnly)
+    d->properties = std::make_unique<Properties>(readBlock(fmtHeaderSize), propertiesStyle);
 
   // Skip the data chunk
 
@@ -30,6 +30,8 @@
 #include "fileref.h"
 
 #include <cstring>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "tfilestream.h"
@@ -37,6 +39,7 @@
 #include "tstringlist.h"
 #include "tvariant.h"
 #include "tdebug.h"
+#include "id3v2framefactory.h"
 #include "aifffile.h"
 #include "apefile.h"
 #include "asffile.h"
@@ -107,10 +110,178 @@ namespace
     return nullptr;
   }
 
+  // Registry of the built-in file formats.
+
+  template <class T>
+  File *createFromStream(IOStream *stream, bool readAudioProperties,
+                         AudioProperties::ReadStyle audioPropertiesStyle,
+                         ID3v2::FrameFactory *)
+  {
+    return new T(stream, readAudioProperties, audioPropertiesStyle);
+  }
+
+  template <class T>
+  File *createFromStreamWithFrameFactory(IOStream *stream, bool readAudioProperties,
+                                         AudioProperties::ReadStyle audioPropertiesStyle,
+                                         ID3v2::FrameFactory *frameFactory)
+  {
+    return new T(stream, readAudioProperties, audioPropertiesStyle, frameFactory);
+  }
+
+  template <class T>
+  File *createFromFileName(FileName fileName, bool readAudioProperties,
+                           AudioProperties::ReadStyle audioPropertiesStyle)
+  {
+    return new T(fileName, readAudioProperties, audioPropertiesStyle);
+  }
+
+  struct FileFormat
+  {
+    const char *name;
+    bool (*isSupported)(IOStream *stream);
+    File *(*createFromStream)(IOStream *stream, bool readAudioProperties,
+                              AudioProperties::ReadStyle audioPropertiesStyle,
+                              ID3v2::FrameFactory *frameFactory);
+    File *(*createFromFileName)(FileName fileName, bool readAudioProperties,
+                                AudioProperties::ReadStyle audioPropertiesStyle);
+  };
+
+  // The formats are listed in the order in which they are tried by the
+  // content-based detection.  Formats without isSupported() are only detected
+  // by their extension.
+
+  enum {
+    MPEGFormat, OggVorbisFormat, OggFLACFormat, FLACFormat, MPCFormat,
+    WavPackFormat, SpeexFormat, OpusFormat, TrueAudioFormat, MP4Format,
+    ASFFormat, AIFFFormat, WAVFormat, APEFormat, DSFFormat, DSDIFFFormat,
+    ModFormat, S3MFormat, ITFormat, XMFormat, NoFormat
+  };
+
+  constexpr FileFormat fileFormats[] = {
+    { "MPEG", &MPEG::File::isSupported,
+      &createFromStreamWithFrameFactory<MPEG::File>, &createFromFileName<MPEG::File> },
+    { "OggVorbis", &Ogg::Vorbis::File::isSupported,
+      &createFromStream<Ogg::Vorbis::File>, &createFromFileName<Ogg::Vorbis::File> },
+    { "OggFLAC", &Ogg::FLAC::File::isSupported,
+      &createFromStream<Ogg::FLAC::File>, &createFromFileName<Ogg::FLAC::File> },
+    { "FLAC", &FLAC::File::isSupported,
+      &createFromStreamWithFrameFactory<FLAC::File>, &createFromFileName<FLAC::File> },
+    { "MPC", &MPC::File::isSupported,
+      &createFromStream<MPC::File>, &createFromFileName<MPC::File> },
+    { "WavPack", &WavPack::File::isSupported,
+      &createFromStream<WavPack::File>, &createFromFileName<WavPack::File> },
+    { "Speex", &Ogg::Speex::File::isSupported,
+      &createFromStream<Ogg::Speex::File>, &createFromFileName<Ogg::Speex::File> },
+    { "Opus", &Ogg::Opus::File::isSupported,
+      &createFromStream<Ogg::Opus::File>, &createFromFileName<Ogg::Opus::File> },
+    { "TrueAudio", &TrueAudio::File::isSupported,
+      &createFromStreamWithFrameFactory<TrueAudio::File>, &createFromFileName<TrueAudio::File> },
+    { "MP4", &MP4::File::isSupported,
+      &createFromStream<MP4::File>, &createFromFileName<MP4::File> },
+    { "ASF", &ASF::File::isSupported,
+      &createFromStream<ASF::File>, &createFromFileName<ASF::File> },
+    { "AIFF", &RIFF::AIFF::File::isSupported,
+      &createFromStreamWithFrameFactory<RIFF::AIFF::File>, &createFromFileName<RIFF::AIFF::File> },
+    { "WAV", &RIFF::WAV::File::isSupported,
+      &createFromStreamWithFrameFactory<RIFF::WAV::File>, &createFromFileName<RIFF::WAV::File> },
+    { "APE", &APE::File::isSupported,
+      &createFromStream<APE::File>, &createFromFileName<APE::File> },
+    { "DSF", &DSF::File::isSupported,
+      &createFromStreamWithFrameFactory<DSF::File>, &createFromFileName<DSF::File> },
+    { "DSDIFF", &DSDIFF::File::isSupported,
+      &createFromStreamWithFrameFactory<DSDIFF::File>, &createFromFileName<DSDIFF::File> },
+    { "Mod", nullptr,
+      &createFromStream<Mod::File>, &createFromFileName<Mod::File> },
+    { "S3M", nullptr,
+      &createFromStream<S3M::File>, &createFromFileName<S3M::File> },
+    { "IT", nullptr,
+      &createFromStream<IT::File>, &createFromFileName<IT::File> },
+    { "XM", nullptr,
+      &createFromStream<XM::File>, &createFromFileName<XM::File> },
+  };
+
+  struct FileExtension
+  {
+    const char *extension;
+    int formats[2];
+  };
+
+  // The extensions in the order returned by FileRef::defaultFileExtensions().
+  // The formats are tried in the given order, if no valid file can be
+  // created, content-based detection is used.
+
+  constexpr FileExtension fileExtensions[] = {
+    { "ogg", { OggVorbisFormat, NoFormat } },
+    { "flac", { FLACFormat, NoFormat } },
+    // .oga can be any audio in the Ogg container. First try FLAC, then Vorbis.
+    { "oga", { OggFLACFormat, OggVorbisFormat } },
+    { "opus", { OpusFormat, NoFormat } },
+    { "mp3", { MPEGFormat, NoFormat } },
+    { "mp2", { MPEGFormat, NoFormat } },
+    { "mpc", { MPCFormat, NoFormat } },
+    { "wv", { WavPackFormat, NoFormat } },
+    { "spx", { SpeexFormat, NoFormat } },
+    { "tta", { TrueAudioFormat, NoFormat } },
+    { "aac", { MPEGFormat, NoFormat } },
+    { "m4a", { MP4Format, NoFormat } },
+    { "m4r", { MP4Format, NoFormat } },
+    { "m4b", { MP4Format, NoFormat } },
+    { "m4p", { MP4Format, NoFormat } },
+    { "3g2", { MP4Format, NoFormat } },
+    { "mp4", { MP4Format, NoFormat } },
+    { "m4v", { MP4Format, NoFormat } },
+    { "wma", { ASFFormat, NoFormat } },
+    { "asf", { ASFFormat, NoFormat } },
+    { "aif", { AIFFFormat, NoFormat } },
+    { "aiff", { AIFFFormat, NoFormat } },
+    { "afc", { AIFFFormat, NoFormat } },
+    { "aifc", { AIFFFormat, NoFormat } },
+    { "wav", { WAVFormat, NoFormat } },
+    { "ape", { APEFormat, NoFormat } },
+    { "mod", { ModFormat, NoFormat } },
+    // module, nst and wow are possible but uncommon extensions
+    { "module", { ModFormat, NoFormat } },
+    { "nst", { ModFormat, NoFormat } },
+    { "wow", { ModFormat, NoFormat } },
+    { "s3m", { S3MFormat, NoFormat } },
+    { "it", { ITFormat, NoFormat } },
+    { "xm", { XMFormat, NoFormat } },
+    { "dsf", { DSFFormat, NoFormat } },
+    { "dff", { DSDIFFFormat, NoFormat } },
+    { "dsdiff", { DSDIFFFormat, NoFormat } },
+  };
+
+  const FileExtension *findExtension(const std::string &extension)
+  {
+    static const auto extensionMap = [] {
+      std::unordered_map<std::string, const FileExtension *> map;
+      for(const auto &ext : fileExtensions)
+        map.emplace(ext.extension, &ext);
+      return map;
+    }();
+
+    const auto it = extensionMap.find(extension);
+    return it != extensionMap.end() ? it->second : nullptr;
+  }
+
+  const FileFormat *findFormat(const String &name)
+  {
+    static const auto formatMap = [] {
+      std::unordered_map<std::string, const FileFormat *> map;
+      for(const auto &format : fileFormats)
+        map.emplace(format.name, &format);
+      return map;
+    }();
+
+    const auto it = formatMap.find(name.to8Bit());
+    return it != formatMap.end() ? it->second : nullptr;
+  }
+
   // Detect the file type based on the file extension.
 
   File* detectByExtension(IOStream *stream, bool readAudioProperties,
-                          AudioProperties::ReadStyle audioPropertiesStyle)
+                          AudioProperties::ReadStyle audioPropertiesStyle,
+                          ID3v2::FrameFactory *frameFactory)
   {
 #ifdef _WIN32
     const String s = stream->name().toString();
@@ -118,72 +289,30 @@ namespace
     const String s(stream->name());
 #endif
 
-    String ext;
-    if(const int pos = s.rfind("."); pos != -1)
-      ext = s.substr(pos + 1).upper();
-
-    // If this list is updated, the method defaultFileExtensions() should also be
-    // updated.  However at some point that list should be created at the same time
-    // that a default file type resolver is created.
-
-    if(ext.isEmpty())
+    const int pos = s.rfind(".");
+    if(pos == -1)
       return nullptr;
 
-    // .oga can be any audio in the Ogg container. So leave it to content-based detection.
+    // The comparison of the extensions is case-insensitive.
 
-    File *file = nullptr;
-
-    if(ext == "MP3" || ext == "MP2" || ext == "AAC")
-      file = new MPEG::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "OGG")
-      file = new Ogg::Vorbis::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "OGA") {
-      /* .oga can be any audio in the Ogg container. First try FLAC, then Vorbis. */
-      file = new Ogg::FLAC::File(stream, readAudioProperties, audioPropertiesStyle);
-      if(!file->isValid()) {
-        delete file;
-        file = new Ogg::Vorbis::File(stream, readAudioProperties, audioPropertiesStyle);
-      }
+    std::string ext = s.substr(pos + 1).to8Bit();
+    for(auto &c : ext) {
+      if(c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
     }
-    else if(ext == "FLAC")
-      file = new FLAC::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "MPC")
-      file = new MPC::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "WV")
-      file = new WavPack::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "SPX")
-      file = new Ogg::Speex::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "OPUS")
-      file = new Ogg::Opus::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "TTA")
-      file = new TrueAudio::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "M4A" || ext == "M4R" || ext == "M4B" || ext == "M4P" || ext == "MP4" || ext == "3G2" || ext == "M4V")
-      file = new MP4::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "WMA" || ext == "ASF")
-      file = new ASF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "AIF" || ext == "AIFF" || ext == "AFC" || ext == "AIFC")
-      file = new RIFF::AIFF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "WAV")
-      file = new RIFF::WAV::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "APE")
-      file = new APE::File(stream, readAudioProperties, audioPropertiesStyle);
-    // module, nst and wow are possible but uncommon extensions
-    else if(ext == "MOD" || ext == "MODULE" || ext == "NST" || ext == "WOW")
-      file = new Mod::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "S3M")
-      file = new S3M::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "IT")
-      file = new IT::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "XM")
-      file = new XM::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "DSF")
-      file = new DSF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ext == "DFF" || ext == "DSDIFF")
-      file = new DSDIFF::File(stream, readAudioProperties, audioPropertiesStyle);
+
+    const FileExtension *extension = findExtension(ext);
+    if(!extension)
+      return nullptr;
 
     // if file is not valid, leave it to content-based detection.
 
-    if(file) {
+    for(int index : extension->formats) {
+      if(index == NoFormat)
+        break;
+
+      File *file = fileFormats[index].createFromStream(
+        stream, readAudioProperties, audioPropertiesStyle, frameFactory);
       if(file->isValid())
         return file;
       delete file;
@@ -195,42 +324,18 @@ namespace
   // Detect the file type based on the actual content of the stream.
 
   File *detectByContent(IOStream *stream, bool readAudioProperties,
-                        AudioProperties::ReadStyle audioPropertiesStyle)
+                        AudioProperties::ReadStyle audioPropertiesStyle,
+                        ID3v2::FrameFactory *frameFactory)
   {
     File *file = nullptr;
 
-    if(MPEG::File::isSupported(stream))
-      file = new MPEG::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(Ogg::Vorbis::File::isSupported(stream))
-      file = new Ogg::Vorbis::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(Ogg::FLAC::File::isSupported(stream))
-      file = new Ogg::FLAC::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(FLAC::File::isSupported(stream))
-      file = new FLAC::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(MPC::File::isSupported(stream))
-      file = new MPC::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(WavPack::File::isSupported(stream))
-      file = new WavPack::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(Ogg::Speex::File::isSupported(stream))
-      file = new Ogg::Speex::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(Ogg::Opus::File::isSupported(stream))
-      file = new Ogg::Opus::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(TrueAudio::File::isSupported(stream))
-      file = new TrueAudio::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(MP4::File::isSupported(stream))
-      file = new MP4::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(ASF::File::isSupported(stream))
-      file = new ASF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(RIFF::AIFF::File::isSupported(stream))
-      file = new RIFF::AIFF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(RIFF::WAV::File::isSupported(stream))
-      file = new RIFF::WAV::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(APE::File::isSupported(stream))
-      file = new APE::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(DSF::File::isSupported(stream))
-      file = new DSF::File(stream, readAudioProperties, audioPropertiesStyle);
-    else if(DSDIFF::File::isSupported(stream))
-      file = new DSDIFF::File(stream, readAudioProperties, audioPropertiesStyle);
+    for(const auto &format : fileFormats) {
+      if(format.isSupported && format.isSupported(stream)) {
+        file = format.createFromStream(
+          stream, readAudioProperties, audioPropertiesStyle, frameFactory);
+        break;
+      }
+    }
 
     // isSupported() only does a quick check, so double check the file here.
 
@@ -274,6 +379,7 @@ public:
 
   File *file { nullptr };
   IOStream *stream { nullptr };
+  std::unique_ptr<ID3v2::SelectiveFrameFactory> frameFactory;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -298,6 +404,24 @@ FileRef::FileRef(IOStream *stream, bool readAudioProperties, AudioProperties::Re
   parse(stream, readAudioProperties, audioPropertiesStyle);
 }
 
+FileRef::FileRef(FileName fileName, bool readAudioProperties,
+                 AudioProperties::ReadStyle audioPropertiesStyle,
+                 const StringList &propertyKeys) :
+  d(std::make_shared<FileRefPrivate>())
+{
+  d->frameFactory = std::make_unique<ID3v2::SelectiveFrameFactory>(propertyKeys);
+  parse(fileName, readAudioProperties, audioPropertiesStyle);
+}
+
+FileRef::FileRef(IOStream *stream, bool readAudioProperties,
+                 AudioProperties::ReadStyle audioPropertiesStyle,
+                 const StringList &propertyKeys) :
+  d(std::make_shared<FileRefPrivate>())
+{
+  d->frameFactory = std::make_unique<ID3v2::SelectiveFrameFactory>(propertyKeys);
+  parse(stream, readAudioProperties, audioPropertiesStyle);
+}
+
 FileRef::FileRef(File *file) :
   d(std::make_shared<FileRefPrivate>())
 {
@@ -324,6 +448,14 @@ PropertyMap FileRef::properties() const
   return d->file->properties();
 }
 
+PropertyMap FileRef::properties(const StringList &keys) const
+{
+  if(d->isNullWithDebugMessage(__func__)) {
+    return PropertyMap();
+  }
+  return d->file->selectedProperties(keys);
+}
+
 void FileRef::removeUnsupportedProperties(const StringList& properties)
 {
   if(d->isNullWithDebugMessage(__func__)) {
@@ -398,46 +530,39 @@ void FileRef::clearFileTypeResolvers() // static
 
 StringList FileRef::defaultFileExtensions()
 {
-  StringList l;
-
-  l.append("ogg");
-  l.append("flac");
-  l.append("oga");
-  l.append("opus");
-  l.append("mp3");
-  l.append("mp2");
-  l.append("mpc");
-  l.append("wv");
-  l.append("spx");
-  l.append("tta");
-  l.append("aac");
-  l.append("m4a");
-  l.append("m4r");
-  l.append("m4b");
-  l.append("m4p");
-  l.append("3g2");
-  l.append("mp4");
-  l.append("m4v");
-  l.append("wma");
-  l.append("asf");
-  l.append("aif");
-  l.append("aiff");
-  l.append("afc");
-  l.append("aifc");
-  l.append("wav");
-  l.append("ape");
-  l.append("mod");
-  l.append("module"); // alias for "mod"
-  l.append("nst"); // alias for "mod"
-  l.append("wow"); // alias for "mod"
-  l.append("s3m");
-  l.append("it");
-  l.append("xm");
-  l.append("dsf");
-  l.append("dff");
-  l.append("dsdiff"); // alias for "dff"
-
-  return l;
+  static const StringList extensions = [] {
+    StringList l;
+    for(const auto &ext : fileExtensions)
+      l.append(ext.extension);
+    return l;
+  }();
+
+  return extensions;
+}
+
+StringList FileRef::supportedFormats()
+{
+  static const StringList formats = [] {
+    StringList l;
+    for(const auto &format : fileFormats)
+      l.append(format.name);
+    return l;
+  }();
+
+  return formats;
+}
+
+File *FileRef::createFile(const String &format, FileName fileName,
+                          bool readAudioProperties,
+                          AudioProperties::ReadStyle audioPropertiesStyle)
+{
+  const FileFormat *fileFormat = findFormat(format);
+  if(!fileFormat) {
+    debug("FileRef::createFile() - Unknown file format " + format);
+    return nullptr;
+  }
+
+  return fileFormat->createFromFileName(fileName, readAudioProperties, audioPropertiesStyle);
 }
 
 bool FileRef::isNull() const
@@ -480,13 +605,15 @@ void FileRef::parse(FileName fileName, bool readAudioProperties,
   // Try to resolve file types based on the file extension.
 
   d->stream = new FileStream(fileName);
-  d->file = detectByExtension(d->stream, readAudioProperties, audioPropertiesStyle);
+  d->file = detectByExtension(d->stream, readAudioProperties, audioPropertiesStyle,
+                              d->frameFactory.get());
   if(d->file)
     return;
 
   // At last, try to resolve file types based on the actual content.
 
-  d->file = detectByContent(d->stream, readAudioProperties, audioPropertiesStyle);
+  d->file = detectByContent(d->stream, readAudioProperties, audioPropertiesStyle,
+                            d->frameFactory.get());
   if(d->file)
     return;
 
@@ -513,13 +640,15 @@ void FileRef::parse(IOStream *stream, bool readAudioProperties,
 
   // Try to resolve file types based on the file extension.
 
-  d->file = detectByExtension(stream, readAudioProperties, audioPropertiesStyle);
+  d->file = detectByExtension(stream, readAudioProperties, audioPropertiesStyle,
+                              d->frameFactory.get());
   if(d->file)
     return;
 
   // At last, try to resolve file types based on the actual content of the file.
 
-  d->file = detectByContent(stream, readAudioProperties, audioPropertiesStyle);
+  d->file = detectByContent(stream, readAudioProperties, audioPropertiesStyle,
+                            d->frameFactory.get());
 }
 
 FileRef::FileTypeResolver::FileTypeResolver() = default;
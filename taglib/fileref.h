@@ -199,12 +199,41 @@ namespace TagLib {
      *
      * \note TagLib will *not* take ownership of the stream, the caller is
      * responsible for deleting it after the File object.
+     *
+     * \see BudgetStream to limit the I/O done to detect and read the file.
      */
     explicit FileRef(IOStream* stream,
                      bool readAudioProperties = true,
                      AudioProperties::ReadStyle
                      audioPropertiesStyle = AudioProperties::Average);
 
+    /*!
+     * Create a FileRef from \a fileName which is only used to read the
+     * properties \a propertyKeys, e.g. for a listing view.  Metadata which
+     * does not contribute to these properties is not decoded if the format
+     * supports this, currently this is done for ID3v2 tags.  The values can
+     * be fetched using properties(const StringList &) const.
+     *
+     * The other arguments have the same meaning as in the constructor above.
+     *
+     * \see ID3v2::SelectiveFrameFactory
+     */
+    FileRef(FileName fileName,
+            bool readAudioProperties,
+            AudioProperties::ReadStyle audioPropertiesStyle,
+            const StringList &propertyKeys);
+
+    /*!
+     * Construct a FileRef from an opened \a IOStream which is only used to
+     * read the properties \a propertyKeys.
+     *
+     * \see FileRef(FileName, bool, AudioProperties::ReadStyle, const StringList &)
+     */
+    FileRef(IOStream* stream,
+            bool readAudioProperties,
+            AudioProperties::ReadStyle audioPropertiesStyle,
+            const StringList &propertyKeys);
+
     /*!
      * Construct a FileRef using \a file.  The FileRef now takes ownership of the
      * pointer and will delete the File when it passes out of scope.
@@ -247,6 +276,14 @@ namespace TagLib {
      */
     PropertyMap properties() const;
 
+    /*!
+     * Returns the properties for the given \a keys only.  Calls this method
+     * on the wrapped File instance.
+     *
+     * \see File::selectedProperties()
+     */
+    PropertyMap properties(const StringList &keys) const;
+
     /*!
      * Removes unsupported properties, or a subset of them, from the file's metadata.
      * The parameter \a properties must contain only entries from
@@ -377,6 +414,28 @@ namespace TagLib {
      */
     static StringList defaultFileExtensions();
 
+    /*!
+     * Returns the names of the built-in file formats, e.g. "MPEG", "FLAC" or
+     * "MP4".  The names can be used with createFile().
+     */
+    static StringList supportedFormats();
+
+    /*!
+     * Creates a file of the built-in \a format for \a fileName without
+     * detecting the file type.  If \a readAudioProperties is \c true then the
+     * audio properties will be read using \a audioPropertiesStyle.  Returns
+     * null if \a format is not one of supportedFormats().
+     *
+     * \note The caller takes ownership of the returned file, which can be
+     * passed to FileRef(File *).
+     *
+     * \see supportedFormats()
+     */
+    static File *createFile(const String &format, FileName fileName,
+                            bool readAudioProperties = true,
+                            AudioProperties::ReadStyle
+                            audioPropertiesStyle = AudioProperties::Average);
+
     /*!
      * Returns \c true if the file (and as such other pointers) are null.
      */
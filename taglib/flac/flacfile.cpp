@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "tdebug.h"
 #include "tpropertymap.h"
@@ -46,7 +47,8 @@ namespace
   enum { FlacXiphIndex = 0, FlacID3v2Index = 1, FlacID3v1Index = 2 };
 
   constexpr long MinPaddingLength = 4096;
-  constexpr long MaxPaddingLegnth = 1024 * 1024;
+
+  constexpr unsigned int MaxPictureHeaderLength = 1024;
 
   constexpr char LastBlockFlag = '\x80';
 }  // namespace
@@ -75,6 +77,16 @@ public:
   offset_t flacStart { 0 };
   offset_t streamStart { 0 };
   bool scanned { false };
+
+  // Metadata blocks without tag data are not read in TagsOnly mode, only
+  // their location is kept to read them when the file is saved.
+  struct DeferredBlock {
+    UnknownMetadataBlock *block;
+    offset_t offset;
+    unsigned int length;
+  };
+  bool tagsOnly { false };
+  std::vector<DeferredBlock> deferredBlocks;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,43 +106,43 @@ bool FLAC::File::isSupported(IOStream *stream)
 ////////////////////////////////////////////////////////////////////////////////
 
 FLAC::File::File(FileName file, bool readProperties,
-                 Properties::ReadStyle,
+                 Properties::ReadStyle readStyle,
                  ID3v2::FrameFactory *frameFactory) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>(
     frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 FLAC::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle) :
+                 bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 FLAC::File::File(IOStream *stream, bool readProperties,
-                 Properties::ReadStyle,
+                 Properties::ReadStyle readStyle,
                  ID3v2::FrameFactory *frameFactory) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>(
     frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 FLAC::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                 bool readProperties, Properties::ReadStyle) :
+                 bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 FLAC::File::~File() = default;
@@ -235,12 +247,30 @@ bool FLAC::File::save()
     return false;
   }
 
+  // An unmodified ID3v2.3 tag is not rewritten as ID3v2.4.
+
+  if(!isModified())
+    return true;
+
   // Create new vorbis comments
   if(!hasXiphComment())
     Tag::duplicate(&d->tag, xiphComment(true), false);
 
   d->xiphCommentData = xiphComment()->render(false);
 
+  // Read the metadata blocks which have been skipped in TagsOnly mode
+
+  for(const auto &deferred : d->deferredBlocks) {
+    seek(deferred.offset);
+    const ByteVector blockData = readBlock(deferred.length);
+    if(blockData.size() != deferred.length) {
+      debug("FLAC::File::save() -- Failed to read a metadata block");
+      return false;
+    }
+    deferred.block->setData(blockData);
+  }
+  d->deferredBlocks.clear();
+
   // Replace metadata blocks
 
   MetadataBlock *commentBlock =
@@ -262,44 +292,23 @@ bool FLAC::File::save()
   if(commentBlock)
     d->blocks.append(commentBlock);
 
-  // Render data for the metadata blocks
-
-  ByteVector data;
-  for(const auto &block : std::as_const(d->blocks)) {
-    ByteVector blockData = block->render();
-    ByteVector blockHeader = ByteVector::fromUInt(blockData.size());
-    blockHeader[0] = block->code();
-    data.append(blockHeader);
-    data.append(blockData);
-  }
-
-  // Compute the amount of padding, and append that to data.
-
-  offset_t originalLength = d->streamStart - d->flacStart;
-  offset_t paddingLength = originalLength - data.size() - 4;
-
-  if(paddingLength <= 0) {
-    paddingLength = MinPaddingLength;
-  }
-  else {
-    // Padding won't increase beyond 1% of the file size or 1MB.
+  ByteVector data = renderMetadata();
+  if(data.isEmpty())
+    return false;
 
-    offset_t threshold = length() / 100;
-    threshold = std::max<offset_t>(threshold, MinPaddingLength);
-    threshold = std::min<offset_t>(threshold, MaxPaddingLegnth);
+  // Read the picture data before the file is modified
 
-    if(paddingLength > threshold)
-      paddingLength = MinPaddingLength;
+  for(const auto &block : std::as_const(d->blocks)) {
+    if(auto picture = dynamic_cast<Picture *>(block);
+       picture && !picture->dataReference().isNull())
+      picture->setData(picture->data());
   }
 
-  ByteVector paddingHeader = ByteVector::fromUInt(static_cast<unsigned int>(paddingLength));
-  paddingHeader[0] = static_cast<char>(MetadataBlock::Padding | LastBlockFlag);
-  data.append(paddingHeader);
-  data.resize(static_cast<unsigned int>(data.size() + paddingLength));
-
   // Write the data to the file
 
-  insert(data, d->flacStart, originalLength);
+  const offset_t originalLength = d->streamStart - d->flacStart;
+  if(!containsBlock(data, d->flacStart, originalLength))
+    insert(data, d->flacStart, originalLength);
 
   d->streamStart += static_cast<long>(data.size()) - originalLength;
 
@@ -316,7 +325,7 @@ bool FLAC::File::save()
       d->ID3v2Location = 0;
 
     data = ID3v2Tag()->render();
-    insert(data, d->ID3v2Location, d->ID3v2OriginalSize);
+    ID3v2Tag()->write(this, data, d->ID3v2Location, d->ID3v2OriginalSize);
 
     d->flacStart   += static_cast<long>(data.size()) - d->ID3v2OriginalSize;
     d->streamStart += static_cast<long>(data.size()) - d->ID3v2OriginalSize;
@@ -348,15 +357,14 @@ bool FLAC::File::save()
 
     // ID3v1 tag is not empty. Update the old one or create a new one.
 
-    if(d->ID3v1Location >= 0) {
+    if(d->ID3v1Location < 0)
+      d->ID3v1Location = length();
+
+    if(const ByteVector data = ID3v1Tag()->render();
+       !containsBlock(data, d->ID3v1Location, data.size())) {
       seek(d->ID3v1Location);
+      writeBlock(data);
     }
-    else {
-      seek(0, End);
-      d->ID3v1Location = tell();
-    }
-
-    writeBlock(ID3v1Tag()->render());
   }
   else {
 
@@ -371,6 +379,47 @@ bool FLAC::File::save()
   return true;
 }
 
+bool FLAC::File::isModified() const
+{
+  if(!isValid())
+    return false;
+
+  // The stream is shared with the file, its position is restored.
+
+  const auto tagsModified = [this] {
+    if(const ByteVector data = renderMetadata();
+       !data.isEmpty() && !containsBlock(data, d->flacStart, d->streamStart - d->flacStart))
+      return true;
+
+    if(const auto id3v2Tag = static_cast<ID3v2::Tag *>(d->tag[FlacID3v2Index]);
+       id3v2Tag && !id3v2Tag->isEmpty()) {
+      if(d->ID3v2Location < 0 ||
+         id3v2Tag->isModified(stream(), d->ID3v2Location, d->ID3v2OriginalSize))
+        return true;
+    }
+    else if(d->ID3v2Location >= 0) {
+      return true;
+    }
+
+    if(const auto id3v1Tag = static_cast<ID3v1::Tag *>(d->tag[FlacID3v1Index]);
+       id3v1Tag && !id3v1Tag->isEmpty()) {
+      if(const ByteVector data = id3v1Tag->render();
+         d->ID3v1Location < 0 || !containsBlock(data, d->ID3v1Location, data.size()))
+        return true;
+    }
+    else if(d->ID3v1Location >= 0) {
+      return true;
+    }
+
+    return false;
+  };
+
+  const offset_t position = tell();
+  const bool modified = tagsModified();
+  stream()->seek(position);
+  return modified;
+}
+
 ID3v2::Tag *FLAC::File::ID3v2Tag(bool create)
 {
   return d->tag.access<ID3v2::Tag>(FlacID3v2Index, create,
@@ -411,6 +460,8 @@ void FLAC::File::removePicture(Picture *picture, bool del)
 
   if(del)
     delete picture;
+  else if(!picture->dataReference().isNull())
+    picture->setData(picture->data());
 }
 
 void FLAC::File::removePictures()
@@ -440,6 +491,19 @@ void FLAC::File::strip(int tags)
   }
 }
 
+bool FLAC::File::stripTo(int tags, IOStream *target)
+{
+  Map<offset_t, size_t> skippedBlocks;
+
+  if((tags & ID3v2) && d->ID3v2Location >= 0)
+    skippedBlocks.insert(d->ID3v2Location, d->ID3v2OriginalSize);
+
+  if((tags & ID3v1) && d->ID3v1Location >= 0)
+    skippedBlocks.insert(d->ID3v1Location, 128);
+
+  return copyTo(target, skippedBlocks);
+}
+
 bool FLAC::File::hasXiphComment() const
 {
   return !d->xiphCommentData.isEmpty();
@@ -459,8 +523,10 @@ bool FLAC::File::hasID3v2Tag() const
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-void FLAC::File::read(bool readProperties)
+void FLAC::File::read(bool readProperties, Properties::ReadStyle readStyle)
 {
+  d->tagsOnly = readStyle == Properties::TagsOnly;
+
   // Look for an ID3v2 tag
 
   d->ID3v2Location = Utils::findID3v2(this);
@@ -489,7 +555,7 @@ void FLAC::File::read(bool readProperties)
   else
     d->tag.set(FlacXiphIndex, new Ogg::XiphComment());
 
-  if(readProperties) {
+  if(readProperties && !d->tagsOnly) {
 
     // First block should be the stream_info metadata
 
@@ -574,6 +640,47 @@ void FLAC::File::scan()
       return;
     }
 
+    if(d->tagsOnly && blockType != MetadataBlock::StreamInfo &&
+       blockType != MetadataBlock::VorbisComment && blockType != MetadataBlock::Picture) {
+      if(nextBlockOffset + 4 + blockLength > length()) {
+        debug("FLAC::File::scan() -- Failed to read a metadata block");
+        setValid(false);
+        return;
+      }
+
+      if(blockType != MetadataBlock::Padding) {
+        auto block = new UnknownMetadataBlock(blockType, ByteVector());
+        d->blocks.append(block);
+        d->deferredBlocks.push_back({ block, nextBlockOffset + 4, blockLength });
+      }
+
+      nextBlockOffset += blockLength + 4;
+
+      if(isLastBlock)
+        break;
+
+      continue;
+    }
+
+    if(blockType == MetadataBlock::Picture && nextBlockOffset + 4 + blockLength <= length()) {
+      // Only the header of the picture is read if it fits into the first
+      // bytes, the picture data is read from the file when it is needed.
+
+      auto picture = new FLAC::Picture();
+      if(picture->parseHeader(readBlock(std::min(blockLength, MaxPictureHeaderLength)),
+                              this, nextBlockOffset + 4, blockLength)) {
+        d->blocks.append(picture);
+        nextBlockOffset += blockLength + 4;
+
+        if(isLastBlock)
+          break;
+
+        continue;
+      }
+      delete picture;
+      seek(nextBlockOffset + 4);
+    }
+
     const ByteVector data = readBlock(blockLength);
     if(data.size() != blockLength) {
       debug("FLAC::File::scan() -- Failed to read a metadata block");
@@ -625,3 +732,76 @@ void FLAC::File::scan()
 
   d->scanned = true;
 }
+
+ByteVector FLAC::File::renderMetadata() const
+{
+  // Render the Vorbis Comment block.  If the file has none, the values of the
+  // other tags are added to the new comment as save() does.
+
+  const auto comment = static_cast<Ogg::XiphComment *>(d->tag[FlacXiphIndex]);
+  ByteVector commentData;
+  if(hasXiphComment()) {
+    commentData = comment->render(false);
+  }
+  else {
+    Ogg::XiphComment newComment(comment ? comment->render(false) : ByteVector());
+    Tag::duplicate(&d->tag, &newComment, false);
+    commentData = newComment.render(false);
+  }
+
+  // Render data for the metadata blocks, the Vorbis Comment block replaces
+  // the old one and is placed before the first picture block.  The metadata
+  // blocks which have been skipped in TagsOnly mode are read from the file.
+
+  const auto renderBlock = [](int code, const ByteVector &blockData) {
+    ByteVector blockHeader = ByteVector::fromUInt(blockData.size());
+    blockHeader[0] = static_cast<char>(code);
+    return blockHeader + blockData;
+  };
+
+  ByteVector data;
+  bool commentRendered = false;
+  for(const auto &block : std::as_const(d->blocks)) {
+    if(block->code() == MetadataBlock::VorbisComment)
+      continue;
+    if(!commentRendered && block->code() == MetadataBlock::Picture) {
+      data.append(renderBlock(MetadataBlock::VorbisComment, commentData));
+      commentRendered = true;
+    }
+
+    ByteVector blockData;
+    if(const auto deferred = std::find_if(
+         d->deferredBlocks.cbegin(), d->deferredBlocks.cend(),
+         [block](const FilePrivate::DeferredBlock &b) { return b.block == block; });
+       deferred != d->deferredBlocks.cend()) {
+      stream()->seek(deferred->offset);
+      blockData = stream()->readBlock(deferred->length);
+      if(blockData.size() != deferred->length) {
+        debug("FLAC::File::renderMetadata() -- Failed to read a metadata block");
+        return ByteVector();
+      }
+    }
+    else {
+      blockData = block->render();
+    }
+    data.append(renderBlock(block->code(), blockData));
+  }
+  if(!commentRendered)
+    data.append(renderBlock(MetadataBlock::VorbisComment, commentData));
+
+  // Compute the amount of padding, and append that to data.
+
+  const offset_t originalLength = d->streamStart - d->flacStart;
+  // The length of a metadata block is a 24 bit value.
+
+  const offset_t paddingLength = std::min<offset_t>(paddingPolicy().padding(
+    originalLength - data.size() - 4, stream()->length(),
+    MinPaddingLength, PaddingPolicy::ShrinkLargePadding), 0xFFFFFF);
+
+  ByteVector paddingHeader = ByteVector::fromUInt(static_cast<unsigned int>(paddingLength));
+  paddingHeader[0] = static_cast<char>(MetadataBlock::Padding | LastBlockFlag);
+  data.append(paddingHeader);
+  data.resize(static_cast<unsigned int>(data.size() + paddingLength));
+
+  return data;
+}
@@ -211,10 +211,19 @@ namespace TagLib {
        * will also keep any old ID3-tags up to date. If the file
        * has no XiphComment, one will be constructed from the ID3-tags.
        *
-       * This returns \c true if the save was successful.
+       * This returns \c true if the save was successful.  Nothing is written
+       * if isModified() returns \c false.
        */
       bool save() override;
 
+      /*!
+       * Returns \c true if the metadata blocks or the ID3 tags differ from
+       * the data stored in the file.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * Returns a pointer to the ID3v2 tag of the file.
        *
@@ -311,6 +320,21 @@ namespace TagLib {
        */
       void strip(int tags = AllTags);
 
+      /*!
+       * Writes the file without the ID3v1 and ID3v2 tags that match the OR-ed
+       * together TagTypes to \a target, which is overwritten.  The rest of the
+       * file is copied sequentially, so no part of the file has to be moved in
+       * place.  This file and its tags are not modified, unsaved changes are
+       * not written to \a target.  It returns \c true if the file has been
+       * written successfully.
+       *
+       * \note The XiphComment is part of the FLAC metadata and is always
+       * copied as stored in the file, use strip() and save() to remove it.
+       *
+       * \see TagLib::File::copyTo()
+       */
+      bool stripTo(int tags, IOStream *target);
+
       /*!
        * Returns whether or not the file on disk actually has a XiphComment.
        *
@@ -342,8 +366,9 @@ namespace TagLib {
       static bool isSupported(IOStream *stream);
 
     private:
-      void read(bool readProperties);
+      void read(bool readProperties, Properties::ReadStyle readStyle);
       void scan();
+      ByteVector renderMetadata() const;
 
       class FilePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -40,6 +40,7 @@ public:
   int colorDepth { 0 };
   int numColors { 0 };
   ByteVector data;
+  PictureReference dataReference;
 };
 
 FLAC::Picture::Picture() :
@@ -61,6 +62,24 @@ int FLAC::Picture::code() const
 }
 
 bool FLAC::Picture::parse(const ByteVector &data)
+{
+  unsigned int dataOffset;
+  unsigned int dataLength;
+  if(!parseFields(data, dataOffset, dataLength))
+    return false;
+
+  if(dataOffset + dataLength > data.size()) {
+    debug("Invalid picture block.");
+    return false;
+  }
+  d->data = data.mid(dataOffset, dataLength);
+  d->dataReference = PictureReference();
+
+  return true;
+}
+
+bool FLAC::Picture::parseFields(const ByteVector &data, unsigned int &dataOffset,
+                                unsigned int &dataLength)
 {
   if(data.size() < 32) {
     debug("A picture block must contain at least 5 bytes.");
@@ -94,14 +113,36 @@ bool FLAC::Picture::parse(const ByteVector &data)
   pos += 4;
   d->numColors = data.toUInt(pos);
   pos += 4;
-  unsigned int dataLength = data.toUInt(pos);
+  dataLength = data.toUInt(pos);
   pos += 4;
-  if(pos + dataLength > data.size()) {
-    debug("Invalid picture block.");
+  dataOffset = pos;
+
+  return true;
+}
+
+bool FLAC::Picture::parseHeader(const ByteVector &header, TagLib::File *file,
+                                offset_t offset, unsigned int length)
+{
+  // Check if the header with the MIME type and the description is complete,
+  // the picture block of length bytes is parsed by parse() otherwise.
+
+  if(header.size() < 32)
+    return false;
+  const unsigned int mimeTypeLength = header.toUInt(4U);
+  if(mimeTypeLength > header.size() - 32)
+    return false;
+  const unsigned int descriptionLength = header.toUInt(8U + mimeTypeLength);
+  if(descriptionLength > header.size() - 32 - mimeTypeLength)
+    return false;
+
+  unsigned int dataOffset;
+  unsigned int dataLength;
+  if(!parseFields(header, dataOffset, dataLength) ||
+     dataLength > length || dataOffset > length - dataLength)
     return false;
-  }
-  d->data = data.mid(pos, dataLength);
 
+  d->data.clear();
+  d->dataReference = PictureReference(file, offset + dataOffset, dataLength);
   return true;
 }
 
@@ -119,8 +160,9 @@ ByteVector FLAC::Picture::render() const
   result.append(ByteVector::fromUInt(d->height));
   result.append(ByteVector::fromUInt(d->colorDepth));
   result.append(ByteVector::fromUInt(d->numColors));
-  result.append(ByteVector::fromUInt(d->data.size()));
-  result.append(d->data);
+  const ByteVector pictureData = data();
+  result.append(ByteVector::fromUInt(pictureData.size()));
+  result.append(pictureData);
   return result;
 }
 
@@ -196,10 +238,18 @@ void FLAC::Picture::setNumColors(int numColors)
 
 ByteVector FLAC::Picture::data() const
 {
+  if(!d->dataReference.isNull())
+    return d->dataReference.data();
   return d->data;
 }
 
 void FLAC::Picture::setData(const ByteVector &data)
 {
   d->data = data;
+  d->dataReference = PictureReference();
+}
+
+PictureReference FLAC::Picture::dataReference() const
+{
+  return d->dataReference;
 }
@@ -30,6 +30,7 @@
 #include "tstring.h"
 #include "tbytevector.h"
 #include "tpicturetype.h"
+#include "tpicturereference.h"
 #include "taglib_export.h"
 #include "flacmetadatablock.h"
 
@@ -128,6 +129,11 @@ namespace TagLib {
 
       /*!
        * Returns the image data.
+       *
+       * \note The data of pictures read from a file is not kept in memory,
+       * it is read from the file each time this method is called.
+       *
+       * \see dataReference()
        */
       ByteVector data() const;
 
@@ -136,6 +142,14 @@ namespace TagLib {
        */
       void setData(const ByteVector &data);
 
+      /*!
+       * Returns the location of the image data in the file, which can be used
+       * to copy it without loading it completely.  A null reference is
+       * returned if the picture was not read from a file or its data has been
+       * set using setData().
+       */
+      PictureReference dataReference() const;
+
       /*!
        * Returns the FLAC metadata block type.
        */
@@ -152,6 +166,13 @@ namespace TagLib {
       bool parse(const ByteVector &data);
 
     private:
+      friend class File;
+
+      bool parseFields(const ByteVector &data, unsigned int &dataOffset,
+                       unsigned int &dataLength);
+      bool parseHeader(const ByteVector &header, TagLib::File *file,
+                       offset_t offset, unsigned int length);
+
       class PicturePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
       std::unique_ptr<PicturePrivate> d;
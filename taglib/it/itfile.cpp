@@ -35,19 +35,21 @@ using namespace IT;
 class IT::File::FilePrivate
 {
 public:
-  FilePrivate(AudioProperties::ReadStyle propertiesStyle)
-    :  properties(propertiesStyle)
+  FilePrivate(bool readAudioProperties, AudioProperties::ReadStyle propertiesStyle)
+    : properties(propertiesStyle),
+      readProperties(readAudioProperties && propertiesStyle != AudioProperties::TagsOnly)
   {
   }
 
   Mod::Tag       tag;
   IT::Properties properties;
+  bool readProperties;
 };
 
 IT::File::File(FileName file, bool readProperties,
                AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(file),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -56,7 +58,7 @@ IT::File::File(FileName file, bool readProperties,
 IT::File::File(IOStream *stream, bool readProperties,
                AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(stream),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -71,7 +73,7 @@ Mod::Tag *IT::File::tag() const
 
 IT::Properties *IT::File::audioProperties() const
 {
-  return &d->properties;
+  return d->readProperties ? &d->properties : nullptr;
 }
 
 bool IT::File::save()
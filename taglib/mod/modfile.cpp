@@ -36,19 +36,21 @@ using namespace Mod;
 class Mod::File::FilePrivate
 {
 public:
-  FilePrivate(AudioProperties::ReadStyle propertiesStyle)
-    : properties(propertiesStyle)
+  FilePrivate(bool readAudioProperties, AudioProperties::ReadStyle propertiesStyle)
+    : properties(propertiesStyle),
+      readProperties(readAudioProperties && propertiesStyle != AudioProperties::TagsOnly)
   {
   }
 
   Mod::Tag        tag;
   Mod::Properties properties;
+  bool readProperties;
 };
 
 Mod::File::File(FileName file, bool readProperties,
                 AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(file),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -57,7 +59,7 @@ Mod::File::File(FileName file, bool readProperties,
 Mod::File::File(IOStream *stream, bool readProperties,
                 AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(stream),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -72,7 +74,7 @@ Mod::Tag *Mod::File::tag() const
 
 Mod::Properties *Mod::File::audioProperties() const
 {
-  return &d->properties;
+  return d->readProperties ? &d->properties : nullptr;
 }
 
 PropertyMap Mod::File::properties() const
@@ -83,6 +83,13 @@ unsigned int Mod::Tag::track() const
   return 0;
 }
 
+void Mod::Tag::basicFields(BasicFields &fields) const
+{
+  fields = BasicFields();
+  fields.title = d->title;
+  fields.comment = d->comment;
+}
+
 String Mod::Tag::trackerName() const
 {
   return d->trackerName;
@@ -92,6 +92,12 @@ namespace TagLib {
        */
       unsigned int track() const override;
 
+      /*!
+       * Sets \a fields to the title and the comment, the other fields are
+       * not supported by module files.
+       */
+      void basicFields(BasicFields &fields) const override;
+
       /*!
        * Returns the name of the tracker used to create/edit the module file.
        * Only XM files store this tag to the file as such, for other formats
@@ -52,6 +52,11 @@ public:
 };
 
 MP4::Atom::Atom(File *file)
+  : Atom(file, false)
+{
+}
+
+MP4::Atom::Atom(File *file, bool tagsOnly)
   : d(std::make_unique<AtomPrivate>(file->tell()))
 {
   d->children.setAutoDelete(true);
@@ -98,6 +103,11 @@ MP4::Atom::Atom(File *file)
 
   for(auto c : containers) {
     if(d->name == c) {
+      if(tagsOnly && (d->name == "trak" || d->name == "moof")) {
+        // The track and fragment atoms do not contain tags, their children
+        // are only needed to update the offsets when the file is saved.
+        break;
+      }
       if(d->name == "meta") {
         offset_t posAfterMeta = file->tell();
         static constexpr std::array metaChildrenNames {
@@ -115,7 +125,7 @@ MP4::Atom::Atom(File *file)
         file->seek(8, File::Current);
       }
       while(file->tell() < d->offset + d->length) {
-        auto child = new MP4::Atom(file);
+        auto child = new MP4::Atom(file, tagsOnly);
         d->children.append(child);
         if(child->d->length == 0)
           return;
@@ -211,23 +221,34 @@ const MP4::AtomList &MP4::Atom::children() const
 class MP4::Atoms::AtomsPrivate
 {
 public:
+  void parse(File *file)
+  {
+    file->seek(0, File::End);
+    offset_t end = file->tell();
+    file->seek(0);
+    while(file->tell() + 8 <= end) {
+      auto atom = new MP4::Atom(file, tagsOnly);
+      atoms.append(atom);
+      if (atom->length() == 0)
+        break;
+    }
+  }
+
   AtomList atoms;
+  bool tagsOnly { false };
 };
 
 MP4::Atoms::Atoms(File *file) :
+  Atoms(file, false)
+{
+}
+
+MP4::Atoms::Atoms(File *file, bool tagsOnly) :
   d(std::make_unique<AtomsPrivate>())
 {
   d->atoms.setAutoDelete(true);
-
-  file->seek(0, File::End);
-  offset_t end = file->tell();
-  file->seek(0);
-  while(file->tell() + 8 <= end) {
-    auto atom = new MP4::Atom(file);
-    d->atoms.append(atom);
-    if (atom->length() == 0)
-      break;
-  }
+  d->tagsOnly = tagsOnly;
+  d->parse(file);
 }
 
 MP4::Atoms::~Atoms() = default;
@@ -293,3 +314,14 @@ const MP4::AtomList &MP4::Atoms::atoms() const
 {
   return d->atoms;
 }
+
+bool MP4::Atoms::complete(File *file)
+{
+  if(!d->tagsOnly)
+    return true;
+
+  d->atoms.clear();
+  d->tagsOnly = false;
+  d->parse(file);
+  return checkRootLevelAtoms();
+}
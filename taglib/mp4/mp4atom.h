@@ -75,6 +75,7 @@ namespace TagLib {
     {
     public:
       Atom(File *file);
+      Atom(File *file, bool tagsOnly);
       ~Atom();
       Atom(const Atom &) = delete;
       Atom &operator=(const Atom &) = delete;
@@ -100,6 +101,7 @@ namespace TagLib {
     {
     public:
       Atoms(File *file);
+      Atoms(File *file, bool tagsOnly);
       ~Atoms();
       Atoms(const Atoms &) = delete;
       Atoms &operator=(const Atoms &) = delete;
@@ -107,6 +109,7 @@ namespace TagLib {
       AtomList path(const char *name1, const char *name2 = nullptr, const char *name3 = nullptr, const char *name4 = nullptr) const;
       bool checkRootLevelAtoms();
       const AtomList &atoms() const;
+      bool complete(File *file);
 
     private:
       class AtomsPrivate;
@@ -32,6 +32,7 @@ class MP4::CoverArt::CoverArtPrivate
 public:
   Format format { MP4::CoverArt::JPEG };
   ByteVector data;
+  PictureReference dataReference;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,6 +71,18 @@ MP4::CoverArt::data() const
   return d->data;
 }
 
+PictureReference
+MP4::CoverArt::dataReference() const
+{
+  return d->dataReference;
+}
+
+void
+MP4::CoverArt::setDataReference(const PictureReference &reference)
+{
+  d->dataReference = reference;
+}
+
 bool MP4::CoverArt::operator==(const CoverArt &other) const
 {
   return format() == other.format() && data() == other.data();
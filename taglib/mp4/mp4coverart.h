@@ -28,6 +28,7 @@
 
 #include "tlist.h"
 #include "tbytevector.h"
+#include "tpicturereference.h"
 #include "taglib_export.h"
 #include "mp4atom.h"
 
@@ -69,6 +70,13 @@ namespace TagLib {
       //! The image data
       ByteVector data() const;
 
+      /*!
+       * Returns the location of the image data in the file it was read from,
+       * which can be used to copy it in chunks.  A null reference is returned
+       * if the cover art was not read from a file.
+       */
+      PictureReference dataReference() const;
+
       /*!
        * Returns \c true if the CoverArt and \a other are of the same format and
        * contain the same data.
@@ -81,6 +89,10 @@ namespace TagLib {
       bool operator!=(const CoverArt &other) const;
 
     private:
+      friend class Tag;
+
+      void setDataReference(const PictureReference &reference);
+
       class CoverArtPrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
       std::shared_ptr<CoverArtPrivate> d;
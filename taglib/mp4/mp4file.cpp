@@ -66,22 +66,22 @@ bool MP4::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-MP4::File::File(FileName file, bool readProperties, AudioProperties::ReadStyle,
+MP4::File::File(FileName file, bool readProperties, AudioProperties::ReadStyle readStyle,
                 ItemFactory *itemFactory) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>(itemFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
-MP4::File::File(IOStream *stream, bool readProperties, AudioProperties::ReadStyle,
+MP4::File::File(IOStream *stream, bool readProperties, AudioProperties::ReadStyle readStyle,
                 ItemFactory *itemFactory) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>(itemFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties, readStyle);
 }
 
 MP4::File::~File() = default;
@@ -112,12 +112,14 @@ MP4::Properties *MP4::File::audioProperties() const
 }
 
 void
-MP4::File::read(bool readProperties)
+MP4::File::read(bool readProperties, AudioProperties::ReadStyle readStyle)
 {
   if(!isValid())
     return;
 
-  d->atoms = std::make_unique<Atoms>(this);
+  const bool tagsOnly = readStyle == AudioProperties::TagsOnly;
+
+  d->atoms = std::make_unique<Atoms>(this, tagsOnly);
   if(!d->atoms->checkRootLevelAtoms()) {
     setValid(false);
     return;
@@ -130,7 +132,7 @@ MP4::File::read(bool readProperties)
   }
 
   d->tag = std::make_unique<Tag>(this, d->atoms.get(), d->itemFactory);
-  if(readProperties) {
+  if(readProperties && !tagsOnly) {
     d->properties = std::make_unique<Properties>(this, d->atoms.get());
   }
 }
@@ -148,9 +150,32 @@ MP4::File::save()
     return false;
   }
 
+  if(!d->atoms->complete(this)) {
+    debug("MP4::File::save() -- Failed to read the atoms.");
+    return false;
+  }
+
   return d->tag->save();
 }
 
+bool
+MP4::File::isModified() const
+{
+  // The atoms skipped in TagsOnly mode are only read from the file, this does
+  // not modify it.
+
+  if(!isValid())
+    return false;
+
+  // The stream is shared with the file, its position is restored.
+
+  const offset_t position = tell();
+  const bool modified = d->atoms->complete(const_cast<File *>(this)) &&
+                        d->tag->isModified();
+  stream()->seek(position);
+  return modified;
+}
+
 bool
 MP4::File::strip(int tags)
 {
@@ -164,6 +189,11 @@ MP4::File::strip(int tags)
     return false;
   }
 
+  if(!d->atoms->complete(this)) {
+    debug("MP4::File::strip() -- Failed to read the atoms.");
+    return false;
+  }
+
   if(tags & MP4) {
     return d->tag->strip();
   }
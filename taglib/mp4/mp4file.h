@@ -137,6 +137,13 @@ namespace TagLib {
        */
       bool save() override;
 
+      /*!
+       * Returns \c true if the tag differs from the tag stored in the file.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * This will strip the tags that match the OR-ed together TagTypes from the
        * file.  By default it strips all tags.  It returns \c true if the tags are
@@ -162,7 +169,7 @@ namespace TagLib {
       static bool isSupported(IOStream *stream);
 
     private:
-      void read(bool readProperties);
+      void read(bool readProperties, AudioProperties::ReadStyle readStyle);
 
       class FilePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
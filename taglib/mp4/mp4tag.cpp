@@ -75,6 +75,8 @@ MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms,
     ByteVector data = d->file->readBlock(atom->length() - 8);
     if(const auto &[name, itm] = d->factory->parseItem(atom, data);
        itm.isValid()) {
+      if(name == "covr")
+        setCoverArtReferences(itm.toCoverArtList(), atom->offset() + 8, data);
       addItem(name, itm);
     }
   }
@@ -83,12 +85,15 @@ MP4::Tag::Tag(TagLib::File *file, MP4::Atoms *atoms,
 MP4::Tag::~Tag() = default;
 
 ByteVector
-MP4::Tag::padIlst(const ByteVector &data, int length) const
+MP4::Tag::padIlst(const ByteVector &data, offset_t available) const
 {
-  if(length == -1) {
-    length = ((data.size() + 1023) & ~1023) - data.size();
-  }
-  return renderAtom("free", ByteVector(length, '\1'));
+  // By default, the free atom fills the available space or pads the 'ilst'
+  // atom to the next multiple of 1 KB.
+
+  const offset_t length = d->file->paddingPolicy().padding(
+    available, d->file->length(), ((data.size() + 1023) & ~1023) - data.size(),
+    PaddingPolicy::NeverShrink);
+  return renderAtom("free", ByteVector(static_cast<unsigned int>(length), '\1'));
 }
 
 ByteVector
@@ -97,14 +102,20 @@ MP4::Tag::renderAtom(const ByteVector &name, const ByteVector &data) const
   return ByteVector::fromUInt(data.size() + 8) + name + data;
 }
 
-bool
-MP4::Tag::save()
+ByteVector
+MP4::Tag::renderIlst() const
 {
   ByteVector data;
   for(const auto &[name, itm] : std::as_const(d->items)) {
     data.append(d->factory->renderItem(name, itm));
   }
-  data = renderAtom("ilst", data);
+  return renderAtom("ilst", data);
+}
+
+bool
+MP4::Tag::save()
+{
+  ByteVector data = renderIlst();
 
   AtomList path = d->atoms->path("moov", "udta", "meta", "ilst");
   if(path.size() == 4) {
@@ -117,6 +128,27 @@ MP4::Tag::save()
   return true;
 }
 
+bool
+MP4::Tag::isModified() const
+{
+  AtomList path = d->atoms->path("moov", "udta", "meta", "ilst");
+  if(path.size() != 4)
+    return true;
+
+  offset_t offset;
+  offset_t length;
+  findIlstSpace(path, offset, length);
+
+  ByteVector data = renderIlst();
+  if(const offset_t delta = data.size() - length; delta != 0)
+    data.append(padIlst(data, -delta - 8));
+
+  const offset_t position = d->file->tell();
+  const bool modified = !d->file->containsBlock(data, offset, length);
+  d->file->seek(position);
+  return modified;
+}
+
 bool
 MP4::Tag::strip()
 {
@@ -251,15 +283,15 @@ MP4::Tag::saveNew(ByteVector data)
 }
 
 void
-MP4::Tag::saveExisting(ByteVector data, const AtomList &path)
+MP4::Tag::findIlstSpace(const AtomList &path, offset_t &offset, offset_t &length) const
 {
   auto it = path.end();
 
   MP4::Atom *ilst = *(--it);
-  offset_t offset = ilst->offset();
-  offset_t length = ilst->length();
+  offset = ilst->offset();
+  length = ilst->length();
 
-  MP4::Atom *meta = *(--it);
+  const MP4::Atom *meta = *(--it);
   auto index = meta->children().cfind(ilst);
 
   // check if there is an atom before 'ilst', and possibly use it as padding
@@ -277,19 +309,27 @@ MP4::Tag::saveExisting(ByteVector data, const AtomList &path)
       length += next->length();
     }
   }
+}
+
+void
+MP4::Tag::saveExisting(ByteVector data, const AtomList &path)
+{
+  auto it = std::prev(path.end(), 2);
+  MP4::Atom *meta = *it;
+
+  offset_t offset;
+  offset_t length;
+  findIlstSpace(path, offset, length);
 
   offset_t delta = data.size() - length;
   if(!data.isEmpty()) {
-    if(delta > 0 || (delta < 0 && delta > -8)) {
-      data.append(padIlst(data));
+    if(delta != 0) {
+      data.append(padIlst(data, -delta - 8));
       delta = data.size() - length;
     }
-    else if(delta < 0) {
-      data.append(padIlst(data, static_cast<int>(-delta - 8)));
-      delta = 0;
-    }
 
-    d->file->insert(data, offset, length);
+    if(!d->file->containsBlock(data, offset, length))
+      d->file->insert(data, offset, length);
 
     if(delta) {
       updateParents(path, delta, 1);
@@ -368,6 +408,24 @@ MP4::Tag::track() const
   return 0;
 }
 
+void
+MP4::Tag::basicFields(BasicFields &fields) const
+{
+  const auto text = [this](const String &key) {
+    const auto it = d->items.find(key);
+    return it != d->items.end() ? it->second.toStringList().toString(", ") : String();
+  };
+
+  fields.title = text("\251nam");
+  fields.artist = text("\251ART");
+  fields.album = text("\251alb");
+  fields.comment = text("\251cmt");
+  fields.genre = text("\251gen");
+  fields.year = text("\251day").toInt();
+  const auto it = d->items.find("trkn");
+  fields.track = it != d->items.end() ? it->second.toIntPair().first : 0;
+}
+
 void
 MP4::Tag::setTitle(const String &value)
 {
@@ -583,3 +641,24 @@ void MP4::Tag::addItem(const String &name, const Item &value)
     debug("MP4: Ignoring duplicate atom \"" + name + "\"");
   }
 }
+
+void MP4::Tag::setCoverArtReferences(CoverArtList covers, offset_t offset,
+                                     const ByteVector &data)
+{
+  // Find the "data" atoms of the covers parsed from data, which was read at
+  // offset, and remember the location of the image data in the file.
+
+  auto it = covers.begin();
+  unsigned int pos = 0;
+  while(it != covers.end() && pos + 16 <= data.size()) {
+    const unsigned int length = data.toUInt(pos);
+    if(length < 16 || length > data.size() - pos)
+      break;
+
+    if(data.containsAt("data", pos + 4) && it->data().size() == length - 16) {
+      it->setDataReference(PictureReference(d->file, offset + pos + 16, length - 16));
+      ++it;
+    }
+    pos += length;
+  }
+}
@@ -58,6 +58,7 @@ namespace TagLib {
         String genre() const override;
         unsigned int year() const override;
         unsigned int track() const override;
+        void basicFields(BasicFields &fields) const override;
 
         void setTitle(const String &value) override;
         void setArtist(const String &value) override;
@@ -100,6 +101,12 @@ namespace TagLib {
          */
         bool strip();
 
+        /*!
+         * Returns \c true if save() would change the associated file, i.e.
+         * if the rendered items differ from the 'ilst' atom in the file.
+         */
+        bool isModified() const;
+
         PropertyMap properties() const override;
         void removeUnsupportedProperties(const StringList &props) override;
         PropertyMap setProperties(const PropertyMap &props) override;
@@ -116,8 +123,10 @@ namespace TagLib {
         void setTextItem(const String &key, const String &value);
 
     private:
-        ByteVector padIlst(const ByteVector &data, int length = -1) const;
+        ByteVector padIlst(const ByteVector &data, offset_t available = -1) const;
         ByteVector renderAtom(const ByteVector &name, const ByteVector &data) const;
+        ByteVector renderIlst() const;
+        void findIlstSpace(const AtomList &path, offset_t &offset, offset_t &length) const;
 
 
         void updateParents(const AtomList &path, offset_t delta, int ignore = 0);
@@ -127,6 +136,8 @@ namespace TagLib {
         void saveExisting(ByteVector data, const AtomList &path);
 
         void addItem(const String &name, const Item &value);
+        void setCoverArtReferences(CoverArtList covers, offset_t offset,
+                                   const ByteVector &data);
 
         class TagPrivate;
         TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -75,20 +75,20 @@ bool MPC::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-MPC::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+MPC::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-MPC::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
+MPC::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 MPC::File::~File() = default;
@@ -95,6 +95,15 @@ ID3v1::Tag::Tag(File *file, offset_t tagOffset) :
   read();
 }
 
+ID3v1::Tag::Tag(File *file, offset_t tagOffset, const ByteVector &data) :
+  d(std::make_unique<TagPrivate>())
+{
+  d->file = file;
+  d->tagOffset = tagOffset;
+
+  read(data);
+}
+
 ID3v1::Tag::~Tag() = default;
 
 ByteVector ID3v1::Tag::render() const
@@ -154,6 +163,17 @@ unsigned int ID3v1::Tag::track() const
   return d->track;
 }
 
+void ID3v1::Tag::basicFields(BasicFields &fields) const
+{
+  fields.title = d->title;
+  fields.artist = d->artist;
+  fields.album = d->album;
+  fields.comment = d->comment;
+  fields.genre = ID3v1::genre(d->genre);
+  fields.year = d->year.toInt();
+  fields.track = d->track;
+}
+
 void ID3v1::Tag::setTitle(const String &s)
 {
   d->title = s;
@@ -212,14 +232,22 @@ void ID3v1::Tag::setStringHandler(const StringHandler *handler)
 ////////////////////////////////////////////////////////////////////////////////
 
 void ID3v1::Tag::read()
+{
+  read(ByteVector());
+}
+
+void ID3v1::Tag::read(const ByteVector &data)
 {
   if(d->file && d->file->isValid()) {
-    d->file->seek(d->tagOffset);
     // read the tag -- always 128 bytes
+    ByteVector tagData = data.mid(0, 128);
+    if(tagData.size() < 128) {
+      d->file->seek(d->tagOffset);
+      tagData = d->file->readBlock(128);
+    }
     // some initial sanity checking
-    if(const ByteVector data = d->file->readBlock(128);
-       data.size() == 128 && data.startsWith("TAG"))
-      parse(data);
+    if(tagData.size() == 128 && tagData.startsWith("TAG"))
+      parse(tagData);
     else
       debug("ID3v1 tag is not valid or could not be read at the specified offset.");
   }
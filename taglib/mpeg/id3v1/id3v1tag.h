@@ -125,6 +125,16 @@ namespace TagLib {
        */
       Tag(File *file, offset_t tagOffset);
 
+      /*!
+       * Create an ID3v1 tag located in \a file at \a tagOffset as above, but
+       * parse the tag from \a data, which the caller has already read from
+       * \a tagOffset.  The file is only read if \a data does not contain the
+       * complete tag.
+       *
+       * \see read(const ByteVector &)
+       */
+      Tag(File *file, offset_t tagOffset, const ByteVector &data);
+
       /*!
        * Destroys this Tag instance.
        */
@@ -154,6 +164,7 @@ namespace TagLib {
       String genre() const override;
       unsigned int year() const override;
       unsigned int track() const override;
+      void basicFields(BasicFields &fields) const override;
 
       void setTitle(const String &s) override;
       void setArtist(const String &s) override;
@@ -196,6 +207,13 @@ namespace TagLib {
        * Reads from the file specified in the constructor.
        */
       void read();
+
+      /*!
+       * Reads the tag like read(), but takes the tag from \a data if it
+       * contains all 128 bytes of it.
+       */
+      void read(const ByteVector &data);
+
       /*!
        * Parses the body of the tag in \a data.
        */
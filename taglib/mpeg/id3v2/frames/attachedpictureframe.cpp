@@ -39,6 +39,7 @@ public:
   AttachedPictureFrame::Type type { AttachedPictureFrame::Other };
   String description;
   ByteVector data;
+  PictureReference pictureReference;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -119,6 +120,12 @@ ByteVector AttachedPictureFrame::picture() const
 void AttachedPictureFrame::setPicture(const ByteVector &p)
 {
   d->data = p;
+  d->pictureReference = PictureReference();
+}
+
+PictureReference AttachedPictureFrame::pictureReference() const
+{
+  return d->pictureReference;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -177,6 +184,11 @@ AttachedPictureFrame::AttachedPictureFrame(const ByteVector &data, Header *h) :
   parseFields(fieldData(data));
 }
 
+void AttachedPictureFrame::setPictureReference(const PictureReference &reference)
+{
+  d->pictureReference = reference;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // support for ID3v2.2 PIC frames
 ////////////////////////////////////////////////////////////////////////////////
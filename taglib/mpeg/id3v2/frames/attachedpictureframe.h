@@ -28,6 +28,7 @@
 
 #include "taglib_export.h"
 #include "tpicturetype.h"
+#include "tpicturereference.h"
 #include "id3v2frame.h"
 
 namespace TagLib {
@@ -167,6 +168,15 @@ namespace TagLib {
        */
       void setPicture(const ByteVector &p);
 
+      /*!
+       * Returns the location of the image data in the file the tag was read
+       * from, which can be used to copy it in chunks.  A null reference is
+       * returned if the frame was not read from a file, setPicture() has been
+       * called or the data is not stored as it is or unsynchronised in the
+       * file, e.g. for compressed frames.
+       */
+      PictureReference pictureReference() const;
+
     protected:
       void parseFields(const ByteVector &data) override;
       ByteVector renderFields() const override;
@@ -175,7 +185,10 @@ namespace TagLib {
       std::unique_ptr<AttachedPictureFramePrivate> d;
 
     private:
+      friend class Tag;
+
       AttachedPictureFrame(const ByteVector &data, Header *h);
+      void setPictureReference(const PictureReference &reference);
     };
 
     //! support for ID3v2.2 PIC frames
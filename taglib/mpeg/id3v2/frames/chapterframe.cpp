@@ -43,6 +43,7 @@ public:
   }
 
   const ID3v2::Header *tagHeader { nullptr };
+  const FrameFactory *factory { nullptr };
   ByteVector elementID;
   unsigned int startTime { 0 };
   unsigned int endTime { 0 };
@@ -216,6 +217,15 @@ PropertyMap ChapterFrame::asProperties() const
 
 ChapterFrame *ChapterFrame::findByElementID(const ID3v2::Tag *tag, const ByteVector &eID) // static
 {
+  // If the CHAP frames have not been created yet, only the requested frame
+  // is created.
+
+  if(Frame *indexed; tag->findIndexedChapterFrame(eID, &indexed)) {
+    auto frame = dynamic_cast<ChapterFrame *>(indexed);
+    if(!indexed || (frame && frame->elementID() == eID))
+      return frame;
+  }
+
   for(const auto &comment : std::as_const(tag->frameList("CHAP"))) {
     auto frame = dynamic_cast<ChapterFrame *>(comment);
     if(frame && frame->elementID() == eID)
@@ -235,7 +245,6 @@ void ChapterFrame::parseFields(const ByteVector &data)
   }
 
   int pos = 0;
-  unsigned int embPos = 0;
   d->elementID = readStringField(data, String::Latin1, &pos).data(String::Latin1);
   d->startTime = data.toUInt(pos, true);
   pos += 4;
@@ -245,28 +254,13 @@ void ChapterFrame::parseFields(const ByteVector &data)
   pos += 4;
   d->endOffset = data.toUInt(pos, true);
   pos += 4;
-  size -= pos;
 
   // Embedded frames are optional
 
-  if(size < header()->size())
-    return;
-
-  while(embPos < size - header()->size()) {
-    Frame *frame = FrameFactory::instance()->createFrame(data.mid(pos + embPos), d->tagHeader);
-
-    if(!frame)
-      return;
-
-    // Checks to make sure that frame parsed correctly.
-    if(frame->size() <= 0) {
-      delete frame;
-      return;
-    }
-
-    embPos += frame->size() + header()->size();
+  const FrameList frames = createEmbeddedFrames(
+    data.mid(pos), d->tagHeader, d->factory ? d->factory : FrameFactory::instance());
+  for(const auto &frame : frames)
     addEmbeddedFrame(frame);
-  }
 }
 
 ByteVector ChapterFrame::renderFields() const
@@ -287,10 +281,15 @@ ByteVector ChapterFrame::renderFields() const
   return data;
 }
 
-ChapterFrame::ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h) :
+ChapterFrame::ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h,
+                           const FrameFactory *factory) :
   Frame(h),
   d(std::make_unique<ChapterFramePrivate>())
 {
   d->tagHeader = tagHeader;
+  d->factory = factory;
   parseFields(fieldData(data));
+
+  // The factory is only needed to create the embedded frames.
+  d->factory = nullptr;
 }
@@ -230,6 +230,9 @@ namespace TagLib {
        * frame with the element ID \a eID and returns a pointer to it. This
        * can be used to link CTOC and CHAP frames together.
        *
+       * If the CHAP frames of \a tag have not been created yet, the frame is
+       * looked up in Tag::chapterIndex() and only this frame is created.
+       *
        * \see elementID()
        */
       static ChapterFrame *findByElementID(const Tag *tag, const ByteVector &eID);
@@ -239,7 +242,8 @@ namespace TagLib {
       ByteVector renderFields() const override;
 
     private:
-      ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h);
+      ChapterFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h,
+                   const FrameFactory *factory);
 
       class ChapterFramePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
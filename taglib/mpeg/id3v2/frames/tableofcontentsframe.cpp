@@ -42,6 +42,7 @@ public:
   }
 
   const ID3v2::Header *tagHeader { nullptr };
+  const FrameFactory *factory { nullptr };
   ByteVector elementID;
   bool isTopLevel { false };
   bool isOrdered { false };
@@ -247,7 +248,6 @@ void TableOfContentsFrame::parseFields(const ByteVector &data)
   }
 
   int pos = 0;
-  unsigned int embPos = 0;
   d->elementID = readStringField(data, String::Latin1, &pos).data(String::Latin1);
   d->isTopLevel = (data.at(pos) & 2) != 0;
   d->isOrdered = (data.at(pos++) & 1) != 0;
@@ -257,26 +257,10 @@ void TableOfContentsFrame::parseFields(const ByteVector &data)
     d->childElements.append(childElementID);
   }
 
-  size -= pos;
-
-  if(size < header()->size())
-    return;
-
-  while(embPos < size - header()->size()) {
-    Frame *frame = FrameFactory::instance()->createFrame(data.mid(pos + embPos), d->tagHeader);
-
-    if(!frame)
-      return;
-
-    // Checks to make sure that frame parsed correctly.
-    if(frame->size() <= 0) {
-      delete frame;
-      return;
-    }
-
-    embPos += frame->size() + header()->size();
+  const FrameList frames = createEmbeddedFrames(
+    data.mid(pos), d->tagHeader, d->factory ? d->factory : FrameFactory::instance());
+  for(const auto &frame : frames)
     addEmbeddedFrame(frame);
-  }
 }
 
 ByteVector TableOfContentsFrame::renderFields() const
@@ -305,10 +289,15 @@ ByteVector TableOfContentsFrame::renderFields() const
 }
 
 TableOfContentsFrame::TableOfContentsFrame(const ID3v2::Header *tagHeader,
-                                           const ByteVector &data, Header *h) :
+                                           const ByteVector &data, Header *h,
+                           const FrameFactory *factory) :
   Frame(h),
   d(std::make_unique<TableOfContentsFramePrivate>())
 {
   d->tagHeader = tagHeader;
+  d->factory = factory;
   parseFields(fieldData(data));
+
+  // The factory is only needed to create the embedded frames.
+  d->factory = nullptr;
 }
@@ -248,7 +248,8 @@ namespace TagLib {
       ByteVector renderFields() const override;
 
     private:
-      TableOfContentsFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h);
+      TableOfContentsFrame(const ID3v2::Header *tagHeader, const ByteVector &data, Header *h,
+                           const FrameFactory *factory);
 
       class TableOfContentsFramePrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -25,7 +25,9 @@
 
 #include "textidentificationframe.h"
 
+#include <algorithm>
 #include <array>
+#include <typeinfo>
 #include <utility>
 
 #include "tpropertymap.h"
@@ -35,6 +37,192 @@
 using namespace TagLib;
 using namespace ID3v2;
 
+namespace
+{
+  // Splits the field data of a text frame into its values and passes each
+  // value together with its encoding to valueFound.  Empty values are skipped
+  // except for the first one if keepFirstEmpty is true.
+  template <typename F>
+  void splitTextFields(const ByteVector &data, bool keepFirstEmpty, F valueFound)
+  {
+    const auto encoding = static_cast<String::Type>(data[0]);
+
+    // split the byte array into chunks based on the string type (two byte delimiter
+    // for unicode encodings)
+
+    int byteAlign = encoding == String::Latin1 || encoding == String::UTF8 ? 1 : 2;
+
+    // build a small counter to strip nulls off the end of the field
+
+    int dataLength = data.size() - 1;
+
+    while(dataLength > 0 && data[dataLength] == 0)
+      dataLength--;
+
+    while(dataLength % byteAlign != 0)
+      dataLength++;
+
+    const ByteVectorList l = ByteVectorList::split(data.mid(1, dataLength),
+                                                   ByteVector(byteAlign, '\0'), byteAlign);
+
+    // UTF-16 values without a BOM use the byte order of the first value
+
+    unsigned short firstBom = 0;
+    for(auto it = l.begin(); it != l.end(); ++it) {
+      if(it->isEmpty() && !(it == l.begin() && keepFirstEmpty))
+        continue;
+
+      String::Type textEncoding = encoding;
+      if(textEncoding == String::UTF16) {
+        if(it == l.begin()) {
+          firstBom = it->mid(0, 2).toUShort();
+        }
+        else {
+          unsigned short subsequentBom = it->mid(0, 2).toUShort();
+          if(subsequentBom != 0xfeff && subsequentBom != 0xfffe) {
+            if(firstBom == 0xfeff) {
+              textEncoding = String::UTF16BE;
+            }
+            else if(firstBom == 0xfffe) {
+              textEncoding = String::UTF16LE;
+            }
+          }
+        }
+      }
+      valueFound(*it, textEncoding);
+    }
+  }
+
+  void appendUTF8(ByteVector &v, unsigned int c)
+  {
+    if(c < 0x80) {
+      v.append(static_cast<char>(c));
+    }
+    else if(c < 0x800) {
+      v.append(static_cast<char>(0xc0 | (c >> 6)));
+      v.append(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+    else if(c < 0x10000) {
+      v.append(static_cast<char>(0xe0 | (c >> 12)));
+      v.append(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+      v.append(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+    else {
+      v.append(static_cast<char>(0xf0 | (c >> 18)));
+      v.append(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+      v.append(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+      v.append(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+  }
+
+  bool isASCII(const ByteVector &data)
+  {
+    return std::none_of(data.begin(), data.end(),
+      [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+  }
+
+  // Checks UTF-8 data with the same rules as String, i.e. overlong sequences,
+  // surrogates and code points above U+10FFFF are invalid.
+  bool isValidUTF8(const ByteVector &data)
+  {
+    const unsigned int size = data.size();
+    unsigned int i = 0;
+    while(i < size) {
+      auto c = static_cast<unsigned char>(data[i++]);
+      if(c < 0x80)
+        continue;
+
+      unsigned int codePoint;
+      unsigned int length;
+      if((c >> 5) == 0x06) {
+        codePoint = c & 0x1f;
+        length = 1;
+      }
+      else if((c >> 4) == 0x0e) {
+        codePoint = c & 0x0f;
+        length = 2;
+      }
+      else if((c >> 3) == 0x1e) {
+        codePoint = c & 0x07;
+        length = 3;
+      }
+      else {
+        return false;
+      }
+
+      if(size - i < length)
+        return false;
+      for(unsigned int j = 0; j < length; ++j) {
+        c = static_cast<unsigned char>(data[i++]);
+        if((c >> 6) != 0x02)
+          return false;
+        codePoint = (codePoint << 6) | (c & 0x3f);
+      }
+
+      static constexpr std::array<unsigned int, 4> minimum { 0, 0x80, 0x800, 0x10000 };
+      if(codePoint < minimum[length] || codePoint > 0x10ffff ||
+         (codePoint >= 0xd800 && codePoint < 0xe000))
+        return false;
+    }
+    return true;
+  }
+
+  ByteVector latin1ToUTF8(const ByteVector &data)
+  {
+    // Only a custom string handler can interpret Latin-1 data differently.
+
+    if(const Latin1StringHandler *handler = ID3v2::Tag::latin1StringHandler();
+       typeid(*handler) != typeid(Latin1StringHandler))
+      return handler->parse(data).data(String::UTF8);
+
+    if(isASCII(data))
+      return data;
+
+    ByteVector v;
+    for(char c : data)
+      appendUTF8(v, static_cast<unsigned char>(c));
+    return v;
+  }
+
+  // Converts UTF-16 data to UTF-8, invalid data results in an empty byte
+  // vector as with String.
+  ByteVector utf16ToUTF8(const ByteVector &data, String::Type encoding)
+  {
+    unsigned int pos = 0;
+    bool littleEndian = encoding == String::UTF16LE;
+    if(encoding == String::UTF16) {
+      if(data.size() < 2)
+        return ByteVector();
+      const unsigned short bom = data.toUShort(0U, true);
+      if(bom != 0xfeff && bom != 0xfffe)
+        return ByteVector();
+      littleEndian = bom == 0xfffe;
+      pos = 2;
+    }
+
+    ByteVector v;
+    const unsigned int end = pos + (data.size() - pos) / 2 * 2;
+    while(pos < end) {
+      unsigned int c = data.toUShort(pos, !littleEndian);
+      pos += 2;
+      if(c >= 0xd800 && c < 0xdc00) {
+        if(pos >= end)
+          return ByteVector();
+        const unsigned int low = data.toUShort(pos, !littleEndian);
+        pos += 2;
+        if(low < 0xdc00 || low >= 0xe000)
+          return ByteVector();
+        c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+      }
+      else if(c >= 0xdc00 && c < 0xe000) {
+        return ByteVector();
+      }
+      appendUTF8(v, c);
+    }
+    return v;
+  }
+}  // namespace
+
 class TextIdentificationFrame::TextIdentificationFramePrivate
 {
 public:
@@ -120,6 +308,33 @@ StringList TextIdentificationFrame::fieldList() const
   return d->fieldList;
 }
 
+ByteVectorList TextIdentificationFrame::fieldListUTF8() const
+{
+  ByteVectorList l;
+  for(const auto &field : std::as_const(d->fieldList))
+    l.append(field.data(String::UTF8));
+  return l;
+}
+
+ByteVectorList TextIdentificationFrame::parseUTF8Fields(const ByteVector &data,
+                                                        bool userTextFrame) // static
+{
+  ByteVectorList l;
+  if(data.size() < 2)
+    return l;
+
+  splitTextFields(data, userTextFrame,
+    [&l](const ByteVector &value, String::Type encoding) {
+      if(encoding == String::Latin1)
+        l.append(latin1ToUTF8(value));
+      else if(encoding == String::UTF8)
+        l.append(isValidUTF8(value) ? value : ByteVector());
+      else
+        l.append(utf16ToUTF8(value, encoding));
+    });
+  return l;
+}
+
 String::Type TextIdentificationFrame::textEncoding() const
 {
   return d->textEncoding;
@@ -218,56 +433,18 @@ void TextIdentificationFrame::parseFields(const ByteVector &data)
 
   d->textEncoding = static_cast<String::Type>(data[0]);
 
-  // split the byte array into chunks based on the string type (two byte delimiter
-  // for unicode encodings)
-
-  int byteAlign = d->textEncoding == String::Latin1 || d->textEncoding == String::UTF8 ? 1 : 2;
-
-  // build a small counter to strip nulls off the end of the field
-
-  int dataLength = data.size() - 1;
-
-  while(dataLength > 0 && data[dataLength] == 0)
-    dataLength--;
-
-  while(dataLength % byteAlign != 0)
-    dataLength++;
-
-  const ByteVectorList l = ByteVectorList::split(data.mid(1, dataLength), textDelimiter(d->textEncoding), byteAlign);
-
   d->fieldList.clear();
 
-  // append those split values to the list and make sure that the new string's
+  // append the split values to the list and make sure that the new string's
   // type is the same specified for this frame
 
-  unsigned short firstBom = 0;
-  for(auto it = l.begin(); it != l.end(); ++it) {
-    if(!it->isEmpty() || (it == l.begin() && frameID() == "TXXX")) {
-      if(d->textEncoding == String::Latin1) {
-        d->fieldList.append(Tag::latin1StringHandler()->parse(*it));
-      }
-      else {
-        String::Type textEncoding = d->textEncoding;
-        if(textEncoding == String::UTF16) {
-          if(it == l.begin()) {
-            firstBom = it->mid(0, 2).toUShort();
-          }
-          else {
-            unsigned short subsequentBom = it->mid(0, 2).toUShort();
-            if(subsequentBom != 0xfeff && subsequentBom != 0xfffe) {
-              if(firstBom == 0xfeff) {
-                textEncoding = String::UTF16BE;
-              }
-              else if(firstBom == 0xfffe) {
-                textEncoding = String::UTF16LE;
-              }
-            }
-          }
-        }
-        d->fieldList.append(String(*it, textEncoding));
-      }
-    }
-  }
+  splitTextFields(data, frameID() == "TXXX",
+    [this](const ByteVector &value, String::Type encoding) {
+      if(encoding == String::Latin1)
+        d->fieldList.append(Tag::latin1StringHandler()->parse(value));
+      else
+        d->fieldList.append(String(value, encoding));
+    });
 }
 
 ByteVector TextIdentificationFrame::renderFields() const
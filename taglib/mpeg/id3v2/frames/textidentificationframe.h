@@ -192,6 +192,30 @@ namespace TagLib {
        */
       StringList fieldList() const;
 
+      /*!
+       * Returns the strings in this frame as UTF-8 encoded byte vectors.
+       *
+       * \see fieldList()
+       * \see parseUTF8Fields()
+       */
+      ByteVectorList fieldListUTF8() const;
+
+      /*!
+       * Decodes the field data \a data of a text identification frame, i.e.
+       * the encoding byte followed by the null separated strings, directly to
+       * UTF-8 encoded byte vectors without creating a frame or String objects.
+       * The values are the same as the ones returned by fieldList() for a
+       * frame parsed from \a data.  If \a userTextFrame is \c true, an empty
+       * first value is kept as the description of a TXXX frame.
+       *
+       * Latin-1 values which only contain ASCII characters and valid UTF-8
+       * values share the memory of \a data.
+       *
+       * \see ID3v2::Tag::textFrameUTF8Values()
+       */
+      static ByteVectorList parseUTF8Fields(const ByteVector &data,
+                                            bool userTextFrame = false);
+
       /*!
        * Returns a KeyConversionMap mapping a role as it would be  used in a PropertyMap
        * to the corresponding key used in a TIPL ID3 frame to describe that role.
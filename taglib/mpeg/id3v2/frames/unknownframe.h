@@ -49,6 +49,7 @@ namespace TagLib {
     class TAGLIB_EXPORT UnknownFrame : public Frame
     {
       friend class FrameFactory;
+      friend class SelectiveFrameFactory;
 
     public:
       UnknownFrame(const ByteVector &data);
@@ -0,0 +1,180 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "id3v2chapterindex.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace TagLib;
+using namespace ID3v2;
+
+class ChapterIndex::ChapterIndexPrivate
+{
+public:
+  void walk(const TableOfContents &toc, ByteVectorList &order,
+            ByteVectorList &visited) const;
+
+  std::vector<Chapter> chapters;
+
+  // The maximum end time of the chapters up to each index, so that chapters
+  // containing other chapters are found.
+  std::vector<unsigned int> maxEndTimes;
+
+  // Indexes into chapters sorted by element ID.
+  std::vector<unsigned int> elementIndex;
+
+  std::vector<TableOfContents> tablesOfContents;
+};
+
+void ChapterIndex::ChapterIndexPrivate::walk(const TableOfContents &toc,
+                                             ByteVectorList &order,
+                                             ByteVectorList &visited) const
+{
+  // Tables of contents referring to each other would loop forever.
+
+  if(visited.contains(toc.elementID))
+    return;
+  visited.append(toc.elementID);
+
+  for(const auto &child : toc.childElements) {
+    auto it = std::find_if(tablesOfContents.cbegin(), tablesOfContents.cend(),
+      [&child](const TableOfContents &t) { return t.elementID == child; });
+    if(it != tablesOfContents.cend())
+      walk(*it, order, visited);
+    else
+      order.append(child);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+ChapterIndex::ChapterIndex() :
+  d(std::make_shared<ChapterIndexPrivate>())
+{
+}
+
+ChapterIndex::ChapterIndex(const List<Chapter> &chapters,
+                           const List<TableOfContents> &tablesOfContents) :
+  d(std::make_shared<ChapterIndexPrivate>())
+{
+  d->chapters.assign(chapters.begin(), chapters.end());
+  std::stable_sort(d->chapters.begin(), d->chapters.end(),
+    [](const Chapter &a, const Chapter &b) { return a.startTime < b.startTime; });
+
+  d->maxEndTimes.resize(d->chapters.size());
+  unsigned int maxEndTime = 0;
+  for(unsigned int i = 0; i < d->chapters.size(); ++i) {
+    maxEndTime = std::max(maxEndTime, d->chapters[i].endTime);
+    d->maxEndTimes[i] = maxEndTime;
+  }
+
+  d->elementIndex.resize(d->chapters.size());
+  for(unsigned int i = 0; i < d->elementIndex.size(); ++i)
+    d->elementIndex[i] = i;
+  std::sort(d->elementIndex.begin(), d->elementIndex.end(),
+    [this](unsigned int a, unsigned int b) {
+      return d->chapters[a].elementID < d->chapters[b].elementID;
+    });
+
+  d->tablesOfContents.assign(tablesOfContents.begin(), tablesOfContents.end());
+}
+
+ChapterIndex::ChapterIndex(const ChapterIndex &) = default;
+ChapterIndex::~ChapterIndex() = default;
+ChapterIndex &ChapterIndex::operator=(const ChapterIndex &) = default;
+
+bool ChapterIndex::isEmpty() const
+{
+  return d->chapters.empty() && d->tablesOfContents.empty();
+}
+
+unsigned int ChapterIndex::size() const
+{
+  return static_cast<unsigned int>(d->chapters.size());
+}
+
+const ChapterIndex::Chapter &ChapterIndex::chapter(unsigned int index) const
+{
+  return d->chapters[index];
+}
+
+List<ChapterIndex::Chapter> ChapterIndex::chapters() const
+{
+  List<Chapter> chapters;
+  for(const auto &chapter : d->chapters)
+    chapters.append(chapter);
+  return chapters;
+}
+
+int ChapterIndex::find(const ByteVector &elementID) const
+{
+  auto it = std::lower_bound(d->elementIndex.cbegin(), d->elementIndex.cend(), elementID,
+    [this](unsigned int index, const ByteVector &id) {
+      return d->chapters[index].elementID < id;
+    });
+  if(it != d->elementIndex.cend() && d->chapters[*it].elementID == elementID)
+    return static_cast<int>(*it);
+  return -1;
+}
+
+int ChapterIndex::chapterAt(unsigned int time) const
+{
+  auto it = std::upper_bound(d->chapters.cbegin(), d->chapters.cend(), time,
+    [](unsigned int t, const Chapter &chapter) { return t < chapter.startTime; });
+  // Walk back from the last chapter starting at or before time as long as
+  // an earlier chapter may still end after time.
+
+  for(auto i = it - d->chapters.cbegin(); i > 0 && d->maxEndTimes[i - 1] > time; --i) {
+    if(d->chapters[i - 1].endTime > time)
+      return static_cast<int>(i - 1);
+  }
+  return -1;
+}
+
+List<ChapterIndex::TableOfContents> ChapterIndex::tablesOfContents() const
+{
+  List<TableOfContents> tablesOfContents;
+  for(const auto &toc : d->tablesOfContents)
+    tablesOfContents.append(toc);
+  return tablesOfContents;
+}
+
+ByteVectorList ChapterIndex::chapterOrder(const ByteVector &elementID) const
+{
+  auto it = std::find_if(d->tablesOfContents.cbegin(), d->tablesOfContents.cend(),
+    [&elementID](const TableOfContents &toc) {
+      return elementID.isEmpty() ? toc.isTopLevel : toc.elementID == elementID;
+    });
+
+  ByteVectorList order;
+  if(it != d->tablesOfContents.cend()) {
+    ByteVectorList visited;
+    d->walk(*it, order, visited);
+  }
+  return order;
+}
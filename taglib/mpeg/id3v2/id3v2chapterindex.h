@@ -0,0 +1,160 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_ID3V2CHAPTERINDEX_H
+#define TAGLIB_ID3V2CHAPTERINDEX_H
+
+#include <memory>
+
+#include "tbytevector.h"
+#include "tbytevectorlist.h"
+#include "tlist.h"
+#include "taglib_export.h"
+
+namespace TagLib {
+
+  namespace ID3v2 {
+
+    //! An index of the chapters of an ID3v2 tag
+
+    /*!
+     * This contains the element IDs, times and offsets of the chapters (CHAP
+     * frames) and the structure of the tables of contents (CTOC frames) of a
+     * tag.  The chapters are sorted by their start times, so that the chapter
+     * at a point in time is found with a binary search.
+     *
+     * When a tag is read, the index is built from the frame data without
+     * creating the frames, so it is cheap even for tags with thousands of
+     * chapters.
+     *
+     * \see Tag::chapterIndex()
+     */
+    class TAGLIB_EXPORT ChapterIndex
+    {
+    public:
+      /*!
+       * A chapter as stored in a CHAP frame.
+       */
+      struct Chapter {
+        ByteVector elementID;
+        unsigned int startTime;
+        unsigned int endTime;
+        unsigned int startOffset;
+        unsigned int endOffset;
+      };
+
+      /*!
+       * A table of contents as stored in a CTOC frame.
+       */
+      struct TableOfContents {
+        ByteVector elementID;
+        bool isTopLevel;
+        bool isOrdered;
+        ByteVectorList childElements;
+      };
+
+      /*!
+       * Constructs an empty chapter index.
+       */
+      ChapterIndex();
+
+      /*!
+       * Constructs a chapter index for \a chapters and \a tablesOfContents.
+       */
+      ChapterIndex(const List<Chapter> &chapters,
+                   const List<TableOfContents> &tablesOfContents);
+
+      /*!
+       * Makes a shallow copy of \a other.
+       */
+      ChapterIndex(const ChapterIndex &other);
+
+      /*!
+       * Destroys this ChapterIndex instance.
+       */
+      ~ChapterIndex();
+
+      /*!
+       * Makes a shallow copy of \a other.
+       */
+      ChapterIndex &operator=(const ChapterIndex &other);
+
+      /*!
+       * Returns \c true if there are no chapters and no tables of contents.
+       */
+      bool isEmpty() const;
+
+      /*!
+       * Returns the number of chapters.
+       */
+      unsigned int size() const;
+
+      /*!
+       * Returns the chapter at \a index, the chapters are sorted by their
+       * start times.  \a index must be less than size().
+       */
+      const Chapter &chapter(unsigned int index) const;
+
+      /*!
+       * Returns all chapters sorted by their start times.
+       */
+      List<Chapter> chapters() const;
+
+      /*!
+       * Returns the index of the chapter with the element ID \a elementID or -1
+       * if there is no such chapter.
+       */
+      int find(const ByteVector &elementID) const;
+
+      /*!
+       * Returns the index of the chapter containing \a time (in milliseconds),
+       * i.e. the last chapter starting at or before \a time which ends after
+       * \a time, or -1 if there is no such chapter.
+       */
+      int chapterAt(unsigned int time) const;
+
+      /*!
+       * Returns the tables of contents.
+       */
+      List<TableOfContents> tablesOfContents() const;
+
+      /*!
+       * Returns the element IDs of the chapters in the order given by the
+       * table of contents with the element ID \a elementID, walking nested
+       * tables of contents depth first.  If \a elementID is empty, the top
+       * level table of contents is used.  If there is no such table of
+       * contents, an empty list is returned.
+       */
+      ByteVectorList chapterOrder(const ByteVector &elementID = ByteVector()) const;
+
+    private:
+      class ChapterIndexPrivate;
+      TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+      std::shared_ptr<ChapterIndexPrivate> d;
+    };
+  }  // namespace ID3v2
+}  // namespace TagLib
+
+#endif
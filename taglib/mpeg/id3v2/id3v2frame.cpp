@@ -34,6 +34,7 @@
 #include "tpropertymap.h"
 #include "id3v2tag.h"
 #include "id3v2synchdata.h"
+#include "id3v2framefactory.h"
 #include "frames/textidentificationframe.h"
 #include "frames/unknownframe.h"
 
@@ -125,9 +126,30 @@ StringList Frame::toStringList() const
 ByteVector Frame::render() const
 {
   ByteVector fieldData = renderFields();
+
+  // Compress the frame if requested and worthwhile, the decompressed size is
+  // stored in front of the compressed data (structure 3.3.1.i, 4.1.2.k).
+
+  bool compressed = false;
+  if(d->header->compression() && !d->header->encryption() &&
+     fieldData.size() >= Header::CompressionThreshold) {
+    const ByteVector compressedData = zlib::compress(fieldData);
+    if(!compressedData.isEmpty() && compressedData.size() + 4 < fieldData.size()) {
+      fieldData = (d->header->version() < 4
+        ? ByteVector::fromUInt(fieldData.size())
+        : SynchData::fromUInt(fieldData.size())) + compressedData;
+      compressed = true;
+    }
+  }
+
   d->header->setFrameSize(fieldData.size());
   ByteVector headerData = d->header->render();
 
+  if(compressed) {
+    // ID3v2.4 requires the data length indicator for compressed frames.
+    headerData[9] = static_cast<char>(d->header->version() < 4 ? 0x80 : 0x09);
+  }
+
   return headerData + fieldData;
 }
 
@@ -292,7 +314,11 @@ ByteVector Frame::fieldData(const ByteVector &frameData) const
   unsigned int frameDataLength = size();
 
   if(d->header->compression() || d->header->dataLengthIndicator()) {
-    frameDataLength = SynchData::toUInt(frameData.mid(headerSize, 4));
+    // ID3v2.3 stores the decompressed size as a plain integer, ID3v2.4 the
+    // data length indicator as a synch safe integer.
+    frameDataLength = d->header->version() < 4
+      ? frameData.toUInt(headerSize, true)
+      : SynchData::toUInt(frameData.mid(headerSize, 4));
     frameDataOffset += 4;
   }
 
@@ -302,7 +328,8 @@ ByteVector Frame::fieldData(const ByteVector &frameData) const
       return ByteVector();
     }
 
-    const ByteVector outData = zlib::decompress(frameData.mid(frameDataOffset));
+    const ByteVector outData =
+      zlib::decompress(frameData.mid(frameDataOffset), frameDataLength);
     if(!outData.isEmpty() && frameDataLength != outData.size()) {
       debug("frameDataLength does not match the data length returned by zlib");
     }
@@ -338,6 +365,37 @@ String Frame::readStringField(const ByteVector &data, String::Type encoding, int
   return str;
 }
 
+List<Frame *> Frame::createEmbeddedFrames(const ByteVector &data,
+                                          const ID3v2::Header *tagHeader,
+                                          const FrameFactory *factory) const
+{
+  List<Frame *> frames;
+
+  const unsigned int size = data.size();
+  const unsigned int headerSize = header()->size();
+  if(size < headerSize)
+    return frames;
+
+  unsigned int pos = 0;
+  while(pos < size - headerSize) {
+    Frame *frame = factory->createFrame(data.mid(pos), tagHeader);
+
+    if(!frame)
+      break;
+
+    // Checks to make sure that frame parsed correctly.
+    if(frame->size() <= 0) {
+      delete frame;
+      break;
+    }
+
+    pos += frame->size() + headerSize;
+    frames.append(frame);
+  }
+
+  return frames;
+}
+
 String::Type Frame::checkTextEncoding(const StringList &fields, String::Type encoding) const
 {
   if((encoding == String::UTF8 || encoding == String::UTF16BE) && header()->version() != 4)
@@ -629,6 +687,11 @@ bool Frame::Header::compression() const
   return d->compression;
 }
 
+void Frame::Header::setCompression(bool compression)
+{
+  d->compression = compression;
+}
+
 bool Frame::Header::encryption() const
 {
   return d->encryption;
@@ -28,6 +28,7 @@
 
 #include "tstring.h"
 #include "tbytevector.h"
+#include "tlist.h"
 #include "taglib_export.h"
 
 namespace TagLib {
@@ -38,6 +39,7 @@ namespace TagLib {
   namespace ID3v2 {
 
     class Tag;
+    class Header;
     class FrameFactory;
 
     //! ID3v2 frame implementation
@@ -242,6 +244,17 @@ namespace TagLib {
       String::Type checkTextEncoding(const StringList &fields,
                                      String::Type encoding) const;
 
+      /*!
+       * Creates the frames embedded in \a data, e.g. the sub-frames following
+       * the fields of CHAP and CTOC frames, using \a factory for a tag with the
+       * header \a tagHeader.  Frames are created until the end of \a data or
+       * the first frame which cannot be parsed.  The caller takes ownership
+       * of the returned frames.
+       */
+      List<Frame *> createEmbeddedFrames(const ByteVector &data,
+                                         const ID3v2::Header *tagHeader,
+                                         const FrameFactory *factory) const;
+
 
       /*!
        * Parses the contents of this frame as PropertyMap. If that fails, the returned
@@ -292,6 +305,14 @@ namespace TagLib {
     class TAGLIB_EXPORT Frame::Header
     {
     public:
+      /*!
+       * Frames with compression enabled are only compressed when rendered if
+       * their data has at least this size.
+       *
+       * \see setCompression()
+       */
+      static constexpr unsigned int CompressionThreshold = 1024;
+
       /*!
        * Construct a Frame Header based on \a data.  \a data must at least
        * contain a 4 byte frame ID, and optionally can contain flag data and the
@@ -408,12 +429,24 @@ namespace TagLib {
       bool groupingIdentity() const;
 
       /*!
-       * Returns \c true if compression is enabled for this frame.
+       * Returns \c true if compression is enabled for this frame.  The data of
+       * compressed frames is decompressed when they are read.
        *
-       * \note This flag is currently ignored internally in TagLib.
+       * \see setCompression()
        */
       bool compression() const;
 
+      /*!
+       * Enables or disables compression of this frame when it is rendered.
+       * The frame is only compressed if zlib is available, its data has at
+       * least CompressionThreshold bytes and compression makes it smaller,
+       * otherwise it is rendered uncompressed.  This is useful for large
+       * frames with compressible data, e.g. synchronized lyrics.
+       *
+       * \see compression()
+       */
+      void setCompression(bool compression);
+
       /*!
        * Returns \c true if encryption is enabled for this frame.
        *
@@ -86,6 +86,167 @@ namespace
 
     frame->setText(newfields);
   }
+
+  // Returns the frame ID packed into an integer, the IDs of ID3v2.2 frames
+  // are padded with a zero byte.
+
+  constexpr unsigned int frameKey(const char *frameID)
+  {
+    unsigned int key = 0;
+    for(int i = 0; i < 4; ++i) {
+      key <<= 8;
+      if(*frameID)
+        key |= static_cast<unsigned char>(*frameID++);
+    }
+    return key;
+  }
+
+  unsigned int frameKey(const ByteVector &frameID)
+  {
+    if(frameID.size() < 3 || frameID.size() > 4)
+      return 0;
+
+    unsigned int key = 0;
+    for(unsigned int i = 0; i < 4; ++i) {
+      key <<= 8;
+      if(i < frameID.size())
+        key |= static_cast<unsigned char>(frameID[i]);
+    }
+    return key;
+  }
+
+  // A map from frame IDs to values which is built at compile time.  The
+  // multiplier of the hash function is searched so that all frame IDs are
+  // mapped to different slots, a lookup needs a single comparison.
+
+  template <typename T, size_t N>
+  class FrameIDMap
+  {
+  public:
+    constexpr explicit FrameIDMap(const std::array<std::pair<const char *, T>, N> &entries)
+    {
+      static_assert(N < 255, "Too many entries for a frame ID map");
+
+      for(size_t i = 0; i < N; ++i) {
+        keys[i] = frameKey(entries[i].first);
+        values[i] = entries[i].second;
+      }
+      while(!fillSlots())
+        multiplier += 2;
+    }
+
+    const T *find(const ByteVector &frameID) const
+    {
+      const unsigned int key = frameKey(frameID);
+      const unsigned char index = slots[slot(key)];
+      return index != 0 && keys[index - 1] == key ? &values[index - 1] : nullptr;
+    }
+
+  private:
+    static constexpr unsigned int slotBits()
+    {
+      unsigned int bits = 1;
+      while((1U << bits) < 8 * N)
+        ++bits;
+      return bits;
+    }
+
+    static constexpr unsigned int SlotCount = 1U << slotBits();
+
+    constexpr unsigned int slot(unsigned int key) const
+    {
+      return (key * multiplier) >> (32 - slotBits());
+    }
+
+    constexpr bool fillSlots()
+    {
+      for(unsigned int i = 0; i < SlotCount; ++i)
+        slots[i] = 0;
+
+      for(size_t i = 0; i < N; ++i) {
+        unsigned char &index = slots[slot(keys[i])];
+        if(index != 0)
+          return false;
+        index = static_cast<unsigned char>(i + 1);
+      }
+      return true;
+    }
+
+    unsigned int multiplier { 0x9E3779B1U };
+    std::array<unsigned int, N> keys {};
+    std::array<T, N> values {};
+    std::array<unsigned char, SlotCount> slots {};
+  };
+
+  // The frame classes created by FrameFactory::createFrame().
+
+  enum class FrameClass {
+    Text,
+    Genre,
+    UserText,
+    Comments,
+    AttachedPicture,
+    AttachedPictureV22,
+    RelativeVolume,
+    UniqueFileIdentifier,
+    GeneralEncapsulatedObject,
+    UrlLink,
+    UserUrlLink,
+    UnsynchronizedLyrics,
+    SynchronizedLyrics,
+    EventTimingCodes,
+    Popularimeter,
+    Private,
+    Ownership,
+    Chapter,
+    TableOfContents,
+    Podcast,
+    Unknown
+  };
+
+  constexpr FrameIDMap frameClasses(std::array {
+    // Text Identification (frames 4.2), TCON needs to be converted.
+    std::pair("TCON", FrameClass::Genre),
+    std::pair("TXXX", FrameClass::UserText),
+    // Apple proprietary WFED (Podcast URL), MVNM (Movement Name), MVIN
+    // (Movement Number), GRP1 (Grouping) are in fact text frames.
+    std::pair("WFED", FrameClass::Text),
+    std::pair("MVNM", FrameClass::Text),
+    std::pair("MVIN", FrameClass::Text),
+    std::pair("GRP1", FrameClass::Text),
+    // Comments (frames 4.10)
+    std::pair("COMM", FrameClass::Comments),
+    // Attached Picture (frames 4.14)
+    std::pair("APIC", FrameClass::AttachedPicture),
+    // ID3v2.2 Attached Picture
+    std::pair("PIC", FrameClass::AttachedPictureV22),
+    // Relative Volume Adjustment (frames 4.11)
+    std::pair("RVA2", FrameClass::RelativeVolume),
+    // Unique File Identifier (frames 4.1)
+    std::pair("UFID", FrameClass::UniqueFileIdentifier),
+    // General Encapsulated Object (frames 4.15)
+    std::pair("GEOB", FrameClass::GeneralEncapsulatedObject),
+    // URL link (frames 4.3)
+    std::pair("WXXX", FrameClass::UserUrlLink),
+    // Unsynchronized lyric/text transcription (frames 4.8)
+    std::pair("USLT", FrameClass::UnsynchronizedLyrics),
+    // Synchronized lyrics/text (frames 4.9)
+    std::pair("SYLT", FrameClass::SynchronizedLyrics),
+    // Event timing codes (frames 4.5)
+    std::pair("ETCO", FrameClass::EventTimingCodes),
+    // Popularimeter (frames 4.17)
+    std::pair("POPM", FrameClass::Popularimeter),
+    // Private (frames 4.27)
+    std::pair("PRIV", FrameClass::Private),
+    // Ownership (frames 4.22)
+    std::pair("OWNE", FrameClass::Ownership),
+    // Chapter (ID3v2 chapters 1.0)
+    std::pair("CHAP", FrameClass::Chapter),
+    // Table of contents (ID3v2 chapters 1.0)
+    std::pair("CTOC", FrameClass::TableOfContents),
+    // Apple proprietary PCST (Podcast)
+    std::pair("PCST", FrameClass::Podcast),
+  });
 }  // namespace
 
 class FrameFactory::FrameFactoryPrivate
@@ -151,7 +312,7 @@ std::pair<Frame::Header *, bool> FrameFactory::prepareFrameHeader(
     // Data lengths are not part of the encoded data, but since they are synch-safe
     // integers they will be never actually encoded.
     ByteVector frameData = data.mid(header->size(), header->frameSize());
-    frameData = SynchData::decode(frameData);
+    SynchData::decodeInPlace(frameData);
     data = data.mid(0, header->size()) + frameData;
   }
 
@@ -190,138 +351,107 @@ Frame *FrameFactory::createFrame(const ByteVector &origData,
 
 Frame *FrameFactory::createFrame(const ByteVector &data, Frame::Header *header,
                                  const Header *tagHeader) const {
-  ByteVector frameID = header->frameID();
-
-  // This is where things get necessarily nasty.  Here we determine which
-  // Frame subclass (or if none is found simply a Frame) based
-  // on the frame ID.  Since there are a lot of possibilities, that means
-  // a lot of if blocks.
-
-  // Text Identification (frames 4.2)
-
-  // Apple proprietary WFED (Podcast URL), MVNM (Movement Name), MVIN (Movement Number), GRP1 (Grouping) are in fact text frames.
-  if(frameID.startsWith("T") || frameID == "WFED" || frameID == "MVNM" || frameID == "MVIN" || frameID == "GRP1") {
+  const ByteVector frameID = header->frameID();
 
-    TextIdentificationFrame *f = frameID != "TXXX"
+  // Determine the Frame subclass from the frame ID.  Frames which are not in
+  // the map are text frames if their ID starts with "T" and URL link frames
+  // if it starts with "W", otherwise they are unknown frames.
+
+  FrameClass frameClass = FrameClass::Unknown;
+  if(const FrameClass *c = frameClasses.find(frameID))
+    frameClass = *c;
+  else if(frameID.startsWith("T"))
+    frameClass = FrameClass::Text;
+  else if(frameID.startsWith("W"))
+    frameClass = FrameClass::UrlLink;
+
+  switch(frameClass) {
+  case FrameClass::Text:
+  case FrameClass::Genre:
+  case FrameClass::UserText:
+  {
+    TextIdentificationFrame *f = frameClass != FrameClass::UserText
       ? new TextIdentificationFrame(data, header)
       : new UserTextIdentificationFrame(data, header);
 
     d->setTextEncoding(f);
 
-    if(frameID == "TCON")
+    if(frameClass == FrameClass::Genre)
       updateGenre(f);
 
     return f;
   }
-
-  // Comments (frames 4.10)
-
-  if(frameID == "COMM") {
+  case FrameClass::Comments:
+  {
     auto f = new CommentsFrame(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // Attached Picture (frames 4.14)
-
-  if(frameID == "APIC") {
+  case FrameClass::AttachedPicture:
+  {
     auto f = new AttachedPictureFrame(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // ID3v2.2 Attached Picture
-
-  if(frameID == "PIC") {
+  case FrameClass::AttachedPictureV22:
+  {
     AttachedPictureFrame *f = new AttachedPictureFrameV22(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // Relative Volume Adjustment (frames 4.11)
-
-  if(frameID == "RVA2")
+  case FrameClass::RelativeVolume:
     return new RelativeVolumeFrame(data, header);
-
-  // Unique File Identifier (frames 4.1)
-
-  if(frameID == "UFID")
+  case FrameClass::UniqueFileIdentifier:
     return new UniqueFileIdentifierFrame(data, header);
-
-  // General Encapsulated Object (frames 4.15)
-
-  if(frameID == "GEOB") {
+  case FrameClass::GeneralEncapsulatedObject:
+  {
     auto f = new GeneralEncapsulatedObjectFrame(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // URL link (frames 4.3)
-
-  if(frameID.startsWith("W")) {
-    if(frameID != "WXXX") {
-      return new UrlLinkFrame(data, header);
-    }
+  case FrameClass::UrlLink:
+    return new UrlLinkFrame(data, header);
+  case FrameClass::UserUrlLink:
+  {
     auto f = new UserUrlLinkFrame(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // Unsynchronized lyric/text transcription (frames 4.8)
-
-  if(frameID == "USLT") {
+  case FrameClass::UnsynchronizedLyrics:
+  {
     auto f = new UnsynchronizedLyricsFrame(data, header);
     if(d->useDefaultEncoding)
       f->setTextEncoding(d->defaultEncoding);
     return f;
   }
-
-  // Synchronized lyrics/text (frames 4.9)
-
-  if(frameID == "SYLT") {
+  case FrameClass::SynchronizedLyrics:
+  {
     auto f = new SynchronizedLyricsFrame(data, header);
     if(d->useDefaultEncoding)
       f->setTextEncoding(d->defaultEncoding);
     return f;
   }
-
-  // Event timing codes (frames 4.5)
-
-  if(frameID == "ETCO")
+  case FrameClass::EventTimingCodes:
     return new EventTimingCodesFrame(data, header);
-
-  // Popularimeter (frames 4.17)
-
-  if(frameID == "POPM")
+  case FrameClass::Popularimeter:
     return new PopularimeterFrame(data, header);
-
-  // Private (frames 4.27)
-
-  if(frameID == "PRIV")
+  case FrameClass::Private:
     return new PrivateFrame(data, header);
-
-  // Ownership (frames 4.22)
-
-  if(frameID == "OWNE") {
+  case FrameClass::Ownership:
+  {
     auto f = new OwnershipFrame(data, header);
     d->setTextEncoding(f);
     return f;
   }
-
-  // Chapter (ID3v2 chapters 1.0)
-
-  if(frameID == "CHAP")
-    return new ChapterFrame(tagHeader, data, header);
-
-  // Table of contents (ID3v2 chapters 1.0)
-
-  if(frameID == "CTOC")
-    return new TableOfContentsFrame(tagHeader, data, header);
-
-  // Apple proprietary PCST (Podcast)
-
-  if(frameID == "PCST")
+  case FrameClass::Chapter:
+    return new ChapterFrame(tagHeader, data, header, this);
+  case FrameClass::TableOfContents:
+    return new TableOfContentsFrame(tagHeader, data, header, this);
+  case FrameClass::Podcast:
     return new PodcastFrame(data, header);
+  case FrameClass::Unknown:
+    break;
+  }
 
   return new UnknownFrame(data, header);
 }
@@ -388,8 +518,22 @@ FrameFactory::~FrameFactory() = default;
 
 namespace
 {
+  // Marks a frame which is not supported by ID3v2.4 in a conversion table.
+  constexpr std::pair<const char *, const char *> discarded(const char *frameID)
+  {
+    return {frameID, nullptr};
+  }
+
   // Frame conversion table ID3v2.2 -> 2.4
-  constexpr std::array frameConversion2 {
+  constexpr FrameIDMap frameConversion2(std::array {
+    discarded("CRM"),
+    discarded("EQU"),
+    discarded("LNK"),
+    discarded("RVA"),
+    discarded("TIM"),
+    discarded("TSI"),
+    discarded("TDA"),
+
     std::pair("BUF", "RBUF"),
     std::pair("CNT", "PCNT"),
     std::pair("COM", "COMM"),
@@ -462,14 +606,21 @@ namespace
     std::pair("MVN", "MVNM"),
     std::pair("MVI", "MVIN"),
     std::pair("GP1", "GRP1"),
-  };
+  });
 
   // Frame conversion table ID3v2.3 -> 2.4
-  constexpr std::array frameConversion3 {
+  constexpr FrameIDMap frameConversion3(std::array {
+    discarded("EQUA"),
+    discarded("RVAD"),
+    discarded("TIME"),
+    discarded("TRDA"),
+    discarded("TSIZ"),
+    discarded("TDAT"),
+
     std::pair("TORY", "TDOR"),
     std::pair("TYER", "TDRC"),
     std::pair("IPLS", "TIPL"),
-  };
+  });
 }  // namespace
 
 bool FrameFactory::updateFrame(Frame::Header *header) const
@@ -479,52 +630,20 @@ bool FrameFactory::updateFrame(Frame::Header *header) const
   switch(header->version()) {
 
   case 2: // ID3v2.2
+  case 3: // ID3v2.3
   {
-    if(frameID == "CRM" ||
-       frameID == "EQU" ||
-       frameID == "LNK" ||
-       frameID == "RVA" ||
-       frameID == "TIM" ||
-       frameID == "TSI" ||
-       frameID == "TDA")
-    {
-      debug("ID3v2.4 no longer supports the frame type " + String(frameID) +
-            ".  It will be discarded from the tag.");
-      return false;
-    }
-
     // ID3v2.2 only used 3 bytes for the frame ID, so we need to convert all
     // the frames to their 4 byte ID3v2.4 equivalent.
 
-    for(const auto &[o, t] : frameConversion2) {
-      if(frameID == o) {
-        header->setFrameID(t);
-        break;
-      }
-    }
-
-    break;
-  }
-
-  case 3: // ID3v2.3
-  {
-    if(frameID == "EQUA" ||
-       frameID == "RVAD" ||
-       frameID == "TIME" ||
-       frameID == "TRDA" ||
-       frameID == "TSIZ" ||
-       frameID == "TDAT")
-    {
-      debug("ID3v2.4 no longer supports the frame type " + String(frameID) +
-            ".  It will be discarded from the tag.");
-      return false;
-    }
-
-    for(const auto &[o, t] : frameConversion3) {
-      if(frameID == o) {
-        header->setFrameID(t);
-        break;
+    const auto target = header->version() == 2
+      ? frameConversion2.find(frameID) : frameConversion3.find(frameID);
+    if(target) {
+      if(!*target) {
+        debug("ID3v2.4 no longer supports the frame type " + String(frameID) +
+              ".  It will be discarded from the tag.");
+        return false;
       }
+      header->setFrameID(*target);
     }
 
     break;
@@ -593,3 +712,77 @@ Frame *FrameFactory::createFrameForProperty(const String &key, const StringList
   return new UserTextIdentificationFrame(
     UserTextIdentificationFrame::keyToTXXX(key), values, String::UTF8);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// SelectiveFrameFactory
+////////////////////////////////////////////////////////////////////////////////
+
+class SelectiveFrameFactory::SelectiveFrameFactoryPrivate
+{
+public:
+  bool containsKeyOrPrefix(const String &key, const String &prefix) const
+  {
+    return std::any_of(keys.begin(), keys.end(),
+      [&key, &prefix](const String &k) { return k == key || k.startsWith(prefix); });
+  }
+
+  StringList keys;
+};
+
+SelectiveFrameFactory::SelectiveFrameFactory(const StringList &keys) :
+  d(std::make_unique<SelectiveFrameFactoryPrivate>())
+{
+  for(const auto &key : keys)
+    d->keys.append(key.upper());
+}
+
+SelectiveFrameFactory::~SelectiveFrameFactory() = default;
+
+StringList SelectiveFrameFactory::propertyKeys() const
+{
+  return d->keys;
+}
+
+bool SelectiveFrameFactory::isFrameWanted(const ByteVector &frameID) const
+{
+  // The keys of these frames depend on their contents.
+
+  if(frameID == "TXXX" || frameID == "TIPL" || frameID == "TMCL")
+    return true;
+
+  // TDAT and TIME of ID3v2.3 tags are merged into TDRC.
+
+  if(frameID == "TDAT" || frameID == "TIME")
+    return d->keys.contains("DATE");
+  if(frameID == "APIC")
+    return d->keys.contains("PICTURE");
+  if(frameID == "GEOB")
+    return d->keys.contains("GENERALOBJECT");
+  if(frameID == "COMM")
+    return d->containsKeyOrPrefix("COMMENT", Frame::commentPrefix);
+  if(frameID == "USLT")
+    return d->containsKeyOrPrefix("LYRICS", Frame::lyricsPrefix);
+  if(frameID == "WXXX")
+    return d->containsKeyOrPrefix("URL", Frame::urlPrefix);
+  if(frameID == "UFID")
+    return d->keys.contains("MUSICBRAINZ_TRACKID");
+
+  // All other frames not contained in the key mapping, e.g. SYLT, CHAP,
+  // CTOC, POPM and PRIV, only provide unsupported data.
+
+  const String key = Frame::frameIDToKey(frameID);
+  return !key.isEmpty() && d->keys.contains(key);
+}
+
+Frame *SelectiveFrameFactory::createFrame(const ByteVector &data, Frame::Header *header,
+                                          const Header *tagHeader) const
+{
+  // Frames which still have an ID3v2.2 ID after updateFrame(), i.e. PIC,
+  // are converted to ID3v2.4 by their frame class.  As unknown frames, they
+  // would be discarded when the tag is rendered, so they are always created.
+
+  if(header->frameID().size() == 4 && !isFrameWanted(header->frameID()))
+    return new UnknownFrame(data, header);
+
+  return FrameFactory::createFrame(data, header, tagHeader);
+}
@@ -66,6 +66,8 @@ namespace TagLib {
 
     class TAGLIB_EXPORT FrameFactory
     {
+      friend class Tag;
+
     public:
       FrameFactory(const FrameFactory &) = delete;
       FrameFactory &operator=(const FrameFactory &) = delete;
@@ -183,6 +185,69 @@ namespace TagLib {
       std::unique_ptr<FrameFactoryPrivate> d;
     };
 
+    //! A frame factory which only decodes the frames needed for some properties
+
+    /*!
+     * This factory can be passed to the constructors of files with ID3v2 tags
+     * if only some properties are needed, e.g. for a listing view.  Frames
+     * which cannot contribute to the properties given in the constructor are
+     * not decoded, they are kept as UnknownFrame objects with their raw data.
+     * This avoids building expensive frames such as attached pictures,
+     * synchronized lyrics or chapters.
+     *
+     * The complex property keys "PICTURE" and "GENERALOBJECT" can be used
+     * to request APIC and GEOB frames.
+     *
+     * \note The frames which are not decoded are written back unchanged when
+     * the tag is saved, but they are not accessible through their specific
+     * Frame subclasses.
+     *
+     * \see FileRef::FileRef(FileName, bool, AudioProperties::ReadStyle, const StringList &)
+     */
+
+    class TAGLIB_EXPORT SelectiveFrameFactory : public FrameFactory
+    {
+    public:
+      /*!
+       * Constructs a frame factory which decodes only the frames for the
+       * property keys \a keys.
+       */
+      explicit SelectiveFrameFactory(const StringList &keys);
+
+      /*!
+       * Destroys the frame factory.
+       */
+      ~SelectiveFrameFactory();
+
+      /*!
+       * Returns the property keys for which frames are decoded.
+       */
+      StringList propertyKeys() const;
+
+      /*!
+       * Returns \c true if a frame with ID \a frameID (after conversion to
+       * ID3v2.4) can provide values for one of the property keys.
+       */
+      bool isFrameWanted(const ByteVector &frameID) const;
+
+      using FrameFactory::createFrame;
+
+    protected:
+      /*!
+       * Creates an UnknownFrame for frames which are not wanted, otherwise
+       * the frame is created by the FrameFactory.  ID3v2.2 frames which have
+       * no ID3v2.4 ID before they are created, i.e. PIC, are always created,
+       * so that they are not lost when the tag is saved.
+       */
+      Frame *createFrame(const ByteVector &data, Frame::Header *header,
+                         const Header *tagHeader) const override;
+
+    private:
+      class SelectiveFrameFactoryPrivate;
+      TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+      std::unique_ptr<SelectiveFrameFactoryPrivate> d;
+    };
+
   }  // namespace ID3v2
 }  // namespace TagLib
 
@@ -25,9 +25,27 @@
 
 #include "id3v2synchdata.h"
 
+#include <cstring>
+#include <utility>
+
 using namespace TagLib;
 using namespace ID3v2;
 
+namespace
+{
+  // Returns the first 0xFF byte in [begin, end) or null if there is none.
+  const char *findFF(const char *begin, const char *end)
+  {
+    return static_cast<const char *>(::memchr(begin, 0xFF, end - begin));
+  }
+
+  // Returns true if a 0x00 byte has to be inserted between 0xFF and c.
+  bool needsSynchByte(char c)
+  {
+    return c == '\0' || (static_cast<unsigned char>(c) & 0xE0) == 0xE0;
+  }
+}  // namespace
+
 unsigned int SynchData::toUInt(const ByteVector &data)
 {
   unsigned int sum = 0;
@@ -72,29 +90,77 @@ ByteVector SynchData::fromUInt(unsigned int value)
 
 ByteVector SynchData::decode(const ByteVector &data)
 {
-  if(data.isEmpty()) {
-    return ByteVector();
-  }
+  ByteVector result = data;
+  decodeInPlace(result);
+  return result;
+}
 
-  // We have this optimized method instead of using ByteVector::replace(),
-  // since it makes a great difference when decoding huge unsynchronized frames.
+void SynchData::decodeInPlace(ByteVector &data)
+{
+  // The 0xFF bytes are searched using memchr(), which is vectorized by the
+  // C library, and the data between them is moved in blocks, since it makes
+  // a great difference when decoding huge unsynchronized frames.
+
+  const char *const constBegin = std::as_const(data).data();
+  const unsigned int size = data.size();
+
+  unsigned int first = size;
+  for(const char *p = constBegin;
+      (p = findFF(p, constBegin + size)) != nullptr && ++p < constBegin + size;) {
+    if(*p == '\0') {
+      first = static_cast<unsigned int>(p - constBegin);
+      break;
+    }
+  }
 
-  ByteVector result(data.size());
+  if(first == size)
+    return;
+
+  char *const begin = data.data();
+  const char *const end = begin + size;
+  char *dst = begin + first;
+  const char *src = dst + 1;
+
+  while(src < end) {
+    const char *ff = findFF(src, end);
+    const char *runEnd = ff ? ff + 1 : end;
+    ::memmove(dst, src, runEnd - src);
+    dst += runEnd - src;
+    src = runEnd;
+    if(ff && src < end && *src == '\0')
+      ++src;
+  }
 
-  auto src = data.begin();
-  auto dst = result.begin();
+  data.resize(static_cast<unsigned int>(dst - begin));
+}
 
-  while(src < data.end() - 1) {
-    *dst++ = *src++;
+ByteVector SynchData::encode(const ByteVector &data)
+{
+  const char *const begin = data.data();
+  const char *const end = begin + data.size();
 
-    if(*(src - 1) == '\xff' && *src == '\x00')
-      ++src;
+  unsigned int count = 0;
+  for(const char *p = begin; (p = findFF(p, end)) != nullptr;) {
+    if(++p == end || needsSynchByte(*p))
+      ++count;
   }
 
-  if(src < data.end())
-    *dst++ = *src++;
-
-  result.resize(static_cast<unsigned int>(dst - result.begin()));
+  if(count == 0)
+    return data;
+
+  ByteVector result(data.size() + count);
+  char *dst = result.data();
+  const char *src = begin;
+
+  while(src < end) {
+    const char *ff = findFF(src, end);
+    const char *runEnd = ff ? ff + 1 : end;
+    ::memcpy(dst, src, runEnd - src);
+    dst += runEnd - src;
+    src = runEnd;
+    if(ff && (src == end || needsSynchByte(*src)))
+      *dst++ = '\0';
+  }
 
   return result;
 }
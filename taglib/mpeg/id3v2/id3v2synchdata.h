@@ -60,8 +60,28 @@ namespace TagLib {
 
       /*!
        * Convert the data from unsynchronized data to its original format.
+       * If \a data does not contain any 0xFF 0x00 sequence, \a data itself
+       * is returned without copying it.
        */
       TAGLIB_EXPORT ByteVector decode(const ByteVector &data);
+
+      /*!
+       * Converts \a data from unsynchronized data to its original format in
+       * place.  As the decoded data is never larger, no memory is allocated
+       * unless \a data shares its buffer with another ByteVector, and
+       * \a data is not modified at all if it does not contain any 0xFF 0x00
+       * sequence.
+       */
+      TAGLIB_EXPORT void decodeInPlace(ByteVector &data);
+
+      /*!
+       * Returns the unsynchronized representation of \a data, i.e. a 0x00
+       * byte is inserted after every 0xFF byte which is followed by 0x00 or
+       * a byte with the three most significant bits set, or which is the
+       * last byte.  If no such byte exists, \a data itself is returned
+       * without copying it.
+       */
+      TAGLIB_EXPORT ByteVector encode(const ByteVector &data);
     }  // namespace SynchData
 
   }  // namespace ID3v2
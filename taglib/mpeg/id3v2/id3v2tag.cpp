@@ -27,7 +27,9 @@
 
 #include <algorithm>
 #include <array>
+#include <map>
 #include <utility>
+#include <vector>
 
 #include "tdebug.h"
 #include "tfile.h"
@@ -45,6 +47,8 @@
 #include "frames/uniquefileidentifierframe.h"
 #include "frames/unsynchronizedlyricsframe.h"
 #include "frames/unknownframe.h"
+#include "frames/chapterframe.h"
+#include "frames/tableofcontentsframe.h"
 
 using namespace TagLib;
 using namespace ID3v2;
@@ -55,17 +59,95 @@ namespace
   const ID3v2::Latin1StringHandler *stringHandler = &defaultStringHandler;
 
   constexpr long MinPaddingSize = 1024;
-  constexpr long MaxPaddingSize = 1024 * 1024;
+
+  constexpr unsigned int CompareChunkSize = 64 * 1024;
+
+  bool isChapterFrame(const ByteVector &frameID)
+  {
+    return frameID == "CHAP" || frameID == "CTOC";
+  }
+
+  // Read the fields of CHAP and CTOC frames for the chapter index without
+  // creating the frames, see ChapterFrame::parseFields() and
+  // TableOfContentsFrame::parseFields().
+
+  bool parseChapterFields(const ByteVector &data, ID3v2::ChapterIndex::Chapter &chapter)
+  {
+    const int end = data.find('\0');
+    if(end < 0 || data.size() < static_cast<unsigned int>(end) + 17)
+      return false;
+
+    chapter.elementID   = data.mid(0, end);
+    chapter.startTime   = data.toUInt(end + 1, true);
+    chapter.endTime     = data.toUInt(end + 5, true);
+    chapter.startOffset = data.toUInt(end + 9, true);
+    chapter.endOffset   = data.toUInt(end + 13, true);
+    return true;
+  }
+
+  bool parseTableOfContentsFields(const ByteVector &data,
+                                  ID3v2::ChapterIndex::TableOfContents &toc)
+  {
+    const int end = data.find('\0');
+    if(end < 0 || data.size() < static_cast<unsigned int>(end) + 3)
+      return false;
+
+    toc.elementID = data.mid(0, end);
+
+    unsigned int pos = end + 1;
+    const auto flags = static_cast<unsigned char>(data[pos++]);
+    toc.isTopLevel = (flags & 2) != 0;
+    toc.isOrdered  = (flags & 1) != 0;
+
+    const auto entryCount = static_cast<unsigned char>(data[pos++]);
+    for(unsigned int i = 0; i < entryCount && pos < data.size(); ++i) {
+      const int childEnd = data.find('\0', pos);
+      if(childEnd < 0) {
+        toc.childElements.append(data.mid(pos));
+        break;
+      }
+      toc.childElements.append(data.mid(pos, childEnd - pos));
+      pos = childEnd + 1;
+    }
+    return true;
+  }
 }  // namespace
 
 class ID3v2::Tag::TagPrivate
 {
 public:
-  TagPrivate()
+  TagPrivate(Tag *t) :
+    tag(t)
   {
     frameList.setAutoDelete(true);
   }
 
+  // A frame found by parse(), it is created when it is first accessed.
+  struct FrameIndexEntry {
+    ByteVector frameID;
+    unsigned int offset;
+    unsigned int size;
+    bool tagAlterPreservation;
+    bool materialized;
+    Frame *frame;
+    // The position of the frame in the tag in the file, -1 if it is unknown.
+    long long filePosition;
+  };
+
+  // A frame copied by render() from the frame data.
+  struct RenderedEntry {
+    size_t index;
+    unsigned int position;
+  };
+
+  void materializeFrames(const ByteVector &frameID = ByteVector());
+  Frame *materializeFrame(size_t index);
+  Frame *createFrame(FrameIndexEntry &entry);
+  bool hasPendingFrames(const ByteVector &frameID = ByteVector()) const;
+  void setPictureReference(AttachedPictureFrame *picture,
+                           const FrameIndexEntry &entry) const;
+
+  Tag *const tag;
   const FrameFactory *factory { nullptr };
 
   File *file { nullptr };
@@ -77,8 +159,199 @@ public:
 
   FrameListMap frameListMap;
   FrameList frameList;
+
+  // The frame data of the tag and the index of its frames in the order they
+  // were parsed.  The frames which are already created are also contained in
+  // frameList, in the same order and before any frames added later.
+  ByteVector frameData;
+  std::vector<FrameIndexEntry> frameIndex;
+  unsigned int indexVersion { 0 };
+  bool unsynchronised { false };
+  bool rawFramesValid { false };
+  bool aggregated { false };
+
+  // The frame data of an ID3v2.2 tag as it was read, isModified() compares
+  // the frames with the frames created from it.
+  ByteVector storedFrameData;
+
+  // The chapter index built by parse(), it is only valid as long as the
+  // CHAP and CTOC frames have not been created.
+  ChapterIndex chapterIndex;
+  bool chapterIndexValid { false };
+
+  // The position in frameIndex of the CHAP frame with each element ID, -1 if
+  // the element ID is used by more than one CHAP frame.  These frames can be
+  // created one by one while the chapter index is valid.
+  std::map<ByteVector, long long> chapterEntries;
+  bool chapterFramesCreated { false };
+
+  // The frames copied by the last call to render() and the size of its data.
+  std::vector<RenderedEntry> renderedEntries;
+  unsigned int renderedSize { 0 };
 };
 
+void ID3v2::Tag::TagPrivate::materializeFrames(const ByteVector &frameID)
+{
+  if(frameIndex.empty())
+    return;
+
+  // FrameFactory::rebuildAggregateFrames() combines TDRC with TDAT and TIME
+  // from ID3v2.3 tags, so these frames have to be created together.
+
+  const auto isDateFrame = [](const ByteVector &id) {
+    return id == "TDRC" || id == "TDAT" || id == "TIME";
+  };
+  const bool aggregate = !aggregated &&
+    (frameID.isEmpty() || (indexVersion < 4 && isDateFrame(frameID)));
+
+  // Frames created one by one by materializeFrame() may follow the frames
+  // created here in the frame list map, so they are inserted in front of them.
+
+  std::map<ByteVector, unsigned int> mapPositions;
+
+  auto it = frameList.begin();
+  for(auto &entry : frameIndex) {
+    if(entry.materialized) {
+      if(entry.frame) {
+        ++it;
+        if(chapterFramesCreated)
+          ++mapPositions[entry.frame->frameID()];
+      }
+      continue;
+    }
+    if(!frameID.isEmpty() && entry.frameID != frameID &&
+       !(aggregate && isDateFrame(entry.frameID)))
+      continue;
+
+    if(isChapterFrame(entry.frameID))
+      chapterIndexValid = false;
+
+    Frame *frame = createFrame(entry);
+    if(!frame)
+      continue;
+
+    frameList.insert(it, frame);
+    FrameList &frames = frameListMap[frame->frameID()];
+    if(chapterFramesCreated) {
+      unsigned int &position = mapPositions[frame->frameID()];
+      frames.insert(std::next(frames.begin(), position++), frame);
+    }
+    else {
+      frames.append(frame);
+    }
+  }
+
+  if(aggregate) {
+    aggregated = true;
+    factory->rebuildAggregateFrames(tag);
+  }
+
+  if(frameID.isEmpty()) {
+    // The chapter index refers to the frame index for the CHAP frames
+    // created by materializeFrame().
+    if(chapterFramesCreated)
+      chapterIndexValid = false;
+
+    frameIndex.clear();
+    frameData.clear();
+  }
+}
+
+Frame *ID3v2::Tag::TagPrivate::materializeFrame(size_t index)
+{
+  FrameIndexEntry &entry = frameIndex[index];
+  if(entry.materialized)
+    return entry.frame;
+
+  // Insert the frame at the positions given by the frames in front of it.
+
+  unsigned int listPosition = 0;
+  unsigned int mapPosition = 0;
+  for(size_t i = 0; i < index; ++i) {
+    if(frameIndex[i].frame) {
+      ++listPosition;
+      if(frameIndex[i].frameID == entry.frameID)
+        ++mapPosition;
+    }
+  }
+
+  Frame *frame = createFrame(entry);
+  if(!frame)
+    return nullptr;
+
+  frameList.insert(std::next(frameList.begin(), listPosition), frame);
+  FrameList &frames = frameListMap[frame->frameID()];
+  frames.insert(std::next(frames.begin(), mapPosition), frame);
+  return frame;
+}
+
+Frame *ID3v2::Tag::TagPrivate::createFrame(FrameIndexEntry &entry)
+{
+  entry.materialized = true;
+
+  Frame *frame = factory->createFrame(
+    frameData.mid(entry.offset, entry.size), &header);
+  if(!frame)
+    return nullptr;
+  if(frame->size() <= 0) {
+    delete frame;
+    return nullptr;
+  }
+
+  entry.frame = frame;
+  if(auto picture = dynamic_cast<AttachedPictureFrame *>(frame))
+    setPictureReference(picture, entry);
+  return frame;
+}
+
+void ID3v2::Tag::TagPrivate::setPictureReference(AttachedPictureFrame *picture,
+                                                const FrameIndexEntry &entry) const
+{
+  // The image data is at the end of the frame, its location in the file is
+  // known unless the tag has been unsynchronised as a whole in ID3v2.3 or
+  // the frame is compressed or encrypted.
+
+  const unsigned int pictureSize = picture->picture().size();
+  if(!file || pictureSize == 0 || entry.filePosition < 0 ||
+     picture->header()->compression() || picture->header()->encryption() ||
+     entry.offset + entry.size > frameData.size())
+    return;
+
+  const offset_t frameOffset = tagOffset + entry.filePosition;
+
+  if(indexVersion < 4 || !(unsynchronised || picture->header()->unsynchronisation())) {
+    if(pictureSize <= entry.size) {
+      picture->setPictureReference(PictureReference(
+        file, frameOffset + entry.size - pictureSize, pictureSize));
+    }
+    return;
+  }
+
+  // Find the start of the unsynchronised image data by counting the decoded
+  // bytes from the end of the frame, a 0x00 following 0xFF is not decoded.
+
+  const char *raw = frameData.data() + entry.offset;
+  unsigned int pos = entry.size;
+  unsigned int decoded = 0;
+  while(decoded < pictureSize && pos > 0) {
+    --pos;
+    if(!(raw[pos] == '\0' && pos > 0 && static_cast<unsigned char>(raw[pos - 1]) == 0xFF))
+      ++decoded;
+  }
+  if(decoded == pictureSize) {
+    picture->setPictureReference(PictureReference(
+      file, frameOffset + pos, entry.size - pos, PictureReference::Unsynchronised));
+  }
+}
+
+bool ID3v2::Tag::TagPrivate::hasPendingFrames(const ByteVector &frameID) const
+{
+  return std::any_of(frameIndex.begin(), frameIndex.end(),
+    [&frameID](const FrameIndexEntry &entry) {
+      return !entry.materialized && (frameID.isEmpty() || entry.frameID == frameID);
+    });
+}
+
 class ID3v2::Latin1StringHandler::Latin1StringHandlerPrivate
 {
 };
@@ -101,13 +374,13 @@ String Latin1StringHandler::parse(const ByteVector &data) const
 ////////////////////////////////////////////////////////////////////////////////
 
 ID3v2::Tag::Tag() :
-  d(std::make_unique<TagPrivate>())
+  d(std::make_unique<TagPrivate>(this))
 {
   d->factory = FrameFactory::instance();
 }
 
 ID3v2::Tag::Tag(File *file, offset_t tagOffset, const FrameFactory *factory) :
-  d(std::make_unique<TagPrivate>())
+  d(std::make_unique<TagPrivate>(this))
 {
   d->factory = factory;
   d->file = file;
@@ -116,32 +389,43 @@ ID3v2::Tag::Tag(File *file, offset_t tagOffset, const FrameFactory *factory) :
   read();
 }
 
+ID3v2::Tag::Tag(File *file, offset_t tagOffset, const FrameFactory *factory,
+                const ByteVector &data) :
+  d(std::make_unique<TagPrivate>(this))
+{
+  d->factory = factory;
+  d->file = file;
+  d->tagOffset = tagOffset;
+
+  read(data);
+}
+
 ID3v2::Tag::~Tag() = default;
 
 String ID3v2::Tag::title() const
 {
-  if(!d->frameListMap["TIT2"].isEmpty())
-    return joinTagValues(d->frameListMap["TIT2"].front()->toStringList());
+  if(!frameList("TIT2").isEmpty())
+    return joinTagValues(frameList("TIT2").front()->toStringList());
   return String();
 }
 
 String ID3v2::Tag::artist() const
 {
-  if(!d->frameListMap["TPE1"].isEmpty())
-    return joinTagValues(d->frameListMap["TPE1"].front()->toStringList());
+  if(!frameList("TPE1").isEmpty())
+    return joinTagValues(frameList("TPE1").front()->toStringList());
   return String();
 }
 
 String ID3v2::Tag::album() const
 {
-  if(!d->frameListMap["TALB"].isEmpty())
-    return joinTagValues(d->frameListMap["TALB"].front()->toStringList());
+  if(!frameList("TALB").isEmpty())
+    return joinTagValues(frameList("TALB").front()->toStringList());
   return String();
 }
 
 String ID3v2::Tag::comment() const
 {
-  const FrameList &comments = d->frameListMap["COMM"];
+  const FrameList &comments = frameList("COMM");
 
   if(comments.isEmpty())
     return String();
@@ -157,7 +441,7 @@ String ID3v2::Tag::comment() const
 
 String ID3v2::Tag::genre() const
 {
-  const FrameList &tconFrames = d->frameListMap["TCON"];
+  const FrameList &tconFrames = frameList("TCON");
   if(tconFrames.isEmpty())
   {
     return String();
@@ -197,18 +481,43 @@ String ID3v2::Tag::genre() const
 
 unsigned int ID3v2::Tag::year() const
 {
-  if(!d->frameListMap["TDRC"].isEmpty())
-    return d->frameListMap["TDRC"].front()->toString().substr(0, 4).toInt();
+  if(!frameList("TDRC").isEmpty())
+    return frameList("TDRC").front()->toString().substr(0, 4).toInt();
   return 0;
 }
 
 unsigned int ID3v2::Tag::track() const
 {
-  if(!d->frameListMap["TRCK"].isEmpty())
-    return d->frameListMap["TRCK"].front()->toString().toInt();
+  if(!frameList("TRCK").isEmpty())
+    return frameList("TRCK").front()->toString().toInt();
   return 0;
 }
 
+void ID3v2::Tag::basicFields(BasicFields &fields) const
+{
+  // Each frame list is looked up once, only the frames of the basic fields
+  // are materialized.
+
+  const auto frameText = [this](const ByteVector &frameID) {
+    const FrameList &frames = frameList(frameID);
+    return frames.isEmpty()
+      ? String() : joinTagValues(frames.front()->toStringList());
+  };
+
+  fields.title = frameText("TIT2");
+  fields.artist = frameText("TPE1");
+  fields.album = frameText("TALB");
+  fields.comment = comment();
+  fields.genre = genre();
+
+  const FrameList &tdrcFrames = frameList("TDRC");
+  fields.year = tdrcFrames.isEmpty()
+    ? 0 : tdrcFrames.front()->toString().substr(0, 4).toInt();
+  const FrameList &trckFrames = frameList("TRCK");
+  fields.track = trckFrames.isEmpty()
+    ? 0 : trckFrames.front()->toString().toInt();
+}
+
 void ID3v2::Tag::setTitle(const String &s)
 {
   setTextFrame("TIT2", s);
@@ -231,7 +540,7 @@ void ID3v2::Tag::setComment(const String &s)
     return;
   }
 
-  if(const FrameList &comments = d->frameListMap["COMM"]; !comments.isEmpty()) {
+  if(const FrameList &comments = frameList("COMM"); !comments.isEmpty()) {
     for(const auto &commFrame : comments) {
       auto frame = dynamic_cast<CommentsFrame *>(commFrame);
       if(frame && frame->description().isEmpty()) {
@@ -295,7 +604,32 @@ void ID3v2::Tag::setTrack(unsigned int i)
 
 bool ID3v2::Tag::isEmpty() const
 {
-  return d->frameList.isEmpty();
+  // Only frames which are written by render() are counted.  Frames which have
+  // not been created yet are copied unless they are to be discarded when the
+  // tag is altered.  ID3v2.2 frames are always converted, so they have to be
+  // created to find out if they can be rendered.
+
+  if(d->indexVersion < 3 && d->hasPendingFrames())
+    d->materializeFrames();
+
+  if(std::any_of(d->frameIndex.cbegin(), d->frameIndex.cend(),
+       [](const auto &entry) {
+         return !entry.materialized && !entry.tagAlterPreservation;
+       }))
+    return false;
+
+  return std::none_of(d->frameList.begin(), d->frameList.end(), [](Frame *frame) {
+    if(frame->header()->frameID().size() != 4 || frame->header()->tagAlterPreservation())
+      return false;
+
+    // As in renderFrames(), the frame is rendered as ID3v2.4 frame.
+
+    const unsigned int frameVersion = frame->header()->version();
+    frame->header()->setVersion(4);
+    const bool hasData = frame->render().size() != frame->headerSize();
+    frame->header()->setVersion(frameVersion);
+    return hasData;
+  });
 }
 
 Header *ID3v2::Tag::header() const
@@ -310,27 +644,39 @@ ExtendedHeader *ID3v2::Tag::extendedHeader() const
 
 const FrameListMap &ID3v2::Tag::frameListMap() const
 {
+  d->materializeFrames();
   return d->frameListMap;
 }
 
 const FrameList &ID3v2::Tag::frameList() const
 {
+  d->materializeFrames();
   return d->frameList;
 }
 
 const FrameList &ID3v2::Tag::frameList(const ByteVector &frameID) const
 {
+  d->materializeFrames(frameID);
   return d->frameListMap[frameID];
 }
 
 void ID3v2::Tag::addFrame(Frame *frame)
 {
+  if(isChapterFrame(frame->frameID()))
+    d->chapterIndexValid = false;
+
+  d->materializeFrames(frame->frameID());
   d->frameList.append(frame);
   d->frameListMap[frame->frameID()].append(frame);
 }
 
 void ID3v2::Tag::removeFrame(Frame *frame, bool del)
 {
+  d->materializeFrames();
+
+  if(isChapterFrame(frame->frameID()))
+    d->chapterIndexValid = false;
+
   // remove the frame from the frame list
   auto it = d->frameList.find(frame);
   d->frameList.erase(it);
@@ -344,9 +690,140 @@ void ID3v2::Tag::removeFrame(Frame *frame, bool del)
     delete frame;
 }
 
+ID3v2::ChapterIndex ID3v2::Tag::chapterIndex() const
+{
+  if(d->chapterIndexValid && !d->chapterFramesCreated)
+    return d->chapterIndex;
+
+  if(d->chapterIndexValid) {
+    // Some CHAP frames have been created by ChapterFrame::findByElementID()
+    // and possibly modified, their values are taken from the frames.
+
+    List<ChapterIndex::Chapter> chapters;
+    for(auto chapter : d->chapterIndex.chapters()) {
+      const auto entry = d->chapterEntries.find(chapter.elementID);
+      if(entry != d->chapterEntries.end() && entry->second >= 0) {
+        if(auto frame = dynamic_cast<const ChapterFrame *>(
+             d->frameIndex[static_cast<size_t>(entry->second)].frame)) {
+          chapter = {
+            frame->elementID(), frame->startTime(), frame->endTime(),
+            frame->startOffset(), frame->endOffset()
+          };
+        }
+      }
+      chapters.append(chapter);
+    }
+    return ChapterIndex(chapters, d->chapterIndex.tablesOfContents());
+  }
+
+  // The CHAP or CTOC frames have been created and possibly modified, build
+  // the index from the frames.
+
+  List<ChapterIndex::Chapter> chapters;
+  for(const auto &frame : frameList("CHAP")) {
+    if(auto chapter = dynamic_cast<const ChapterFrame *>(frame)) {
+      chapters.append({
+        chapter->elementID(), chapter->startTime(), chapter->endTime(),
+        chapter->startOffset(), chapter->endOffset()
+      });
+    }
+  }
+
+  List<ChapterIndex::TableOfContents> tablesOfContents;
+  for(const auto &frame : frameList("CTOC")) {
+    if(auto toc = dynamic_cast<const TableOfContentsFrame *>(frame)) {
+      tablesOfContents.append({
+        toc->elementID(), toc->isTopLevel(), toc->isOrdered(), toc->childElements()
+      });
+    }
+  }
+
+  return ChapterIndex(chapters, tablesOfContents);
+}
+
+bool ID3v2::Tag::findIndexedChapterFrame(const ByteVector &elementID, Frame **frame) const
+{
+  // As long as the chapter index is valid, the CHAP frame is looked up in the
+  // index and only this frame is created.
+
+  *frame = nullptr;
+  if(!d->chapterIndexValid)
+    return false;
+
+  const auto entry = d->chapterEntries.find(elementID);
+  if(entry == d->chapterEntries.end()) {
+    // The element ID of a created frame may have been changed.
+    for(const auto &[id, index] : d->chapterEntries) {
+      if(index < 0)
+        continue;
+      auto chapter = dynamic_cast<ChapterFrame *>(d->frameIndex[static_cast<size_t>(index)].frame);
+      if(chapter && chapter->elementID() == elementID) {
+        *frame = chapter;
+        break;
+      }
+    }
+    return true;
+  }
+  if(entry->second < 0)
+    return false;
+
+  d->chapterFramesCreated = true;
+  *frame = d->materializeFrame(static_cast<size_t>(entry->second));
+  return true;
+}
+
+ByteVectorList ID3v2::Tag::textFrameUTF8Values(const ByteVector &frameID) const
+{
+  // Text frames of ID3v2.4 tags which have not been created yet are decoded
+  // directly from the tag data.  Frames which are modified by the frame
+  // factory when they are created (TXXX, TCON and frames from older versions)
+  // and compressed frames are created as usual.
+
+  const auto frames = d->frameListMap.find(frameID);
+  if(d->indexVersion == 4 && d->factory == FrameFactory::instance() &&
+     frameID.startsWith("T") && frameID != "TXXX" && frameID != "TCON" &&
+     (frames == d->frameListMap.end() || frames->second.isEmpty()) &&
+     d->hasPendingFrames(frameID)) {
+    ByteVectorList values;
+    bool decoded = true;
+    for(const auto &entry : d->frameIndex) {
+      if(entry.frameID != frameID)
+        continue;
+
+      ByteVector data = d->frameData.mid(entry.offset, entry.size);
+      auto [header, ok] = d->factory->prepareFrameHeader(data, &d->header);
+      const std::unique_ptr<Frame::Header> frameHeader(header);
+      if(!frameHeader || !ok)
+        continue;
+      if(frameHeader->compression()) {
+        decoded = false;
+        break;
+      }
+
+      unsigned int fieldOffset = frameHeader->size();
+      unsigned int fieldLength = frameHeader->frameSize();
+      if(frameHeader->dataLengthIndicator()) {
+        fieldLength = SynchData::toUInt(data.mid(fieldOffset, 4));
+        fieldOffset += 4;
+      }
+      values.append(TextIdentificationFrame::parseUTF8Fields(
+        data.mid(fieldOffset, fieldLength)));
+    }
+    if(decoded)
+      return values;
+  }
+
+  ByteVectorList values;
+  for(const auto &frame : frameList(frameID)) {
+    if(auto textFrame = dynamic_cast<const TextIdentificationFrame *>(frame))
+      values.append(textFrame->fieldListUTF8());
+  }
+  return values;
+}
+
 void ID3v2::Tag::removeFrames(const ByteVector &id)
 {
-  const FrameList frames = d->frameListMap[id];
+  const FrameList frames = frameList(id);
   for(const auto &frame : frames)
     removeFrame(frame, true);
 }
@@ -450,10 +927,10 @@ PropertyMap ID3v2::Tag::setProperties(const PropertyMap &origProps)
 StringList ID3v2::Tag::complexPropertyKeys() const
 {
   StringList keys;
-  if(d->frameListMap.contains("APIC")) {
+  if(d->frameListMap.contains("APIC") || d->hasPendingFrames("APIC")) {
     keys.append("PICTURE");
   }
-  if(d->frameListMap.contains("GEOB")) {
+  if(d->frameListMap.contains("GEOB") || d->hasPendingFrames("GEOB")) {
     keys.append("GENERALOBJECT");
   }
   return keys;
@@ -463,6 +940,7 @@ List<VariantMap> ID3v2::Tag::complexProperties(const String &key) const
 {
   List<VariantMap> props;
   if(const String uppercaseKey = key.upper(); uppercaseKey == "PICTURE") {
+    d->materializeFrames("APIC");
     const FrameList pictures = d->frameListMap.value("APIC");
     for(const Frame *frame : pictures) {
       if(auto picture = dynamic_cast<const AttachedPictureFrame *>(frame)) {
@@ -477,6 +955,7 @@ List<VariantMap> ID3v2::Tag::complexProperties(const String &key) const
     }
   }
   else if(uppercaseKey == "GENERALOBJECT") {
+    d->materializeFrames("GEOB");
     const FrameList geobs = d->frameListMap.value("GEOB");
     for(const Frame *frame : geobs) {
       if(auto geob = dynamic_cast<const GeneralEncapsulatedObjectFrame *>(frame)) {
@@ -667,75 +1146,161 @@ ByteVector ID3v2::Tag::render(Version version) const
   // in ID3v2::Header::tagSize() -- includes the extended header, frames and
   // padding, but does not include the tag's header or footer.
 
-  // TODO: Render the extended header.
+  ByteVector tagData = renderFrames(version, true);
 
-  // Downgrade the frames that ID3v2.3 doesn't support.
+  // Compute the amount of padding, and append that to tagData.
 
-  FrameList newFrames;
-  newFrames.setAutoDelete(true);
+  tagData.resize(static_cast<unsigned int>(
+    tagData.size() + paddingSize(tagData.size())), '\0');
 
-  FrameList frames;
-  if(version == v4) {
-    frames = d->frameList;
-  }
-  else {
-    downgradeFrames(&frames, &newFrames);
-  }
+  // Set the version and data size.
+  d->header.setMajorVersion(version);
+  d->header.setTagSize(tagData.size() - Header::size());
 
-  // Reserve a 10-byte blank space for an ID3v2 tag header.
+  // TODO: This should eventually include d->footer->render().
+  const ByteVector headerData = d->header.render();
+  std::copy(headerData.begin(), headerData.end(), tagData.begin());
 
-  ByteVector tagData(Header::size(), '\0');
+  d->renderedSize = tagData.size();
 
-  // Loop through the frames rendering them and adding them to the tagData.
+  return tagData;
+}
 
-  for(const auto &frame : std::as_const(frames)) {
-    frame->header()->setVersion(version == v3 ? 3 : 4);
-    if(frame->header()->frameID().size() != 4) {
-      debug("An ID3v2 frame of unsupported or unknown type \'"
-            + String(frame->header()->frameID()) + "\' has been discarded");
-      continue;
-    }
-    if(!frame->header()->tagAlterPreservation()) {
-      const ByteVector frameData = frame->render();
-      if(frameData.size() == frame->headerSize()) {
-        debug("An empty ID3v2 frame \'"
-              + String(frame->header()->frameID()) + "\' has been discarded");
-        continue;
-      }
-      tagData.append(frameData);
-    }
-  }
+bool ID3v2::Tag::isModified(IOStream *stream, offset_t offset,
+                            offset_t size) const
+{
+  if(!stream || offset < 0)
+    return true;
 
-  // Compute the amount of padding, and append that to tagData.
+  // The stream may be shared with a file, its position is restored.
 
-  long originalSize = d->header.tagSize();
-  long paddingSize = originalSize - (tagData.size() - Header::size());
+  const offset_t position = stream->tell();
+  const bool modified = differsFromStream(stream, offset, size);
+  stream->seek(position);
+  return modified;
+}
 
-  if(paddingSize <= 0) {
-    paddingSize = MinPaddingSize;
-  }
-  else {
-    // Padding won't increase beyond 1% of the file size or 1MB.
+bool ID3v2::Tag::differsFromStream(IOStream *stream, offset_t offset,
+                                   offset_t size) const
+{
+  stream->seek(offset);
+  const ByteVector headerData = stream->readBlock(Header::size());
+  if(headerData.size() != Header::size() ||
+     !headerData.startsWith(Header::fileIdentifier()))
+    return true;
+
+  const Header storedHeader(headerData);
+
+  if(storedHeader.majorVersion() < 3) {
+
+    // ID3v2.2 tags cannot be rendered, so the frames are compared with the
+    // frames created from the data which was read.
+
+    if(d->storedFrameData.isEmpty())
+      return true;
+    if(d->frameList.isEmpty() && !d->frameIndex.empty())
+      return false;  // No frames have been created since the tag was read.
 
-    offset_t threshold = d->file ? d->file->length() / 100 : 0;
-    threshold = std::max<offset_t>(threshold, MinPaddingSize);
-    threshold = std::min<offset_t>(threshold, MaxPaddingSize);
+    Tag storedTag;
+    storedTag.d->factory = d->factory;
+    storedTag.d->header.setData(headerData);
+    storedTag.parse(d->storedFrameData);
+    return renderFrames(v4, false) != storedTag.renderFrames(v4, false);
+  }
 
-    if(paddingSize > threshold)
-      paddingSize = MinPaddingSize;
+  const auto version = storedHeader.majorVersion() == 3 ? v3 : v4;
+  ByteVector tagData = renderFrames(version, false);
+  tagData.resize(static_cast<unsigned int>(
+    tagData.size() + paddingSize(tagData.size())), '\0');
+  if(static_cast<offset_t>(tagData.size()) != size)
+    return true;
+
+  Header header(d->header.render());
+  header.setMajorVersion(version);
+  header.setTagSize(tagData.size() - Header::size());
+  const ByteVector renderedHeader = header.render();
+  if(renderedHeader != headerData)
+    return true;
+
+  for(unsigned int position = Header::size(); position < tagData.size();
+      position += CompareChunkSize) {
+    const unsigned int length = std::min(CompareChunkSize, tagData.size() - position);
+    stream->seek(offset + position);
+    if(stream->readBlock(length) != tagData.mid(position, length))
+      return true;
   }
 
-  tagData.resize(static_cast<unsigned int>(tagData.size() + paddingSize), '\0');
+  return false;
+}
 
-  // Set the version and data size.
-  d->header.setMajorVersion(version);
-  d->header.setTagSize(tagData.size() - Header::size());
+void ID3v2::Tag::write(TagLib::File *file, const ByteVector &data,
+                       offset_t offset, offset_t replace) const
+{
+  if(!file)
+    return;
 
-  // TODO: This should eventually include d->footer->render().
-  const ByteVector headerData = d->header.render();
-  std::copy(headerData.begin(), headerData.end(), tagData.begin());
+  const bool rendered = file == d->file && data.size() == d->renderedSize;
 
-  return tagData;
+  if(static_cast<offset_t>(data.size()) != replace) {
+    file->insert(data, offset, static_cast<size_t>(replace));
+  }
+  else {
+    // The tag has the same size as the existing one and is overwritten in
+    // place.  Frames copied by render() which are at the same position as in
+    // the file are skipped, the other parts are compared with the file and
+    // only written where they differ.
+
+    std::vector<std::pair<unsigned int, unsigned int>> ranges;
+    unsigned int position = 0;
+    if(rendered && offset == d->tagOffset) {
+      for(const auto &[index, renderedPosition] : d->renderedEntries) {
+        const auto &entry = d->frameIndex[index];
+        if(entry.filePosition != renderedPosition)
+          continue;
+        if(renderedPosition > position)
+          ranges.emplace_back(position, renderedPosition - position);
+        position = renderedPosition + entry.size;
+      }
+    }
+    if(position < data.size())
+      ranges.emplace_back(position, data.size() - position);
+
+    for(const auto &[start, length] : ranges) {
+      const unsigned int end = start + length;
+      for(unsigned int chunk = start; chunk < end; chunk += CompareChunkSize) {
+        const unsigned int size = std::min(CompareChunkSize, end - chunk);
+        file->seek(offset + chunk);
+        const ByteVector existing = file->readBlock(size);
+
+        unsigned int first = 0;
+        while(first < existing.size() && existing[first] == data[chunk + first])
+          ++first;
+        if(first == size)
+          continue;
+
+        unsigned int last = size;
+        if(existing.size() == size) {
+          while(last > first && existing[last - 1] == data[chunk + last - 1])
+            --last;
+        }
+
+        file->seek(offset + chunk + first);
+        file->writeBlock(data.mid(chunk + first, last - first));
+      }
+    }
+  }
+
+  // The frames which have been copied are now at their rendered positions,
+  // the positions of the others are unknown.
+
+  if(rendered) {
+    for(auto &entry : d->frameIndex)
+      entry.filePosition = -1;
+    for(const auto &[index, renderedPosition] : d->renderedEntries)
+      d->frameIndex[index].filePosition = renderedPosition;
+    d->tagOffset = offset;
+  }
+  d->renderedEntries.clear();
 }
 
 Latin1StringHandler const *ID3v2::Tag::latin1StringHandler()
@@ -756,6 +1321,11 @@ void ID3v2::Tag::setLatin1StringHandler(const Latin1StringHandler *handler)
 ////////////////////////////////////////////////////////////////////////////////
 
 void ID3v2::Tag::read()
+{
+  read(ByteVector());
+}
+
+void ID3v2::Tag::read(const ByteVector &data)
 {
   if(!d->file)
     return;
@@ -763,14 +1333,28 @@ void ID3v2::Tag::read()
   if(!d->file->isOpen())
     return;
 
-  d->file->seek(d->tagOffset);
-  d->header.setData(d->file->readBlock(Header::size()));
+  ByteVector tagData = data;
+  if(tagData.size() < Header::size()) {
+    d->file->seek(d->tagOffset);
+    tagData = d->file->readBlock(Header::size());
+  }
+
+  d->header.setData(tagData.mid(0, Header::size()));
+
+  // Read the rest of the tag and the header of a possible duplicate tag as
+  // one block.
+
+  const unsigned int blockSize = d->header.completeTagSize() + Header::size();
+  if(tagData.size() < blockSize) {
+    d->file->seek(d->tagOffset + tagData.size());
+    tagData.append(d->file->readBlock(blockSize - tagData.size()));
+  }
 
   // If the tag size is 0, then this is an invalid tag (tags must contain at
   // least one frame)
 
   if(d->header.tagSize() != 0)
-    parse(d->file->readBlock(d->header.tagSize()));
+    parse(tagData.mid(Header::size(), d->header.tagSize()));
 
   // Look for duplicate ID3v2 tags and treat them as an extra blank of this one.
   // It leads to overwriting them with zero when saving the tag.
@@ -782,13 +1366,22 @@ void ID3v2::Tag::read()
 
   while(true) {
 
-    d->file->seek(d->tagOffset + d->header.completeTagSize() + extraSize);
+    const offset_t position = d->header.completeTagSize() + extraSize;
 
-    const ByteVector data = d->file->readBlock(Header::size());
-    if(data.size() < Header::size() || !data.startsWith(Header::fileIdentifier()))
+    ByteVector headerData;
+    if(position + Header::size() <= tagData.size()) {
+      headerData = tagData.mid(static_cast<unsigned int>(position), Header::size());
+    }
+    else {
+      d->file->seek(d->tagOffset + position);
+      headerData = d->file->readBlock(Header::size());
+    }
+
+    if(headerData.size() < Header::size() ||
+       !headerData.startsWith(Header::fileIdentifier()))
       break;
 
-    extraSize += Header(data).completeTagSize();
+    extraSize += Header(headerData).completeTagSize();
   }
 
   if(extraSize != 0) {
@@ -802,7 +1395,7 @@ void ID3v2::Tag::parse(const ByteVector &origData)
   ByteVector data = origData;
 
   if(d->header.unsynchronisation() && d->header.majorVersion() <= 3)
-    data = SynchData::decode(data);
+    SynchData::decodeInPlace(data);
 
   unsigned int frameDataPosition = 0;
   unsigned int frameDataLength = data.size();
@@ -825,7 +1418,25 @@ void ID3v2::Tag::parse(const ByteVector &origData)
   if(d->header.footerPresent() && Footer::size() <= frameDataLength)
     frameDataLength -= Footer::size();
 
-  // parse frames
+  // Index the frames, they are only created by the frame factory when they
+  // are accessed.
+
+  d->frameData = data;
+  d->indexVersion = d->header.majorVersion();
+  if(d->indexVersion < 3)
+    d->storedFrameData = origData;
+  d->unsynchronised = d->header.unsynchronisation();
+
+  // Frames from ID3v2.4 tags with unsynchronisation can not be copied as
+  // they are when rendering, because the tag header will be rendered without
+  // this flag.
+
+  d->rawFramesValid =
+    !(d->header.unsynchronisation() && d->header.majorVersion() > 3);
+
+  List<ChapterIndex::Chapter> chapters;
+  List<ChapterIndex::TableOfContents> tablesOfContents;
+  bool chapterIndexValid = true;
 
   // Make sure that there is at least enough room in the remaining frame data for
   // a frame header.
@@ -846,31 +1457,81 @@ void ID3v2::Tag::parse(const ByteVector &origData)
     const ByteVector origData = data.mid(frameDataPosition);
     const Header *tagHeader = &d->header;
     unsigned int headerVersion = tagHeader->majorVersion();
-    Frame *frame = d->factory->createFrame(origData, tagHeader);
-
-    if(!frame)
-      return;
-
-    // Checks to make sure that frame parsed correctly.
+    ByteVector frameData = origData;
+    std::unique_ptr<Frame::Header> frameHeader(
+      d->factory->prepareFrameHeader(frameData, tagHeader).first);
 
-    if(frame->size() <= 0) {
-      delete frame;
-      return;
-    }
+    if(!frameHeader)
+      break;
 
-    if(frame->header()->version() == headerVersion) {
-      frameDataPosition += frame->size() + frame->headerSize();
+    unsigned int frameSize;
+    if(frameHeader->version() == headerVersion) {
+      frameSize = frameHeader->frameSize() + frameHeader->size();
     } else {
       // The frame was converted to another version, e.g. from 2.2 to 2.4.
       // We must advance the frame data position according to the original
       // frame, not the converted frame because its header size might differ.
       Frame::Header origHeader(origData, headerVersion);
-      frameDataPosition += origHeader.frameSize() + origHeader.size();
+      frameSize = origHeader.frameSize() + origHeader.size();
     }
-    addFrame(frame);
+
+    if(frameSize > frameDataLength - frameDataPosition)
+      d->rawFramesValid = false;
+
+    if(isChapterFrame(frameHeader->frameID())) {
+      if(frameHeader->compression() || frameHeader->encryption()) {
+        chapterIndexValid = false;
+      }
+      else {
+        const unsigned int dataLengthSize = frameHeader->dataLengthIndicator() ? 4 : 0;
+        const ByteVector fields = frameData.mid(frameHeader->size() + dataLengthSize,
+                                                frameHeader->frameSize() - dataLengthSize);
+        if(frameHeader->frameID() == "CHAP") {
+          ChapterIndex::Chapter chapter;
+          if(parseChapterFields(fields, chapter)) {
+            chapters.append(chapter);
+            const auto [entry, inserted] = d->chapterEntries.emplace(
+              chapter.elementID, static_cast<long long>(d->frameIndex.size()));
+            if(!inserted)
+              entry->second = -1;
+          }
+          else {
+            chapterIndexValid = false;
+          }
+        }
+        else {
+          ChapterIndex::TableOfContents toc;
+          if(parseTableOfContentsFields(fields, toc))
+            tablesOfContents.append(toc);
+          else
+            chapterIndexValid = false;
+        }
+      }
+    }
+
+    // The frame data of ID3v2.3 tags with unsynchronisation has been
+    // decoded, so it is not found at the same position in the file.
+
+    const long long filePosition = d->unsynchronised && d->indexVersion <= 3
+      ? -1 : static_cast<long long>(Header::size() + frameDataPosition);
+
+    // The frame ID has been converted to ID3v2.4 by prepareFrameHeader(),
+    // except for the ID3v2.2 PIC frame, which AttachedPictureFrameV22
+    // converts when it is created.
+
+    ByteVector frameID = frameHeader->frameID();
+    if(frameID == "PIC")
+      frameID = "APIC";
+
+    d->frameIndex.push_back({
+      frameID, frameDataPosition, frameSize,
+      frameHeader->tagAlterPreservation(), false, nullptr, filePosition
+    });
+    frameDataPosition += frameSize;
   }
 
-  d->factory->rebuildAggregateFrames(this);
+  d->chapterIndex = ChapterIndex(chapters, tablesOfContents);
+  d->chapterIndexValid = chapterIndexValid;
 }
 
 void ID3v2::Tag::setTextFrame(const ByteVector &id, const String &value)
@@ -880,8 +1541,8 @@ void ID3v2::Tag::setTextFrame(const ByteVector &id, const String &value)
     return;
   }
 
-  if(!d->frameListMap[id].isEmpty())
-    d->frameListMap[id].front()->setText(value);
+  if(const FrameList &frames = frameList(id); !frames.isEmpty())
+    frames.front()->setText(value);
   else {
     const String::Type encoding = d->factory->defaultTextEncoding();
     auto f = new TextIdentificationFrame(id, encoding);
@@ -889,3 +1550,102 @@ void ID3v2::Tag::setTextFrame(const ByteVector &id, const String &value)
     f->setText(value);
   }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+ByteVector ID3v2::Tag::renderFrames(Version version, bool update) const
+{
+  // TODO: Render the extended header.
+
+  // Frames which have not been accessed yet can be copied from the parsed
+  // tag data if the version does not change.  When downgrading to ID3v2.3,
+  // this is only possible if no frames have been created or added.
+
+  const bool copyFrames = d->rawFramesValid && !d->frameIndex.empty() &&
+    static_cast<unsigned int>(version) == d->indexVersion &&
+    (version == v4 || d->frameList.isEmpty());
+
+  if(!copyFrames)
+    d->materializeFrames();
+
+  // Downgrade the frames that ID3v2.3 doesn't support.
+
+  FrameList newFrames;
+  newFrames.setAutoDelete(true);
+
+  FrameList frames;
+  if(version == v4) {
+    frames = d->frameList;
+  }
+  else {
+    downgradeFrames(&frames, &newFrames);
+  }
+
+  // Reserve a 10-byte blank space for an ID3v2 tag header.
+
+  ByteVector tagData(Header::size(), '\0');
+
+  // Loop through the frames rendering them and adding them to the tagData.
+  // The version of the frames is only kept if the state of the tag is
+  // updated.
+
+  const auto renderFrame = [version, update, &tagData](Frame *frame) {
+    const unsigned int frameVersion = frame->header()->version();
+    frame->header()->setVersion(version == v3 ? 3 : 4);
+    if(frame->header()->frameID().size() != 4) {
+      debug("An ID3v2 frame of unsupported or unknown type \'"
+            + String(frame->header()->frameID()) + "\' has been discarded");
+    }
+    else if(!frame->header()->tagAlterPreservation()) {
+      const ByteVector frameData = frame->render();
+      if(frameData.size() == frame->headerSize()) {
+        debug("An empty ID3v2 frame \'"
+              + String(frame->header()->frameID()) + "\' has been discarded");
+      }
+      else {
+        tagData.append(frameData);
+      }
+    }
+    if(!update)
+      frame->header()->setVersion(frameVersion);
+  };
+
+  if(update)
+    d->renderedEntries.clear();
+
+  auto it = frames.begin();
+  if(copyFrames) {
+    for(size_t i = 0; i < d->frameIndex.size(); ++i) {
+      const auto &entry = d->frameIndex[i];
+      if(!entry.materialized) {
+        if(!entry.tagAlterPreservation) {
+          if(update)
+            d->renderedEntries.push_back({i, tagData.size()});
+          tagData.append(d->frameData.mid(entry.offset, entry.size));
+        }
+      }
+      else if(entry.frame) {
+        renderFrame(*it);
+        ++it;
+      }
+    }
+  }
+  for(; it != frames.end(); ++it) {
+    renderFrame(*it);
+  }
+
+  return tagData;
+}
+
+offset_t ID3v2::Tag::paddingSize(unsigned int renderedSize) const
+{
+  const long originalSize = d->header.tagSize();
+  const PaddingPolicy policy = d->file ? d->file->paddingPolicy()
+                                       : PaddingPolicy::defaultPolicy();
+  return policy.padding(
+    originalSize - (renderedSize - Header::size()),
+    d->file ? d->file->length() : 0,
+    MinPaddingSize, PaddingPolicy::ShrinkLargePadding);
+}
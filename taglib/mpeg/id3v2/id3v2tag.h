@@ -27,6 +27,7 @@
 #define TAGLIB_ID3V2TAG_H
 
 #include "tbytevector.h"
+#include "tbytevectorlist.h"
 #include "tstring.h"
 #include "tlist.h"
 #include "tmap.h"
@@ -35,10 +36,12 @@
 #include "tag.h"
 #include "id3v2.h"
 #include "id3v2framefactory.h"
+#include "id3v2chapterindex.h"
 
 namespace TagLib {
 
   class File;
+  class IOStream;
 
   namespace ID3v2 {
 
@@ -112,6 +115,13 @@ namespace TagLib {
      * More information on the structure of frames can be found in the ID3v2::Frame
      * class.
      *
+     * When a tag is read, only an index of its frames is built.  The frames are
+     * created by the FrameFactory when they are first accessed, e.g. all frames
+     * of a type are created by frameList(const ByteVector &) and all frames of
+     * the tag by frameList(), frameListMap() or properties().  Frames which have
+     * not been accessed are written back unchanged by render() if the ID3v2
+     * version is not changed.
+     *
      * read() and parse() pass binary data to the other ID3v2 class structures,
      * they do not handle parsing of flags or fields, for instance.  Those are
      * handled by similar functions within those classes.
@@ -155,6 +165,17 @@ namespace TagLib {
       Tag(File *file, offset_t tagOffset,
           const FrameFactory *factory = FrameFactory::instance());
 
+      /*!
+       * Constructs an ID3v2 tag read from \a file starting at \a tagOffset
+       * as above, but takes the start of the tag from \a data, which the
+       * caller has already read from \a tagOffset.  Only the part of the tag
+       * which is not covered by \a data is read from the file.
+       *
+       * \see read(const ByteVector &)
+       */
+      Tag(File *file, offset_t tagOffset, const FrameFactory *factory,
+          const ByteVector &data);
+
       /*!
        * Destroys this Tag instance.
        */
@@ -172,6 +193,7 @@ namespace TagLib {
       String genre() const override;
       unsigned int year() const override;
       unsigned int track() const override;
+      void basicFields(BasicFields &fields) const override;
 
       void setTitle(const String &s) override;
       void setArtist(const String &s) override;
@@ -181,6 +203,14 @@ namespace TagLib {
       void setYear(unsigned int i) override;
       void setTrack(unsigned int i) override;
 
+      /*!
+       * Returns \c true if render() would not write any frames.  Frames which
+       * are discarded when rendering, e.g. empty frames or frames with the tag
+       * alter preservation flag set, are not counted.
+       *
+       * \note Frames of an ID3v2.2 tag which have not been accessed yet are
+       * created by this method, because they are converted when rendering.
+       */
       bool isEmpty() const override;
 
       /*!
@@ -223,6 +253,10 @@ namespace TagLib {
        *
        * \endcode
        *
+       * \note Although this method is const, it creates all frames which
+       * have not been accessed yet and combines the date frames of older tag
+       * versions as described in FrameFactory::rebuildAggregateFrames().
+       *
        * \warning You should not modify this data structure directly, instead
        * use addFrame() and removeFrame().
        *
@@ -237,6 +271,9 @@ namespace TagLib {
        * This can be useful if for example you want to iterate over the tag's frames
        * in the order that they occur in the tag.
        *
+       * \note Although this method is const, it creates all frames which
+       * have not been accessed yet, see frameListMap().
+       *
        * \warning You should not modify this data structure directly, instead
        * use addFrame() and removeFrame().
        */
@@ -251,6 +288,9 @@ namespace TagLib {
        * frameListMap()[frameID];
        * \endcode
        *
+       * \note Although this method is const, it creates the frames with the
+       * id \a frameID which have not been accessed yet.
+       *
        * \see frameListMap()
        */
       const FrameList &frameList(const ByteVector &frameID) const;
@@ -281,6 +321,33 @@ namespace TagLib {
        */
       void removeFrames(const ByteVector &id);
 
+      /*!
+       * Returns an index of the chapters (CHAP frames) and tables of contents
+       * (CTOC frames) of the tag.  The index is built when the tag is read
+       * without creating the frames.  If the frames have already been created,
+       * e.g. by frameList(), the index is built from them.
+       *
+       * The CHAP frames, together with their embedded frames, e.g. the
+       * chapter titles, are only created when they are accessed.
+       * ChapterFrame::findByElementID() only creates the requested frame,
+       * frameList("CHAP") creates all of them.
+       */
+      ChapterIndex chapterIndex() const;
+
+      /*!
+       * Returns the strings of all text identification frames with the ID
+       * \a frameID as UTF-8 encoded byte vectors, as returned by
+       * TextIdentificationFrame::fieldListUTF8() for each frame.  This is
+       * useful to pass the values to code working with UTF-8 strings.
+       *
+       * If the frames of an ID3v2.4 tag have not been created yet, they are
+       * decoded directly from the tag data without creating frames or String
+       * objects.  Otherwise the frames are created as by frameList().
+       *
+       * \see TextIdentificationFrame::parseUTF8Fields()
+       */
+      ByteVectorList textFrameUTF8Values(const ByteVector &frameID) const;
+
       /*!
        * Implements the unified property interface -- export function.
        * This function does some work to translate the hard-specified ID3v2
@@ -348,6 +415,33 @@ namespace TagLib {
        */
       ByteVector render(Version version) const;
 
+      /*!
+       * Writes \a data, which has been returned by the last call to render(),
+       * to \a file at \a offset, replacing \a replace bytes.
+       *
+       * If \a data has the same size as the replaced tag, it is written in
+       * place and only the parts which differ from the file are written.
+       * Frames which have not been accessed since the tag was read and are
+       * still at the same position are skipped without being compared, so
+       * for example unchanged pictures are neither read nor written.
+       * Otherwise File::insert() is used.
+       */
+      void write(TagLib::File *file, const ByteVector &data,
+                 offset_t offset, offset_t replace) const;
+
+      /*!
+       * Returns \c true if the tag differs from the tag of \a size bytes
+       * stored at \a offset in \a stream, i.e. if the tag has been modified
+       * since it was read or written.  The tag is compared in the version of
+       * the stored tag.  ID3v2.2 tags cannot be rendered, in this case the
+       * frames are compared with the frames created from the data which was
+       * read.
+       *
+       * Unlike render(), this does not change the version in header() or the
+       * frames.  The position of \a stream is restored.
+       */
+      bool isModified(IOStream *stream, offset_t offset, offset_t size) const;
+
       /*!
        * Gets the current string handler that decides how the "Latin-1" data
        * will be converted to and from binary data.
@@ -378,9 +472,18 @@ namespace TagLib {
        */
       void read();
 
+      /*!
+       * Reads the tag like read(), using \a data as the start of the tag.
+       * The header, the body and the header of a possible duplicate tag
+       * following this tag are read in a single block, only the part which is
+       * not covered by \a data is read from the file.
+       */
+      void read(const ByteVector &data);
+
       /*!
        * This is called by read to parse the body of the tag.  It determines if an
-       * extended header exists and adds frames to the FrameListMap.
+       * extended header exists and builds the index of the frames, which are
+       * added to the FrameListMap when they are accessed.
        */
       void parse(const ByteVector &origData);
 
@@ -396,6 +499,25 @@ namespace TagLib {
       void downgradeFrames(FrameList *frames, FrameList *newFrames) const;
 
     private:
+      friend class ChapterFrame;
+
+      /*!
+       * Looks up the CHAP frame with \a elementID in the chapter index and
+       * only creates this frame.  Returns \c false if the frame cannot be
+       * found using the index, otherwise \a frame is set to the frame or null
+       * if there is no such frame.
+       */
+      bool findIndexedChapterFrame(const ByteVector &elementID, Frame **frame) const;
+
+      /*!
+       * Compares the tag with the stored tag for isModified(), the position
+       * of \a stream is not restored.
+       */
+      bool differsFromStream(IOStream *stream, offset_t offset, offset_t size) const;
+
+      ByteVector renderFrames(Version version, bool update) const;
+      offset_t paddingSize(unsigned int renderedSize) const;
+
       class TagPrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
       std::unique_ptr<TagPrivate> d;
@@ -35,6 +35,8 @@
 #include "tagunion.h"
 #include "tagutils.h"
 #include "mpegheader.h"
+#include "mpegframewalker.h"
+#include "xingheader.h"
 #include "mpegutils.h"
 
 using namespace TagLib;
@@ -42,6 +44,9 @@ using namespace TagLib;
 namespace
 {
   enum { ID3v2Index = 0, APEIndex = 1, ID3v1Index = 2 };
+
+  // The tag types which have to be read to save or strip a file
+  constexpr int SupportedTags = MPEG::File::ID3v1 | MPEG::File::ID3v2 | MPEG::File::APE;
 } // namespace
 
 class MPEG::File::FilePrivate
@@ -62,6 +67,14 @@ public:
 
   offset_t ID3v1Location { -1 };
 
+  // The tag types which have been read when the file was opened
+  int readTags { AllTags };
+
+  // The ID3v2 tag and the data following it, read in one block when the
+  // file is opened, so that the first MPEG frame is searched in memory.
+  ByteVector readAhead;
+  offset_t readAheadOffset { -1 };
+
   TagUnion tag;
 
   std::unique_ptr<Properties> properties;
@@ -104,13 +117,12 @@ bool MPEG::File::isSupported(IOStream *stream)
 
   const offset_t originalPosition = stream->tell();
   AdapterFile file(stream);
+  FrameWalker walker(&file, buffer, headerOffset, bufferSize());
 
   for(unsigned int i = 0; i < buffer.size() - 1; ++i) {
-    if(isFrameSync(buffer, i)) {
-      if(const Header header(&file, headerOffset + i, true); header.isValid()) {
-        stream->seek(originalPosition);
-        return true;
-      }
+    if(isFrameSync(buffer, i) && walker.isValidFrame(headerOffset + i)) {
+      stream->seek(originalPosition);
+      return true;
     }
   }
 
@@ -162,6 +174,26 @@ MPEG::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
     read(readProperties, readStyle);
 }
 
+MPEG::File::File(FileName file, TagSelection tags, ID3v2::FrameFactory *frameFactory) :
+  TagLib::File(file),
+  d(std::make_unique<FilePrivate>(
+    frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
+{
+  d->readTags = tags.tags();
+  if(isOpen())
+    read(false, Properties::TagsOnly);
+}
+
+MPEG::File::File(IOStream *stream, TagSelection tags, ID3v2::FrameFactory *frameFactory) :
+  TagLib::File(stream),
+  d(std::make_unique<FilePrivate>(
+    frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
+{
+  d->readTags = tags.tags();
+  if(isOpen())
+    read(false, Properties::TagsOnly);
+}
+
 MPEG::File::~File() = default;
 
 TagLib::Tag *MPEG::File::tag() const
@@ -196,6 +228,12 @@ MPEG::Properties *MPEG::File::audioProperties() const
 
 bool MPEG::File::save()
 {
+  // An unmodified ID3v2.2 or ID3v2.3 tag is not rewritten as ID3v2.4.  Files
+  // which cannot be saved are still reported by save(AllTags).
+
+  if(!readOnly() && (d->readTags & SupportedTags) == SupportedTags && !isModified())
+    return true;
+
   return save(AllTags);
 }
 
@@ -206,6 +244,11 @@ bool MPEG::File::save(int tags, StripTags strip, ID3v2::Version version, Duplica
     return false;
   }
 
+  if((d->readTags & SupportedTags) != SupportedTags) {
+    debug("MPEG::File::save() -- Cannot save a file which has not been read with all tags.");
+    return false;
+  }
+
   // Create the tags if we've been asked to.
 
   if(duplicate == Duplicate) {
@@ -235,7 +278,7 @@ bool MPEG::File::save(int tags, StripTags strip, ID3v2::Version version, Duplica
         d->ID3v2Location = 0;
 
       const ByteVector data = ID3v2Tag()->render(version);
-      insert(data, d->ID3v2Location, d->ID3v2OriginalSize);
+      ID3v2Tag()->write(this, data, d->ID3v2Location, d->ID3v2OriginalSize);
 
       if(d->APELocation >= 0)
         d->APELocation += static_cast<long>(data.size()) - d->ID3v2OriginalSize;
@@ -259,15 +302,14 @@ bool MPEG::File::save(int tags, StripTags strip, ID3v2::Version version, Duplica
 
       // ID3v1 tag is not empty. Update the old one or create a new one.
 
-      if(d->ID3v1Location >= 0) {
+      if(d->ID3v1Location < 0)
+        d->ID3v1Location = length();
+
+      if(const ByteVector data = ID3v1Tag()->render();
+         !containsBlock(data, d->ID3v1Location, data.size())) {
         seek(d->ID3v1Location);
+        writeBlock(data);
       }
-      else {
-        seek(0, End);
-        d->ID3v1Location = tell();
-      }
-
-      writeBlock(ID3v1Tag()->render());
     }
     else {
 
@@ -291,7 +333,8 @@ bool MPEG::File::save(int tags, StripTags strip, ID3v2::Version version, Duplica
       }
 
       const ByteVector data = APETag()->render();
-      insert(data, d->APELocation, d->APEOriginalSize);
+      if(!containsBlock(data, d->APELocation, d->APEOriginalSize))
+        insert(data, d->APELocation, d->APEOriginalSize);
 
       if(d->ID3v1Location >= 0)
         d->ID3v1Location += static_cast<long>(data.size()) - d->APEOriginalSize;
@@ -309,6 +352,50 @@ bool MPEG::File::save(int tags, StripTags strip, ID3v2::Version version, Duplica
   return true;
 }
 
+bool MPEG::File::isModified() const
+{
+  // The stream is shared with the file, its position is restored.
+
+  const auto tagsModified = [this] {
+    if(const auto id3v2Tag = static_cast<ID3v2::Tag *>(d->tag[ID3v2Index]);
+       id3v2Tag && !id3v2Tag->isEmpty()) {
+      if(d->ID3v2Location < 0 ||
+         id3v2Tag->isModified(stream(), d->ID3v2Location, d->ID3v2OriginalSize))
+        return true;
+    }
+    else if(d->ID3v2Location >= 0) {
+      return true;
+    }
+
+    if(const auto id3v1Tag = static_cast<ID3v1::Tag *>(d->tag[ID3v1Index]);
+       id3v1Tag && !id3v1Tag->isEmpty()) {
+      if(const ByteVector data = id3v1Tag->render();
+         d->ID3v1Location < 0 || !containsBlock(data, d->ID3v1Location, data.size()))
+        return true;
+    }
+    else if(d->ID3v1Location >= 0) {
+      return true;
+    }
+
+    if(const auto apeTag = static_cast<APE::Tag *>(d->tag[APEIndex]);
+       apeTag && !apeTag->isEmpty()) {
+      if(d->APELocation < 0 ||
+         !containsBlock(apeTag->render(), d->APELocation, d->APEOriginalSize))
+        return true;
+    }
+    else if(d->APELocation >= 0) {
+      return true;
+    }
+
+    return false;
+  };
+
+  const offset_t position = tell();
+  const bool modified = tagsModified();
+  stream()->seek(position);
+  return modified;
+}
+
 ID3v2::Tag *MPEG::File::ID3v2Tag(bool create)
 {
   return d->tag.access<ID3v2::Tag>(ID3v2Index, create, d->ID3v2FrameFactory);
@@ -331,6 +418,11 @@ bool MPEG::File::strip(int tags, bool freeMemory)
     return false;
   }
 
+  if((d->readTags & SupportedTags) != SupportedTags) {
+    debug("MPEG::File::strip() - Cannot strip tags from a file which has not been read with all tags.");
+    return false;
+  }
+
   if((tags & ID3v2) && d->ID3v2Location >= 0) {
     removeBlock(d->ID3v2Location, d->ID3v2OriginalSize);
 
@@ -372,49 +464,41 @@ bool MPEG::File::strip(int tags, bool freeMemory)
   return true;
 }
 
-offset_t MPEG::File::nextFrameOffset(offset_t position)
+bool MPEG::File::stripTo(int tags, IOStream *target)
 {
-  ByteVector frameSyncBytes(2, '\0');
+  if((d->readTags & SupportedTags) != SupportedTags) {
+    debug("MPEG::File::stripTo() - Cannot strip tags from a file which has not been read with all tags.");
+    return false;
+  }
 
-  while(true) {
-    seek(position);
-    const ByteVector buffer = readBlock(bufferSize());
-    if(buffer.isEmpty())
-      return -1;
+  Map<offset_t, size_t> skippedBlocks;
 
-    for(unsigned int i = 0; i < buffer.size(); ++i) {
-      frameSyncBytes[0] = frameSyncBytes[1];
-      frameSyncBytes[1] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        if(const Header header(this, position + i - 1, true); header.isValid())
-          return position + i - 1;
-      }
-    }
+  if((tags & ID3v2) && d->ID3v2Location >= 0)
+    skippedBlocks.insert(d->ID3v2Location, d->ID3v2OriginalSize);
 
-    position += bufferSize();
-  }
+  if((tags & APE) && d->APELocation >= 0)
+    skippedBlocks.insert(d->APELocation, d->APEOriginalSize);
+
+  if((tags & ID3v1) && d->ID3v1Location >= 0)
+    skippedBlocks.insert(d->ID3v1Location, 128);
+
+  return copyTo(target, skippedBlocks);
 }
 
-offset_t MPEG::File::previousFrameOffset(offset_t position)
+offset_t MPEG::File::nextFrameOffset(offset_t position)
 {
-  ByteVector frameSyncBytes(2, '\0');
-
-  while(position > 0) {
-    const offset_t bufferLength = std::min<offset_t>(position, bufferSize());
-    position -= bufferLength;
+  // Start with the data read together with the ID3v2 tag if it is still
+  // available.
 
-    seek(position);
-    const ByteVector buffer = readBlock(bufferLength);
+  FrameWalker walker(this, d->readAhead, d->readAheadOffset, bufferSize());
+  return walker.nextFrameOffset(position);
+}
 
-    for(int i = buffer.size() - 1; i >= 0; --i) {
-      frameSyncBytes[1] = frameSyncBytes[0];
-      frameSyncBytes[0] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        if(const Header header(this, position + i, true); header.isValid())
-          return position + i + header.frameLength();
-      }
-    }
-  }
+offset_t MPEG::File::previousFrameOffset(offset_t position)
+{
+  FrameWalker walker(this, bufferSize());
+  if(const offset_t offset = walker.previousFrameOffset(position); offset >= 0)
+    return offset + walker.header(offset).frameLength();
 
   return -1;
 }
@@ -443,6 +527,99 @@ offset_t MPEG::File::lastFrameOffset()
   return previousFrameOffset(position);
 }
 
+MPEG::SeekIndex MPEG::File::buildSeekIndex(unsigned int granularity)
+{
+  const offset_t firstOffset = firstFrameOffset();
+  if(firstOffset < 0)
+    return SeekIndex();
+
+  FrameWalker walker(this);
+
+  const Header firstHeader = walker.header(firstOffset);
+  if(!firstHeader.isValid() || firstHeader.sampleRate() <= 0 ||
+     firstHeader.samplesPerFrame() <= 0)
+    return SeekIndex();
+
+  const int sampleRate = firstHeader.sampleRate();
+  const long long samplesPerFrame = firstHeader.samplesPerFrame();
+  const long long step = std::max(1LL, static_cast<long long>(granularity) * sampleRate / 1000);
+
+  SeekIndex::EntryList entries;
+  long long nextSample = 0;
+
+  const XingHeader xingHeader(walker.data(firstOffset, firstHeader.frameLength()));
+
+  if(xingHeader.isValid() && !xingHeader.tableOfContents().isEmpty()) {
+    const List<unsigned int> toc = xingHeader.tableOfContents();
+    const long long totalSamples = xingHeader.totalFrames() * samplesPerFrame;
+
+    if(xingHeader.type() == XingHeader::Xing) {
+
+      // Entry i is the position of i percent of the stream in 1/256 of the
+      // stream size.  Entries which do not advance in the stream, e.g. in
+      // short streams, are skipped.
+
+      long long percent = 0;
+      for(const auto position : toc) {
+        const long long sample = totalSamples * percent++ / 100;
+        const offset_t offset =
+          firstOffset + static_cast<offset_t>(xingHeader.totalSize()) * position / 256;
+        if(sample >= nextSample &&
+           (entries.isEmpty() ||
+            (sample > entries.back().sample && offset > entries.back().offset))) {
+          entries.append(SeekIndex::Entry(sample, offset));
+          nextSample = sample + step;
+        }
+      }
+    }
+    else {
+
+      // The entries are the sizes of the sections following the frame with
+      // the VBRI header.
+
+      const long long samplesPerEntry = xingHeader.framesPerTableEntry() * samplesPerFrame;
+      offset_t offset = firstOffset + firstHeader.frameLength();
+      long long sample = 0;
+      for(const auto size : toc) {
+        if(sample >= totalSamples)
+          break;
+        if(sample >= nextSample &&
+           (entries.isEmpty() || offset > entries.back().offset)) {
+          entries.append(SeekIndex::Entry(sample, offset));
+          nextSample = sample + step;
+        }
+        offset += size;
+        sample += samplesPerEntry;
+      }
+    }
+
+    return SeekIndex(sampleRate, entries);
+  }
+
+  // Without a table of contents, walk all frames up to the end of the last
+  // frame.  A frame with a VBR header does not contain audio data.
+
+  offset_t streamEnd = length();
+  if(const offset_t lastOffset = lastFrameOffset(); lastOffset >= 0)
+    streamEnd = lastOffset + walker.header(lastOffset).frameLength();
+
+  offset_t offset = xingHeader.isValid() ? firstOffset + firstHeader.frameLength() : firstOffset;
+  long long sample = 0;
+
+  while((offset = walker.nextStreamFrameOffset(offset, firstHeader, streamEnd)) >= 0) {
+    if(sample >= nextSample) {
+      entries.append(SeekIndex::Entry(sample, offset));
+      nextSample = sample + step;
+    }
+
+    const Header header = walker.header(offset);
+    sample += header.samplesPerFrame();
+    offset += header.frameLength();
+  }
+
+  return SeekIndex(sampleRate, entries);
+}
+
 bool MPEG::File::hasID3v1Tag() const
 {
   return d->ID3v1Location >= 0;
@@ -466,33 +643,68 @@ void MPEG::File::read(bool readProperties, Properties::ReadStyle readStyle)
 {
   // Look for an ID3v2 tag
 
-  d->ID3v2Location = findID3v2(readStyle);
+  if(d->readTags & ID3v2)
+    d->ID3v2Location = findID3v2(readStyle);
 
   if(d->ID3v2Location >= 0) {
-    d->tag.set(ID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory));
+    // Read the tag, the header of a possible duplicate tag and the start of
+    // the audio data in a single block.
+
+    seek(d->ID3v2Location);
+    const ID3v2::Header header(readBlock(ID3v2::Header::size()));
+    seek(d->ID3v2Location);
+    d->readAhead = readBlock(header.completeTagSize() + ID3v2::Header::size() + bufferSize());
+    d->readAheadOffset = d->ID3v2Location;
+
+    d->tag.set(ID3v2Index, new ID3v2::Tag(this, d->ID3v2Location, d->ID3v2FrameFactory,
+                                          d->readAhead));
     d->ID3v2OriginalSize = ID3v2Tag()->header()->completeTagSize();
   }
 
-  // Look for an ID3v1 tag
+  // Look for an ID3v1 tag and an APE footer.  If only the tags at the end of
+  // the file are read, they are read in one block, otherwise the identifiers
+  // are checked first, which reads less data.
+
+  ByteVector tail;
+  offset_t tailOffset = 0;
+  offset_t ID3v1Location = -1;
 
-  d->ID3v1Location = Utils::findID3v1(this);
+  if(!(d->readTags & ID3v2) && (d->readTags & (ID3v1 | APE))) {
+    tail = Utils::readTail(this, &tailOffset);
+    ID3v1Location = Utils::findID3v1(tail, tailOffset);
+  }
+  else if(d->readTags & (ID3v1 | APE)) {
+    ID3v1Location = Utils::findID3v1(this);
+  }
 
-  if(d->ID3v1Location >= 0)
-    d->tag.set(ID3v1Index, new ID3v1::Tag(this, d->ID3v1Location));
+  if((d->readTags & ID3v1) && ID3v1Location >= 0) {
+    d->ID3v1Location = ID3v1Location;
+    d->tag.set(ID3v1Index, new ID3v1::Tag(this, d->ID3v1Location,
+                                          tail.mid(static_cast<unsigned int>(ID3v1Location - tailOffset))));
+  }
 
   // Look for an APE tag
 
-  d->APELocation = Utils::findAPE(this, d->ID3v1Location);
+  if(d->readTags & APE) {
+    d->APELocation = tail.isEmpty()
+      ? Utils::findAPE(this, ID3v1Location)
+      : Utils::findAPE(tail, tailOffset, ID3v1Location);
+  }
 
   if(d->APELocation >= 0) {
-    d->tag.set(APEIndex, new APE::Tag(this, d->APELocation));
+    const ByteVector footerData = tail.isEmpty() ? ByteVector()
+      : tail.mid(0, static_cast<unsigned int>(d->APELocation - tailOffset) + APE::Footer::size());
+    d->tag.set(APEIndex, new APE::Tag(this, d->APELocation, footerData));
     d->APEOriginalSize = APETag()->footer()->completeTagSize();
     d->APELocation = d->APELocation + APE::Footer::size() - d->APEOriginalSize;
   }
 
-  if(readProperties)
+  if(readProperties && readStyle != Properties::TagsOnly)
     d->properties = std::make_unique<Properties>(this, readStyle);
 
+  d->readAhead.clear();
+  d->readAheadOffset = -1;
+
   // Make sure that we have our default tag types available.
 
   ID3v2Tag(true);
@@ -512,39 +724,33 @@ offset_t MPEG::File::findID3v2(Properties::ReadStyle readStyle)
   if(readBlock(headerID.size()) == headerID)
     return 0;
 
-  if(readStyle == Properties::Fast)
+  if(readStyle == Properties::Fast || readStyle == Properties::TagsOnly)
     return -1;
 
-  if(const Header firstHeader(this, 0, true); firstHeader.isValid())
+  FrameWalker walker(this, bufferSize());
+
+  if(walker.isValidFrame(0))
     return -1;
 
   // Look for an ID3v2 tag until reaching the first valid MPEG frame.
 
-  ByteVector frameSyncBytes(2, '\0');
-  ByteVector tagHeaderBytes(3, '\0');
-  long position = 0;
+  offset_t position = 0;
 
   while(true) {
-    seek(position);
-    const ByteVector buffer = readBlock(bufferSize());
-    if(buffer.isEmpty())
+    const ByteVector buffer = walker.window(position);
+    if(buffer.size() < headerID.size())
       return -1;
 
-    for(unsigned int i = 0; i < buffer.size(); ++i) {
-      frameSyncBytes[0] = frameSyncBytes[1];
-      frameSyncBytes[1] = buffer[i];
-      if(isFrameSync(frameSyncBytes)) {
-        if(const Header header(this, position + i - 1, true); header.isValid())
-          return -1;
-      }
+    for(unsigned int i = 0; i < buffer.size() - 2; ++i) {
+      if(isFrameSync(buffer, i) && walker.isValidFrame(position + i))
+        return -1;
 
-      tagHeaderBytes[0] = tagHeaderBytes[1];
-      tagHeaderBytes[1] = tagHeaderBytes[2];
-      tagHeaderBytes[2] = buffer[i];
-      if(tagHeaderBytes == headerID)
-        return position + i - 2;
+      if(buffer.containsAt(headerID, i))
+        return position + i;
     }
 
-    position += bufferSize();
+    // The last two bytes are checked again at the start of the next window.
+
+    position += buffer.size() - 2;
   }
 }
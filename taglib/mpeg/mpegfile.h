@@ -30,6 +30,7 @@
 #include "taglib_export.h"
 #include "tag.h"
 #include "mpegproperties.h"
+#include "mpegseekindex.h"
 #include "id3v2.h"
 
 namespace TagLib {
@@ -70,11 +71,36 @@ namespace TagLib {
         AllTags = 0xffff
       };
 
+      //! A selection of the tag types which are read when a file is opened
+
+      /*!
+       * This wraps an OR-ed combination of TagTypes for the constructors which
+       * only read some tag types.  It is a distinct type, so that these
+       * constructors cannot be confused with the ones taking \a readProperties.
+       */
+      class TagSelection
+      {
+      public:
+        /*!
+         * Constructs a selection of the tag types \a tags, an OR-ed combination
+         * of TagTypes.
+         */
+        explicit constexpr TagSelection(int tags) : tagTypes(tags) {}
+
+        /*!
+         * Returns the selected tag types, an OR-ed combination of TagTypes.
+         */
+        constexpr int tags() const { return tagTypes; }
+
+      private:
+        int tagTypes;
+      };
+
       /*!
        * Constructs an MPEG file from \a file.  If \a readProperties is \c true the
        * file's audio properties will also be read.
        *
-       * If \a readStyle is not Fast, the file will be scanned
+       * If \a readStyle is neither Fast nor TagsOnly, the file will be scanned
        * completely if no ID3v2 tag or MPEG sync code is found at the start.
        *
        * If this file contains an ID3v2 tag, the frames will be created using
@@ -91,7 +117,7 @@ namespace TagLib {
        * If this file contains an ID3v2 tag, the frames will be created using
        * \a frameFactory.
        *
-       * If \a readStyle is not Fast, the file will be scanned
+       * If \a readStyle is neither Fast nor TagsOnly, the file will be scanned
        * completely if no ID3v2 tag or MPEG sync code is found at the start.
        *
        * \deprecated Use the constructor above.
@@ -111,7 +137,7 @@ namespace TagLib {
        * If this file contains an ID3v2 tag, the frames will be created using
        * \a frameFactory.
        *
-       * If \a readStyle is not Fast, the file will be scanned
+       * If \a readStyle is neither Fast nor TagsOnly, the file will be scanned
        * completely if no ID3v2 tag or MPEG sync code is found at the start.
        *
        * If this file contains an ID3v2 tag, the frames will be created using
@@ -131,7 +157,7 @@ namespace TagLib {
        * If this file contains an ID3v2 tag, the frames will be created using
        * \a frameFactory.
        *
-       * If \a readStyle is not Fast, the file will be scanned
+       * If \a readStyle is neither Fast nor TagsOnly, the file will be scanned
        * completely if no ID3v2 tag or MPEG sync code is found at the start.
        *
        * \deprecated Use the constructor above.
@@ -141,6 +167,36 @@ namespace TagLib {
            bool readProperties = true,
            Properties::ReadStyle readStyle = Properties::Average);
 
+      /*!
+       * Constructs an MPEG file from \a file which only reads the tag types
+       * selected by \a tags.  No audio properties are read.
+       *
+       * \code
+       * MPEG::File f(fileName, MPEG::File::TagSelection(MPEG::File::ID3v1));
+       * \endcode
+       *
+       * If \a tags does not contain ID3v2, the start of the file is not read at
+       * all, the ID3v1 tag and the APE footer are read from the last 160 bytes
+       * of the file in a single block.  This can be used to quickly list files
+       * which are only tagged with ID3v1.
+       *
+       * Tags which are not selected are not available, so save(), strip() and
+       * stripTo() fail unless ID3v1, ID3v2 and APE tags have been selected.
+       *
+       * If this file contains an ID3v2 tag, the frames will be created using
+       * \a frameFactory (default if null).
+       */
+      File(FileName file, TagSelection tags, ID3v2::FrameFactory *frameFactory = nullptr);
+
+      /*!
+       * Constructs an MPEG file from \a stream which only reads the tag types
+       * selected by \a tags, see the constructor above.
+       *
+       * \note TagLib will *not* take ownership of the stream, the caller is
+       * responsible for deleting it after the File object.
+       */
+      File(IOStream *stream, TagSelection tags, ID3v2::FrameFactory *frameFactory = nullptr);
+
       /*!
        * Destroys this instance of the File.
        */
@@ -202,7 +258,9 @@ namespace TagLib {
        * If neither exists or if both tags are empty, this will strip the tags
        * from the file.
        *
-       * This is the same as calling save(AllTags);
+       * This is the same as calling save(AllTags), except that nothing is
+       * written if isModified() returns \c false, so an unmodified ID3v2.2 or
+       * ID3v2.3 tag is not converted to ID3v2.4.
        *
        * If you would like more granular control over the content of the tags,
        * with the concession of generality, use parameterized save call below.
@@ -228,6 +286,16 @@ namespace TagLib {
                 ID3v2::Version version = ID3v2::v4,
                 DuplicateTags duplicate = Duplicate);
 
+      /*!
+       * Returns \c true if the tags differ from the tags stored in the file.
+       * The ID3v2 tag is compared in the version of the stored tag, see
+       * ID3v2::Tag::isModified().  Tags which would only be created by
+       * duplicating another tag are not taken into account.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * Returns a pointer to the ID3v2 tag of the file.
        *
@@ -297,6 +365,21 @@ namespace TagLib {
        */
       bool strip(int tags = AllTags, bool freeMemory = true);
 
+      /*!
+       * Writes the file without the tags that match the OR-ed together
+       * TagTypes to \a target, which is overwritten.  The rest of the file is
+       * copied sequentially, so unlike strip() no part of the file has to be
+       * moved in place.  This file and its tags are not modified, unsaved
+       * changes of the tags are not written to \a target.  It returns \c true
+       * if the file has been written successfully.
+       *
+       * This can be used to write the stripped file to a temporary file which
+       * replaces the original file.
+       *
+       * \see TagLib::File::copyTo()
+       */
+      bool stripTo(int tags, IOStream *target);
+
       /*!
        * Returns the position in the file of the first MPEG frame.
        */
@@ -319,6 +402,22 @@ namespace TagLib {
        */
       offset_t lastFrameOffset();
 
+      /*!
+       * Builds an index of seek points in the MPEG stream, which are at least
+       * \a granularity milliseconds apart.
+       *
+       * If the stream has a Xing header with a table of contents or a VBRI
+       * header, the seek points are computed from its table of contents, so
+       * only the first frame has to be read.  Otherwise all frames of the
+       * stream are walked, which gives exact frame offsets also for VBR
+       * streams without VBR header.
+       *
+       * An empty index is returned if no valid MPEG frame is found.
+       *
+       * \see SeekIndex::render()
+       */
+      SeekIndex buildSeekIndex(unsigned int granularity = 1000);
+
       /*!
        * Returns whether or not the file on disk actually has an ID3v1 tag.
        *
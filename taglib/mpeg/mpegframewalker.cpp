@@ -0,0 +1,203 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "mpegframewalker.h"
+
+#include <algorithm>
+
+#include "tbytevector.h"
+#include "tfile.h"
+#include "mpegutils.h"
+
+using namespace TagLib;
+
+namespace
+{
+  // Four bytes for the frame header and two more for the frame length of an
+  // ADTS header.
+  constexpr unsigned int HeaderDataSize = 6;
+}  // namespace
+
+class MPEG::FrameWalker::FrameWalkerPrivate
+{
+public:
+  FrameWalkerPrivate(TagLib::File *file, unsigned int windowSize) :
+    file(file),
+    windowSize(std::max(windowSize, HeaderDataSize))
+  {
+  }
+
+  bool contains(offset_t offset, unsigned int length) const
+  {
+    return windowOffset >= 0 && offset >= windowOffset &&
+           offset + length <= windowOffset + buffer.size();
+  }
+
+  void fill(offset_t offset, unsigned int length)
+  {
+    file->seek(offset);
+    buffer = file->readBlock(std::max(length, windowSize));
+    windowOffset = offset;
+  }
+
+  TagLib::File *file;
+  const unsigned int windowSize;
+  ByteVector buffer;
+  offset_t windowOffset { -1 };
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+MPEG::FrameWalker::FrameWalker(TagLib::File *file, unsigned int windowSize) :
+  d(std::make_unique<FrameWalkerPrivate>(file, windowSize))
+{
+}
+
+MPEG::FrameWalker::FrameWalker(TagLib::File *file, const ByteVector &data, offset_t dataOffset,
+                               unsigned int windowSize) :
+  d(std::make_unique<FrameWalkerPrivate>(file, windowSize))
+{
+  if(!data.isEmpty()) {
+    d->buffer = data;
+    d->windowOffset = dataOffset;
+  }
+}
+
+MPEG::FrameWalker::~FrameWalker() = default;
+
+ByteVector MPEG::FrameWalker::data(offset_t offset, unsigned int length)
+{
+  if(offset < 0)
+    return ByteVector();
+
+  if(!d->contains(offset, length))
+    d->fill(offset, length);
+
+  return d->buffer.mid(static_cast<unsigned int>(offset - d->windowOffset), length);
+}
+
+ByteVector MPEG::FrameWalker::window(offset_t offset)
+{
+  if(offset < 0)
+    return ByteVector();
+
+  if(!d->contains(offset, HeaderDataSize))
+    d->fill(offset, d->windowSize);
+
+  return d->buffer.mid(static_cast<unsigned int>(offset - d->windowOffset));
+}
+
+MPEG::Header MPEG::FrameWalker::header(offset_t offset)
+{
+  return Header(data(offset, HeaderDataSize));
+}
+
+bool MPEG::FrameWalker::isValidFrame(offset_t offset, unsigned int chainLength)
+{
+  for(unsigned int i = 0; i < chainLength; ++i) {
+    const ByteVector headerData = data(offset, HeaderDataSize);
+    if(headerData.size() < 4 || !isFrameSync(headerData))
+      return false;
+
+    const Header header(headerData);
+
+    // A frame length of 0 is probably invalid and would pass the test below
+    // because nextData would be the same as headerData.
+
+    if(!header.isValid() || header.frameLength() == 0)
+      return false;
+
+    // The next frame header must follow right at the end of this frame and
+    // belong to the same stream.
+
+    offset += header.frameLength();
+
+    const ByteVector nextData = data(offset, 4);
+    if(nextData.size() < 4 || !isSameStream(headerData, nextData))
+      return false;
+  }
+
+  return true;
+}
+
+offset_t MPEG::FrameWalker::nextFrameOffset(offset_t position, unsigned int chainLength)
+{
+  while(true) {
+    const ByteVector buffer = window(position);
+    if(buffer.size() < 2)
+      return -1;
+
+    for(unsigned int i = 0; i < buffer.size() - 1; ++i) {
+      if(isFrameSync(buffer, i) && isValidFrame(position + i, chainLength))
+        return position + i;
+    }
+
+    // The last byte is checked again as the first byte of the next window.
+
+    position += buffer.size() - 1;
+  }
+}
+
+offset_t MPEG::FrameWalker::previousFrameOffset(offset_t position, unsigned int chainLength)
+{
+  while(position > 1) {
+    const offset_t start = std::max<offset_t>(0, position - d->windowSize);
+    const ByteVector buffer = data(start, static_cast<unsigned int>(position - start));
+
+    for(int i = static_cast<int>(buffer.size()) - 2; i >= 0; --i) {
+      if(isFrameSync(buffer, i) && isValidFrame(start + i, chainLength))
+        return start + i;
+    }
+
+    if(start == 0)
+      break;
+
+    // Keep the first byte, so that a frame sync spanning the windows is found.
+
+    position = start + 1;
+  }
+
+  return -1;
+}
+
+offset_t MPEG::FrameWalker::nextStreamFrameOffset(offset_t position, const Header &reference,
+                                                  offset_t end)
+{
+  while(position >= 0 && position < end) {
+    if(const Header h = header(position);
+       h.isValid() && h.frameLength() > 0 &&
+       position + h.frameLength() <= end &&
+       h.version() == reference.version() &&
+       h.layer() == reference.layer() &&
+       h.sampleRate() == reference.sampleRate())
+      return position;
+
+    position = nextFrameOffset(position + 1);
+  }
+
+  return -1;
+}
@@ -0,0 +1,153 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_MPEGFRAMEWALKER_H
+#define TAGLIB_MPEGFRAMEWALKER_H
+
+#include <memory>
+
+#include "taglib.h"
+#include "taglib_export.h"
+#include "mpegheader.h"
+
+namespace TagLib {
+
+  class ByteVector;
+  class File;
+
+  namespace MPEG {
+
+    //! Walks MPEG frames using an in-memory read-ahead window
+
+    /*!
+     * This class searches and validates MPEG frame headers in a window of data
+     * read from a file.  The window is only refilled when a header or the
+     * start of the following frame is outside of it, so scanning a stream and
+     * checking the headers of consecutive frames does not need a seek and a
+     * read for every candidate header as Header(File *, offset_t, bool) does.
+     */
+    class TAGLIB_EXPORT FrameWalker
+    {
+    public:
+      /*!
+       * The default size of the read-ahead window.
+       */
+      static constexpr unsigned int DefaultWindowSize = 65536;
+
+      /*!
+       * Constructs a frame walker reading windows of \a windowSize bytes from
+       * \a file.
+       */
+      explicit FrameWalker(TagLib::File *file, unsigned int windowSize = DefaultWindowSize);
+
+      /*!
+       * Constructs a frame walker reading windows of \a windowSize bytes from
+       * \a file.  \a data is used as the initial window and must contain the
+       * data at \a dataOffset in \a file, e.g. data which has already been read
+       * together with a tag.
+       */
+      FrameWalker(TagLib::File *file, const ByteVector &data, offset_t dataOffset,
+                  unsigned int windowSize = DefaultWindowSize);
+
+      /*!
+       * Destroys this FrameWalker instance.
+       */
+      ~FrameWalker();
+
+      FrameWalker(const FrameWalker &) = delete;
+      FrameWalker &operator=(const FrameWalker &) = delete;
+
+      /*!
+       * Returns \a length bytes starting at \a offset.  The returned data is
+       * shorter if the end of the file is reached.
+       */
+      ByteVector data(offset_t offset, unsigned int length);
+
+      /*!
+       * Returns the data of the window starting at \a offset.  A new window is
+       * read if \a offset is not inside the current window or too close to its
+       * end to hold a frame header.  The returned data is empty if \a offset is
+       * at the end of the file.
+       */
+      ByteVector window(offset_t offset);
+
+      /*!
+       * Returns the frame header at \a offset.  The frame length is not
+       * checked against the following frame.
+       *
+       * \see isValidFrame()
+       */
+      Header header(offset_t offset);
+
+      /*!
+       * Returns \c true if there is a valid frame header at \a offset which is
+       * followed by \a chainLength consecutive frames, i.e. the frame lengths
+       * of \a chainLength frames are checked.  All headers must have the same
+       * MPEG version, layer and sample rate.
+       *
+       * With a \a chainLength of 1, this is equivalent to checking
+       * Header(File *, offset_t, bool) with \a checkLength set to \c true.
+       */
+      bool isValidFrame(offset_t offset, unsigned int chainLength = 1);
+
+      /*!
+       * Returns the offset of the first valid frame at or after \a position or
+       * -1 if no valid frame is found.
+       *
+       * \see isValidFrame()
+       */
+      offset_t nextFrameOffset(offset_t position, unsigned int chainLength = 1);
+
+      /*!
+       * Returns the offset of the last valid frame before \a position or -1 if
+       * no valid frame is found.
+       *
+       * \see isValidFrame()
+       */
+      offset_t previousFrameOffset(offset_t position, unsigned int chainLength = 1);
+
+      /*!
+       * Returns the offset of the first frame at or after \a position which
+       * belongs to the same stream as \a reference, i.e. has the same MPEG
+       * version, layer and sample rate, and ends before \a end.  A valid frame
+       * header at \a position is accepted without checking the following
+       * frame, otherwise the next valid frame is searched.  Returns -1 if no
+       * such frame is found.
+       *
+       * This can be used to walk all frames of a stream, skipping damaged
+       * data between frames.
+       */
+      offset_t nextStreamFrameOffset(offset_t position, const Header &reference,
+                                     offset_t end);
+
+    private:
+      class FrameWalkerPrivate;
+      TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+      std::unique_ptr<FrameWalkerPrivate> d;
+    };
+  }  // namespace MPEG
+}  // namespace TagLib
+
+#endif
@@ -62,6 +62,12 @@ MPEG::Header::Header(File *file, offset_t offset, bool checkLength) :
   parse(file, offset, checkLength);
 }
 
+MPEG::Header::Header(const ByteVector &data) :
+  d(std::make_shared<HeaderPrivate>())
+{
+  d->isValid = parse(data);
+}
+
 MPEG::Header::Header(const Header &) = default;
 MPEG::Header::~Header() = default;
 
@@ -149,21 +155,18 @@ MPEG::Header &MPEG::Header::operator=(const Header &h)
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
-void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
+bool MPEG::Header::parse(const ByteVector &data)
 {
-  file->seek(offset);
-  const ByteVector data = file->readBlock(4);
-
   if(data.size() < 4) {
     debug("MPEG::Header::parse() -- data is too short for an MPEG frame header.");
-    return;
+    return false;
   }
 
   // Check for the MPEG synch bytes.
 
   if(!isFrameSync(data)) {
     debug("MPEG::Header::parse() -- MPEG header did not match MPEG synch.");
-    return;
+    return false;
   }
 
   // Set the MPEG version
@@ -177,7 +180,7 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
   else if(versionBits == 3)
     d->version = Version1;
   else
-    return;
+    return false;
 
   // Set the MPEG layer
 
@@ -206,7 +209,7 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
       d->layer = 0;
     }
     else {
-      return;
+      return false;
     }
   }
 
@@ -233,11 +236,10 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
     d->isCopyrighted = (static_cast<unsigned char>(data[3]) & 0x04) != 0;
 
     // Calculate the frame length
-    if(const ByteVector frameLengthData = file->readBlock(2);
-       frameLengthData.size() >= 2) {
+    if(data.size() >= 6) {
       d->frameLength = (static_cast<unsigned char>(data[3]) & 0x3) << 11 |
-                       (static_cast<unsigned char>(frameLengthData[0]) << 3) |
-                       (static_cast<unsigned char>(frameLengthData[1]) >> 5);
+                       (static_cast<unsigned char>(data[4]) << 3) |
+                       (static_cast<unsigned char>(data[5]) >> 5);
 
       d->bitrate = static_cast<int>(d->frameLength * d->sampleRate / 1024.0 + 0.5) * 8 / 1024;
     }
@@ -273,7 +275,7 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
     d->bitrate = bitrates[versionIndex][layerIndex][bitrateIndex];
 
     if(d->bitrate == 0)
-      return;
+      return false;
 
     // Set the sample rate
 
@@ -290,7 +292,7 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
     d->sampleRate = sampleRates[d->version][samplerateIndex];
 
     if(d->sampleRate == 0) {
-      return;
+      return false;
     }
 
     // The channel mode is encoded as a 2 bit value at the end of the 3rd byte,
@@ -327,6 +329,21 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
       d->frameLength += paddingSize[layerIndex];
   }
 
+  return true;
+}
+
+void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
+{
+  file->seek(offset);
+
+  // Four bytes for the header itself and two more for the frame length of an
+  // ADTS header.
+
+  const ByteVector data = file->readBlock(6);
+
+  if(!parse(data))
+    return;
+
   if(checkLength) {
 
     // Check if the frame length has been calculated correctly, or the next frame
@@ -347,12 +364,7 @@ void MPEG::Header::parse(File *file, offset_t offset, bool checkLength)
     if(nextData.size() < 4)
       return;
 
-    constexpr unsigned int HeaderMask = 0xfffe0c00;
-
-    const unsigned int header     = data.toUInt(0, true)     & HeaderMask;
-
-    if(const unsigned int nextHeader = nextData.toUInt(0, true) & HeaderMask;
-       header != nextHeader)
+    if(!isSameStream(data, nextData))
       return;
   }
 
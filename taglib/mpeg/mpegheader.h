@@ -62,6 +62,17 @@ namespace TagLib {
        */
       Header(File *file, offset_t offset, bool checkLength = true);
 
+      /*!
+       * Parses an MPEG header from the start of \a data, which should contain
+       * at least six bytes to get the frame length of an ADTS header.
+       *
+       * As opposed to the constructor taking a file, this does not check if
+       * the next frame header follows at the end of the frame.  This can be
+       * used to parse headers from a buffer which has already been read from
+       * the file.
+       */
+      explicit Header(const ByteVector &data);
+
       /*!
        * Does a shallow copy of \a h.
        */
@@ -205,6 +216,7 @@ namespace TagLib {
 
     private:
       void parse(File *file, offset_t offset, bool checkLength);
+      bool parse(const ByteVector &data);
 
       class HeaderPrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -27,6 +27,7 @@
 
 #include "tdebug.h"
 #include "mpegfile.h"
+#include "mpegframewalker.h"
 #include "xingheader.h"
 #include "apetag.h"
 
@@ -47,8 +48,63 @@ public:
   bool protectionEnabled { false };
   bool isCopyrighted { false };
   bool isOriginal { false };
+  unsigned int frameCount { 0 };
 };
 
+namespace
+{
+  // Walks all frames of the stream from firstFrameOffset to streamEnd and sums
+  // up their number and sizes.  Damaged data between the frames is skipped by
+  // searching the next valid frame.  Frames of other streams, e.g. with a
+  // different sample rate, are not counted.
+  void countFrames(MPEG::File *file, offset_t firstFrameOffset, offset_t streamEnd,
+                   const MPEG::Header &firstHeader,
+                   unsigned int &frameCount, unsigned long long &streamSize)
+  {
+    MPEG::FrameWalker walker(file);
+
+    frameCount = 0;
+    streamSize = 0;
+
+    offset_t offset = firstFrameOffset;
+    while((offset = walker.nextStreamFrameOffset(offset, firstHeader, streamEnd)) >= 0) {
+      const int frameLength = walker.header(offset).frameLength();
+      ++frameCount;
+      streamSize += frameLength;
+      offset += frameLength;
+    }
+  }
+
+  // Returns true if the frames found at evenly spaced positions between
+  // firstFrameOffset and streamEnd and the last frame of the stream have the
+  // bitrate of the first frame.  Only a few small windows are read, so this
+  // is used to avoid walking all frames of a CBR stream.  A stream in which
+  // the bitrate only changes between the checked frames is not detected as
+  // VBR.
+  bool hasConstantBitrate(MPEG::File *file, offset_t firstFrameOffset, offset_t streamEnd,
+                          offset_t lastFrameOffset, const MPEG::Header &firstHeader)
+  {
+    constexpr int probeCount = 16;
+    constexpr unsigned int probeWindowSize = 4096;
+
+    if(firstHeader.isADTS() || firstHeader.bitrate() <= 0 || lastFrameOffset < 0)
+      return false;
+
+    MPEG::FrameWalker walker(file, probeWindowSize);
+    if(walker.header(lastFrameOffset).bitrate() != firstHeader.bitrate())
+      return false;
+
+    const offset_t streamLength = streamEnd - firstFrameOffset;
+    for(int i = 1; i < probeCount; ++i) {
+      const offset_t position = firstFrameOffset + streamLength * i / probeCount;
+      const offset_t offset = walker.nextStreamFrameOffset(position, firstHeader, streamEnd);
+      if(offset < 0 || walker.header(offset).bitrate() != firstHeader.bitrate())
+        return false;
+    }
+    return true;
+  }
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 // public members
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,6 +184,21 @@ bool MPEG::Properties::isOriginal() const
   return d->isOriginal;
 }
 
+unsigned int MPEG::Properties::frameCount() const
+{
+  return d->frameCount;
+}
+
+int MPEG::Properties::encoderDelay() const
+{
+  return d->xingHeader ? d->xingHeader->encoderDelay() : 0;
+}
+
+int MPEG::Properties::encoderPadding() const
+{
+  return d->xingHeader ? d->xingHeader->encoderPadding() : 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,15 +233,44 @@ void MPEG::Properties::read(File *file, ReadStyle readStyle)
 
     d->length  = static_cast<int>(length + 0.5);
     d->bitrate = static_cast<int>(d->xingHeader->totalSize() * 8.0 / length + 0.5);
+    d->frameCount = d->xingHeader->totalFrames();
+  }
+  else if(readStyle == Accurate && firstHeader.samplesPerFrame() > 0 && firstHeader.sampleRate() > 0) {
+
+    // Without a VBR header, the bitrate of the first frame is not reliable
+    // for VBR streams and ADTS streams are usually VBR.  Count the frames up
+    // to the end of the last frame to get the exact length.  If sampling the
+    // stream shows a constant bitrate, the number of frames is calculated from
+    // the stream size and the average frame size instead of walking them.
+
+    const offset_t lastFrameOffset = file->lastFrameOffset();
+    offset_t streamEnd = file->length();
+    if(lastFrameOffset >= 0)
+      streamEnd = lastFrameOffset + Header(file, lastFrameOffset, false).frameLength();
+
+    unsigned long long streamSize = 0;
+    if(hasConstantBitrate(file, firstFrameOffset, streamEnd, lastFrameOffset, firstHeader)) {
+      const double frameSize = firstHeader.samplesPerFrame() / 8.0 *
+                               firstHeader.bitrate() * 1000.0 / firstHeader.sampleRate();
+      streamSize = streamEnd - firstFrameOffset;
+      d->frameCount = static_cast<unsigned int>(streamSize / frameSize + 0.5);
+    }
+    else {
+      countFrames(file, firstFrameOffset, streamEnd, firstHeader, d->frameCount, streamSize);
+    }
+
+    const double length = d->frameCount * firstHeader.samplesPerFrame() * 1000.0 /
+                          firstHeader.sampleRate();
+    if(length > 0) {
+      d->length  = static_cast<int>(length + 0.5);
+      d->bitrate = static_cast<int>(streamSize * 8.0 / length + 0.5);
+    }
   }
   else {
     int bitRate = firstHeader.bitrate();
     if(firstHeader.isADTS()) {
-      // ADTS is probably VBR, so to get the real length, we would have to go
-      // through all frames, count the frames in numFrames and sum their
-      // header.frameLength() to totalFrameSize, and finally calculate
-      // d->length = 1000LL * numFrames * firstHeader.samplesPerFrame() / firstHeader.sampleRate();
-      // d->bitrate = d->length > 0 ? totalFrameSize * 8 / d->length : 0;
+      // ADTS is probably VBR, so to get the real length, we have to go
+      // through all frames, which is done with the Accurate read style above.
       //
       // With Fast read style, we do not try to estimate the length and just set
       // it and the bitrate to zero.
@@ -191,23 +291,22 @@ void MPEG::Properties::read(File *file, ReadStyle readStyle)
         offset_t nextOffset;
         int numFrames = 1;
         int sameBytesPerFrameCount = 0;
-        while((nextOffset = file->nextFrameOffset(offset + header.frameLength())) > offset) {
+        FrameWalker walker(file);
+        while((nextOffset = walker.nextFrameOffset(offset + header.frameLength())) > offset) {
           offset = nextOffset;
-          header = Header(file, offset, false);
+          header = walker.header(offset);
           totalFrameSize += header.frameLength();
           ++numFrames;
           bytesPerFrame = totalFrameSize / numFrames;
-          if(readStyle != Accurate) {
-            if(bytesPerFrame == lastBytesPerFrame) {
-              if(++sameBytesPerFrameCount >= 10) {
-                break;
-              }
+          if(bytesPerFrame == lastBytesPerFrame) {
+            if(++sameBytesPerFrameCount >= 10) {
+              break;
             }
-            else {
-              sameBytesPerFrameCount = 0;
-            }
-            lastBytesPerFrame = bytesPerFrame;
           }
+          else {
+            sameBytesPerFrameCount = 0;
+          }
+          lastBytesPerFrame = bytesPerFrame;
         }
         bitRate = firstHeader.samplesPerFrame() != 0
           ? static_cast<int>(bytesPerFrame * 8 * firstHeader.sampleRate()
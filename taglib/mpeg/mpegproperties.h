@@ -129,6 +129,38 @@ namespace TagLib {
        */
       bool isOriginal() const;
 
+      /*!
+       * Returns the number of MPEG frames.  This is taken from the VBR header
+       * if available, otherwise the frames are only counted when the
+       * properties are read with the \c Accurate read style, so that the
+       * exact length and average bitrate of VBR streams without VBR header
+       * are known.  Returns 0 if the number of frames is unknown.
+       *
+       * \note With the \c Accurate read style, the bitrate of some frames
+       * spread over a stream without VBR header is checked first.  If it is
+       * the same for all of them, the stream is taken as CBR and the number of
+       * frames is calculated from its size, otherwise all frames are walked.
+       */
+      unsigned int frameCount() const;
+
+      /*!
+       * Returns the number of samples added by the encoder at the start of the
+       * stream, which have to be skipped for gapless playback.  This is only
+       * known if the VBR header has a LAME extension, otherwise 0 is returned.
+       *
+       * \see xingHeader()
+       */
+      int encoderDelay() const;
+
+      /*!
+       * Returns the number of samples added by the encoder at the end of the
+       * stream.  This is only known if the VBR header has a LAME extension,
+       * otherwise 0 is returned.
+       *
+       * \see xingHeader()
+       */
+      int encoderPadding() const;
+
     private:
       void read(File *file, ReadStyle readStyle);
 
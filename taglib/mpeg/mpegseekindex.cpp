@@ -0,0 +1,163 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "mpegseekindex.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "tbytevector.h"
+#include "tstring.h"
+#include "tvariant.h"
+#include "tserialization.h"
+#include "tdebug.h"
+
+using namespace TagLib;
+
+namespace
+{
+  // The rendered index is a serialized list of complex properties with a
+  // single map holding the sample rate and two lists with the sample
+  // positions and the offsets of the entries.
+
+  const char *const SampleRateKey = "sampleRate";
+  const char *const SamplesKey = "samples";
+  const char *const OffsetsKey = "offsets";
+}  // namespace
+
+class MPEG::SeekIndex::SeekIndexPrivate
+{
+public:
+  int sampleRate { 0 };
+  std::vector<Entry> entries;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+MPEG::SeekIndex::SeekIndex() :
+  d(std::make_shared<SeekIndexPrivate>())
+{
+}
+
+MPEG::SeekIndex::SeekIndex(int sampleRate, const EntryList &entries) :
+  d(std::make_shared<SeekIndexPrivate>())
+{
+  d->sampleRate = sampleRate;
+  d->entries.assign(entries.begin(), entries.end());
+}
+
+MPEG::SeekIndex::SeekIndex(const ByteVector &data) :
+  d(std::make_shared<SeekIndexPrivate>())
+{
+  List<VariantMap> maps;
+  if(!Serialization::deserialize(data, maps) || maps.size() != 1) {
+    debug("MPEG::SeekIndex::SeekIndex() -- Invalid seek index data.");
+    return;
+  }
+
+  const VariantMap &map = maps.front();
+  bool sampleRateOk = false;
+  bool samplesOk = false;
+  bool offsetsOk = false;
+  const int sampleRate = map.value(SampleRateKey).toInt(&sampleRateOk);
+  const VariantList samples = map.value(SamplesKey).toList(&samplesOk);
+  const VariantList offsets = map.value(OffsetsKey).toList(&offsetsOk);
+  if(!sampleRateOk || !samplesOk || !offsetsOk || samples.size() != offsets.size()) {
+    debug("MPEG::SeekIndex::SeekIndex() -- Invalid seek index data.");
+    return;
+  }
+
+  std::vector<Entry> entries;
+  entries.reserve(samples.size());
+
+  for(auto s = samples.cbegin(), o = offsets.cbegin(); s != samples.cend(); ++s, ++o) {
+    bool sampleOk = false;
+    bool offsetOk = false;
+    const long long sample = s->toLongLong(&sampleOk);
+    const offset_t offset = o->toLongLong(&offsetOk);
+    if(!sampleOk || !offsetOk || offset < 0 ||
+       (!entries.empty() &&
+        (sample <= entries.back().sample || offset <= entries.back().offset))) {
+      debug("MPEG::SeekIndex::SeekIndex() -- Seek index entries are not strictly increasing.");
+      return;
+    }
+    entries.emplace_back(sample, offset);
+  }
+
+  d->sampleRate = sampleRate;
+  d->entries = std::move(entries);
+}
+
+MPEG::SeekIndex::SeekIndex(const SeekIndex &) = default;
+MPEG::SeekIndex::~SeekIndex() = default;
+MPEG::SeekIndex &MPEG::SeekIndex::operator=(const SeekIndex &) = default;
+
+bool MPEG::SeekIndex::isEmpty() const
+{
+  return d->entries.empty();
+}
+
+int MPEG::SeekIndex::sampleRate() const
+{
+  return d->sampleRate;
+}
+
+MPEG::SeekIndex::EntryList MPEG::SeekIndex::entries() const
+{
+  EntryList entries;
+  for(const auto &entry : d->entries)
+    entries.append(entry);
+  return entries;
+}
+
+MPEG::SeekIndex::Entry MPEG::SeekIndex::find(long long sample) const
+{
+  if(d->entries.empty())
+    return Entry(0, -1);
+
+  auto it = std::upper_bound(d->entries.cbegin(), d->entries.cend(), sample,
+    [](long long s, const Entry &entry) { return s < entry.sample; });
+  if(it != d->entries.cbegin())
+    --it;
+  return *it;
+}
+
+ByteVector MPEG::SeekIndex::render() const
+{
+  VariantList samples;
+  VariantList offsets;
+  for(const auto &entry : d->entries) {
+    samples.append(entry.sample);
+    offsets.append(static_cast<long long>(entry.offset));
+  }
+
+  VariantMap map;
+  map.insert(SampleRateKey, d->sampleRate);
+  map.insert(SamplesKey, samples);
+  map.insert(OffsetsKey, offsets);
+  return Serialization::serialize(List<VariantMap>{map});
+}
@@ -0,0 +1,148 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_MPEGSEEKINDEX_H
+#define TAGLIB_MPEGSEEKINDEX_H
+
+#include <memory>
+
+#include "taglib.h"
+#include "taglib_export.h"
+#include "tlist.h"
+
+namespace TagLib {
+
+  class ByteVector;
+
+  namespace MPEG {
+
+    //! An index of seek points in an MPEG stream
+
+    /*!
+     * This maps sample positions to the byte offsets of the frames in the file
+     * which contain them, so that a decoder or a server streaming byte ranges
+     * can start at a point in time without decoding the stream from the
+     * start.  It is created using File::buildSeekIndex() and can be stored
+     * using render() to avoid building it again.
+     *
+     * \see File::buildSeekIndex()
+     */
+    class TAGLIB_EXPORT SeekIndex
+    {
+    public:
+      /*!
+       * A seek point.
+       */
+      struct Entry {
+        Entry(long long s, offset_t o) :
+          sample(s), offset(o) { }
+        /*!
+         * Sample position relative to the start of the stream.
+         */
+        long long sample;
+        /*!
+         * Offset of the frame in the file.
+         */
+        offset_t offset;
+      };
+
+      /*!
+       * List of seek points.
+       */
+      using EntryList = TagLib::List<Entry>;
+
+      /*!
+       * Constructs an empty seek index.
+       */
+      SeekIndex();
+
+      /*!
+       * Constructs a seek index for a stream with \a sampleRate containing
+       * \a entries, whose sample positions and offsets must be strictly
+       * increasing.
+       */
+      SeekIndex(int sampleRate, const EntryList &entries);
+
+      /*!
+       * Constructs a seek index from \a data as returned by render().  The
+       * index is empty if \a data is not a valid rendered seek index or if
+       * the sample positions or offsets of its entries are not strictly
+       * increasing.
+       */
+      explicit SeekIndex(const ByteVector &data);
+
+      /*!
+       * Makes a shallow copy of \a other.
+       */
+      SeekIndex(const SeekIndex &other);
+
+      /*!
+       * Destroys this SeekIndex instance.
+       */
+      ~SeekIndex();
+
+      /*!
+       * Makes a shallow copy of \a other.
+       */
+      SeekIndex &operator=(const SeekIndex &other);
+
+      /*!
+       * Returns \c true if the index does not contain any seek points.
+       */
+      bool isEmpty() const;
+
+      /*!
+       * Returns the sample rate of the stream, which can be used to convert
+       * times to sample positions.
+       */
+      int sampleRate() const;
+
+      /*!
+       * Returns the seek points sorted by their sample positions.
+       */
+      EntryList entries() const;
+
+      /*!
+       * Returns the last seek point at or before \a sample.  If the index is
+       * empty, an entry with an offset of -1 is returned.
+       */
+      Entry find(long long sample) const;
+
+      /*!
+       * Returns the binary representation of the index, which can be passed
+       * to SeekIndex(const ByteVector &).  The index is stored as a list of
+       * complex properties using Serialization::serialize().
+       */
+      ByteVector render() const;
+
+    private:
+      class SeekIndexPrivate;
+      TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+      std::shared_ptr<SeekIndexPrivate> d;
+    };
+  }  // namespace MPEG
+}  // namespace TagLib
+
+#endif
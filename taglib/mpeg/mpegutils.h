@@ -54,6 +54,23 @@ namespace TagLib
         return (b1 == 0xFF && b2 != 0xFF && (b2 & 0xE0) == 0xE0);
       }
 
+      /*!
+       * Returns \c true if the frame headers at \a offset in \a bytes and at
+       * \a nextOffset in \a nextBytes have the same MPEG version, layer and
+       * sample rate, i.e. they are likely to belong to the same stream.
+       *
+       * \note This does not check the length of the vectors, since this is an
+       * internal utility function.
+       */
+      inline bool isSameStream(const ByteVector &bytes, const ByteVector &nextBytes,
+                               unsigned int offset = 0, unsigned int nextOffset = 0)
+      {
+        constexpr unsigned int HeaderMask = 0xfffe0c00;
+
+        return (bytes.toUInt(offset, true) & HeaderMask) ==
+               (nextBytes.toUInt(nextOffset, true) & HeaderMask);
+      }
+
     }  // namespace
   }  // namespace MPEG
 }  // namespace TagLib
@@ -36,10 +36,34 @@ class MPEG::XingHeader::XingHeaderPrivate
 public:
   unsigned int frames { 0 };
   unsigned int size { 0 };
+  List<unsigned int> tableOfContents;
+  unsigned int framesPerTableEntry { 0 };
+  String encoderVersion;
+  int encoderDelay { 0 };
+  int encoderPadding { 0 };
+  unsigned int musicLength { 0 };
+  unsigned short musicCRC { 0 };
+  bool lameTagCRCValid { false };
 
   MPEG::XingHeader::HeaderType type { MPEG::XingHeader::Invalid };
 };
 
+namespace
+{
+  // CRC-16 with the polynomial 0x8005 in reversed bit order as used for the
+  // LAME tag.
+  unsigned short crc16(const ByteVector &data, unsigned int length)
+  {
+    unsigned short crc = 0;
+    for(unsigned int i = 0; i < length; ++i) {
+      crc ^= static_cast<unsigned char>(data[i]);
+      for(int j = 0; j < 8; ++j)
+        crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+    }
+    return crc;
+  }
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 // public members
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,6 +96,51 @@ MPEG::XingHeader::HeaderType MPEG::XingHeader::type() const
   return d->type;
 }
 
+List<unsigned int> MPEG::XingHeader::tableOfContents() const
+{
+  return d->tableOfContents;
+}
+
+unsigned int MPEG::XingHeader::framesPerTableEntry() const
+{
+  return d->framesPerTableEntry;
+}
+
+bool MPEG::XingHeader::hasLameExtension() const
+{
+  return !d->encoderVersion.isEmpty();
+}
+
+String MPEG::XingHeader::encoderVersion() const
+{
+  return d->encoderVersion;
+}
+
+int MPEG::XingHeader::encoderDelay() const
+{
+  return d->encoderDelay;
+}
+
+int MPEG::XingHeader::encoderPadding() const
+{
+  return d->encoderPadding;
+}
+
+unsigned int MPEG::XingHeader::musicLength() const
+{
+  return d->musicLength;
+}
+
+unsigned short MPEG::XingHeader::musicCRC() const
+{
+  return d->musicCRC;
+}
+
+bool MPEG::XingHeader::isLameTagCRCValid() const
+{
+  return d->lameTagCRCValid;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,6 +170,26 @@ void MPEG::XingHeader::parse(const ByteVector &data)
     d->frames = data.toUInt(offset + 8,  true);
     d->size   = data.toUInt(offset + 12, true);
     d->type   = Xing;
+
+    // The optional fields are only present if their flags are set.
+
+    const unsigned int flags = data.toUInt(offset + 4, true);
+    unsigned int pos = offset + 16;
+
+    if(flags & 0x04) {
+      if(data.size() < pos + 100) {
+        debug("MPEG::XingHeader::parse() -- Xing header TOC is too short.");
+        return;
+      }
+      for(unsigned int i = 0; i < 100; ++i)
+        d->tableOfContents.append(static_cast<unsigned char>(data[pos + i]));
+      pos += 100;
+    }
+
+    if(flags & 0x08)
+      pos += 4;
+
+    parseLameExtension(data, pos);
   }
   else {
 
@@ -120,6 +209,54 @@ void MPEG::XingHeader::parse(const ByteVector &data)
       d->frames = data.toUInt(offset + 14, true);
       d->size   = data.toUInt(offset + 10, true);
       d->type   = VBRI;
+
+      // The TOC contains the sizes of sections of framesPerTableEntry frames,
+      // which are stored with entrySize bytes and have to be multiplied by
+      // scale.
+
+      const unsigned int entryCount = data.toUShort(offset + 18, true);
+      const unsigned int scale      = data.toUShort(offset + 20, true);
+      const unsigned int entrySize  = data.toUShort(offset + 22, true);
+      const unsigned int tocOffset  = offset + 26;
+
+      if(entrySize < 1 || entrySize > 4 || data.size() < tocOffset + entryCount * entrySize) {
+        debug("MPEG::XingHeader::parse() -- VBRI header TOC is invalid or too short.");
+        return;
+      }
+
+      d->framesPerTableEntry = data.toUShort(offset + 24, true);
+      for(unsigned int i = 0; i < entryCount; ++i)
+        d->tableOfContents.append(data.toUInt(tocOffset + i * entrySize, entrySize, true) * scale);
     }
   }
 }
+
+void MPEG::XingHeader::parseLameExtension(const ByteVector &data, unsigned int offset)
+{
+  // The LAME extension follows the Xing header and has a size of 36 bytes.
+  // Other encoders such as FFmpeg write the same structure.
+
+  if(data.size() < offset + 36)
+    return;
+
+  const ByteVector version = data.mid(offset, 9);
+  if(!version.startsWith("LAME") && !version.startsWith("Lavf") &&
+     !version.startsWith("Lavc"))
+    return;
+
+  d->encoderVersion = String(version.mid(0, version.find('\0')), String::Latin1).stripWhiteSpace();
+
+  // The encoder delay and padding are stored as two 12 bit values.
+
+  const unsigned int delayPadding = data.toUInt(offset + 21, 3U, true);
+  d->encoderDelay   = static_cast<int>(delayPadding >> 12);
+  d->encoderPadding = static_cast<int>(delayPadding & 0x0FFF);
+
+  d->musicLength = data.toUInt(offset + 28, true);
+  d->musicCRC    = data.toUShort(offset + 32, true);
+
+  // The CRC of the LAME tag is calculated over the frame up to the CRC itself,
+  // data starts with the frame header.
+
+  d->lameTagCRCValid = crc16(data, offset + 34) == data.toUShort(offset + 34, true);
+}
@@ -29,6 +29,8 @@
 #include <memory>
 
 #include "taglib_export.h"
+#include "tlist.h"
+#include "tstring.h"
 #include "mpegheader.h"
 
 namespace TagLib {
@@ -108,8 +110,68 @@ namespace TagLib {
        */
       HeaderType type() const;
 
+      /*!
+       * Returns the table of contents of the VBR header, which can be used to
+       * find the position in the stream for a point in time.
+       *
+       * For a Xing header, it has 100 entries, entry \e i contains the
+       * position of \e i percent of the duration as a fraction of 256 of
+       * totalSize().  For a VBRI header, the entries are the sizes in bytes of
+       * consecutive sections of framesPerTableEntry() frames.  The list is
+       * empty if the header does not contain a table of contents.
+       */
+      List<unsigned int> tableOfContents() const;
+
+      /*!
+       * Returns the number of frames covered by each entry of
+       * tableOfContents() for a VBRI header, 0 for a Xing header.
+       */
+      unsigned int framesPerTableEntry() const;
+
+      /*!
+       * Returns \c true if the Xing header is followed by a LAME extension,
+       * which is also written by other encoders.
+       */
+      bool hasLameExtension() const;
+
+      /*!
+       * Returns the encoder version of the LAME extension, e.g. "LAME3.99r".
+       */
+      String encoderVersion() const;
+
+      /*!
+       * Returns the number of samples added by the encoder at the start of the
+       * stream, as stored in the LAME extension.  This and encoderPadding()
+       * are needed for gapless playback.
+       */
+      int encoderDelay() const;
+
+      /*!
+       * Returns the number of samples added by the encoder at the end of the
+       * stream, as stored in the LAME extension.
+       */
+      int encoderPadding() const;
+
+      /*!
+       * Returns the size in bytes of the stream including the frame containing
+       * the VBR header, as stored in the LAME extension.
+       */
+      unsigned int musicLength() const;
+
+      /*!
+       * Returns the CRC-16 of the audio data, as stored in the LAME extension.
+       */
+      unsigned short musicCRC() const;
+
+      /*!
+       * Returns \c true if the CRC-16 stored in the LAME extension matches the
+       * data of the frame up to the CRC.
+       */
+      bool isLameTagCRCValid() const;
+
     private:
       void parse(const ByteVector &data);
+      void parseLameExtension(const ByteVector &data, unsigned int offset);
 
       class XingHeaderPrivate;
       TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
@@ -105,14 +105,49 @@ Properties *Ogg::FLAC::File::audioProperties() const
 }
 
 bool Ogg::FLAC::File::save()
+{
+  setCommentPacket();
+
+  return Ogg::File::save();
+}
+
+bool Ogg::FLAC::File::isModified() const
+{
+  const offset_t position = tell();
+  const bool modified = Ogg::File::isModified() ||
+                        isPacketModified(d->commentPacket, renderCommentPacket());
+  stream()->seek(position);
+  return modified;
+}
+
+bool Ogg::FLAC::File::hasXiphComment() const
+{
+  return d->hasXiphComment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// private members
+////////////////////////////////////////////////////////////////////////////////
+
+void Ogg::FLAC::File::setCommentPacket()
 {
   d->xiphCommentData = d->comment->render(false);
 
+  // Save the packet at the old spot
+  // FIXME: Use padding if size is increasing
+
+  setPacket(d->commentPacket, renderCommentPacket());
+}
+
+ByteVector Ogg::FLAC::File::renderCommentPacket() const
+{
+  const ByteVector commentData = d->comment->render(false);
+
   // Create FLAC metadata-block:
 
   // Put the size in the first 32 bit (I assume no more than 24 bit are used)
 
-  ByteVector v = ByteVector::fromUInt(d->xiphCommentData.size());
+  ByteVector v = ByteVector::fromUInt(commentData.size());
 
   // Set the type of the metadata-block to be a Xiph / Vorbis comment
 
@@ -120,25 +155,11 @@ bool Ogg::FLAC::File::save()
 
   // Append the comment-data after the 32 bit header
 
-  v.append(d->xiphCommentData);
+  v.append(commentData);
 
-  // Save the packet at the old spot
-  // FIXME: Use padding if size is increasing
-
-  setPacket(d->commentPacket, v);
-
-  return Ogg::File::save();
+  return v;
 }
 
-bool Ogg::FLAC::File::hasXiphComment() const
-{
-  return d->hasXiphComment;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-// private members
-////////////////////////////////////////////////////////////////////////////////
-
 void Ogg::FLAC::File::read(bool readProperties, Properties::ReadStyle propertiesStyle)
 {
   // Sanity: Check if we really have an Ogg/FLAC file
@@ -167,7 +188,7 @@ void Ogg::FLAC::File::read(bool readProperties, Properties::ReadStyle properties
   else
     d->comment = std::make_unique<Ogg::XiphComment>();
 
-  if(readProperties)
+  if(readProperties && propertiesStyle != Properties::TagsOnly)
     d->properties = std::make_unique<Properties>(streamInfoData(), streamLength(), propertiesStyle);
 }
 
@@ -132,6 +132,14 @@ namespace TagLib {
        */
       bool save() override;
 
+      /*!
+       * Returns \c true if the comment header differs from the one stored in
+       * the file.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * Returns the length of the audio-stream, used by FLAC::Properties for
        * calculating the bitrate.
@@ -154,6 +162,8 @@ namespace TagLib {
       static bool isSupported(IOStream *stream);
 
     private:
+      void setCommentPacket();
+      ByteVector renderCommentPacket() const;
       void read(bool readProperties, Properties::ReadStyle propertiesStyle);
       void scan();
       ByteVector streamInfoData();
@@ -73,35 +73,7 @@ ByteVector Ogg::File::packet(unsigned int i)
   if(d->dirtyPackets.contains(i))
     return d->dirtyPackets[i];
 
-  // If we haven't indexed the page where the packet we're interested in starts,
-  // begin reading pages until we have.
-
-  if(!readPages(i)) {
-    debug("Ogg::File::packet() -- Could not find the requested packet.");
-    return ByteVector();
-  }
-
-  // Look for the first page in which the requested packet starts.
-
-  auto it = d->pages.cbegin();
-  while((*it)->containsPacket(i) == Page::DoesNotContainPacket)
-    ++it;
-
-  // If the packet is completely contained in the first page that it's in.
-
-  // If the packet is *not* completely contained in the first page that it's a
-  // part of then that packet trails off the end of the page.  Continue appending
-  // the pages' packet data until we hit a page that either does not end with the
-  // packet that we're fetching or where the last packet is complete.
-
-  ByteVector packet = (*it)->packets()[i - (*it)->firstPacketIndex()];
-
-  while(nextPacketIndex(*it) <= i) {
-    ++it;
-    packet.append((*it)->packets().front());
-  }
-
-  return packet;
+  return readPacket(i);
 }
 
 void Ogg::File::setPacket(unsigned int i, const ByteVector &p)
@@ -147,14 +119,32 @@ bool Ogg::File::save()
     return false;
   }
 
-  for(const auto &[i, pkt] : std::as_const(d->dirtyPackets))
-    writePacket(i, pkt);
+  for(const auto &[i, pkt] : std::as_const(d->dirtyPackets)) {
+    if(pkt != readPacket(i))
+      writePacket(i, pkt);
+  }
 
   d->dirtyPackets.clear();
 
   return true;
 }
 
+bool Ogg::File::isModified() const
+{
+  // The stream is shared with the file, its position is restored.
+
+  const offset_t position = tell();
+  bool modified = false;
+  for(const auto &[i, pkt] : std::as_const(d->dirtyPackets)) {
+    if(pkt != readPacket(i)) {
+      modified = true;
+      break;
+    }
+  }
+  stream()->seek(position);
+  return modified;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
@@ -171,10 +161,63 @@ Ogg::File::File(IOStream *stream) :
 {
 }
 
+void Ogg::File::setPaddedPacket(unsigned int i, const ByteVector &p)
+{
+  setPacket(i, paddedPacket(i, p));
+}
+
+bool Ogg::File::isPacketModified(unsigned int i, const ByteVector &p, bool padded) const
+{
+  return (padded ? paddedPacket(i, p) : p) != readPacket(i);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
+ByteVector Ogg::File::readPacket(unsigned int i) const
+{
+  // If we haven't indexed the page where the packet we're interested in starts,
+  // begin reading pages until we have.  This only adds them to the cache of
+  // pages, so it is done for const files, too.
+
+  if(!const_cast<File *>(this)->readPages(i)) {
+    debug("Ogg::File::readPacket() -- Could not find the requested packet.");
+    return ByteVector();
+  }
+
+  // Look for the first page in which the requested packet starts.
+
+  auto it = d->pages.cbegin();
+  while((*it)->containsPacket(i) == Page::DoesNotContainPacket)
+    ++it;
+
+  // If the packet is completely contained in the first page that it's in.
+
+  // If the packet is *not* completely contained in the first page that it's a
+  // part of then that packet trails off the end of the page.  Continue appending
+  // the pages' packet data until we hit a page that either does not end with the
+  // packet that we're fetching or where the last packet is complete.
+
+  ByteVector packet = (*it)->packets()[i - (*it)->firstPacketIndex()];
+
+  while(nextPacketIndex(*it) <= i) {
+    ++it;
+    packet.append((*it)->packets().front());
+  }
+
+  return packet;
+}
+
+ByteVector Ogg::File::paddedPacket(unsigned int i, const ByteVector &p) const
+{
+  const offset_t available = static_cast<offset_t>(readPacket(i).size()) - p.size();
+  const offset_t padding = paddingPolicy().padding(
+    available, stream()->length(), 0, PaddingPolicy::AlwaysShrink);
+
+  return p + ByteVector(static_cast<unsigned int>(padding), '\0');
+}
+
 bool Ogg::File::readPages(unsigned int i)
 {
   while(true) {
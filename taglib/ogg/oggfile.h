@@ -83,6 +83,15 @@ namespace TagLib {
 
       bool save() override;
 
+      /*!
+       * Returns \c true if a packet set with setPacket() differs from the
+       * packet stored in the file.  Packets which are unchanged are not written
+       * by save().
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
     protected:
       /*!
        * Constructs an Ogg file from \a file.
@@ -105,6 +114,27 @@ namespace TagLib {
        */
       File(IOStream *stream);
 
+      /*!
+       * Sets the packet with index \a i to the value \a p followed by null
+       * bytes of padding as determined by paddingPolicy().  This is only
+       * possible for packets which may contain trailing data, such as the
+       * comment headers of Vorbis, Opus and Speex.  By default, no padding is
+       * added.
+       *
+       * If the padding fills the size of the existing packet, the pages
+       * containing it can be rewritten without moving the rest of the file.
+       */
+      void setPaddedPacket(unsigned int i, const ByteVector &p);
+
+      /*!
+       * Returns \c true if \a p differs from the packet with index \a i
+       * stored in the file.  If \a padded is \c true, \a p is compared
+       * followed by the padding which setPaddedPacket() would add.  This does
+       * not set the packet.
+       */
+      bool isPacketModified(unsigned int i, const ByteVector &p,
+                            bool padded = false) const;
+
     private:
       /*!
        * Reads the pages from the beginning of the file until enough to compose
@@ -112,6 +142,17 @@ namespace TagLib {
        */
       bool readPages(unsigned int i);
 
+      /*!
+       * Reads the requested packet from the file, ignoring packets set with
+       * setPacket().
+       */
+      ByteVector readPacket(unsigned int i) const;
+
+      /*!
+       * Returns \a p followed by the padding added by setPaddedPacket().
+       */
+      ByteVector paddedPacket(unsigned int i, const ByteVector &p) const;
+
       /*!
        * Writes the requested packet to the file.
        */
@@ -59,20 +59,20 @@ bool Ogg::Opus::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-Opus::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+Opus::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-Opus::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
+Opus::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 Opus::File::~File() = default;
@@ -99,18 +99,38 @@ Opus::Properties *Opus::File::audioProperties() const
 
 bool Opus::File::save()
 {
-  if(!d->comment)
-    d->comment = std::make_unique<Ogg::XiphComment>();
-
-  setPacket(1, ByteVector("OpusTags", 8) + d->comment->render(false));
+  setCommentPacket();
 
   return Ogg::File::save();
 }
 
+bool Opus::File::isModified() const
+{
+  const offset_t position = tell();
+  const bool modified = Ogg::File::isModified() ||
+                        isPacketModified(1, renderCommentPacket(), true);
+  stream()->seek(position);
+  return modified;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
+void Opus::File::setCommentPacket()
+{
+  if(!d->comment)
+    d->comment = std::make_unique<Ogg::XiphComment>();
+
+  setPaddedPacket(1, renderCommentPacket());
+}
+
+ByteVector Opus::File::renderCommentPacket() const
+{
+  return ByteVector("OpusTags", 8) +
+    (d->comment ? d->comment->render(false) : Ogg::XiphComment().render(false));
+}
+
 void Opus::File::read(bool readProperties)
 {
   ByteVector opusHeaderData = packet(0);
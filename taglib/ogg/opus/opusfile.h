@@ -115,6 +115,14 @@ namespace TagLib {
          */
         bool save() override;
 
+        /*!
+         * Returns \c true if the comment header differs from the one stored in
+         * the file.
+         *
+         * \see TagLib::File::isModified()
+         */
+        bool isModified() const override;
+
         /*!
          * Returns whether or not the given \a stream can be opened as an Opus
          * file.
@@ -125,6 +133,8 @@ namespace TagLib {
         static bool isSupported(IOStream *stream);
 
       private:
+        void setCommentPacket();
+        ByteVector renderCommentPacket() const;
         void read(bool readProperties);
 
         class FilePrivate;
@@ -59,20 +59,20 @@ bool Ogg::Speex::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-Speex::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+Speex::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-Speex::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
+Speex::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 Speex::File::~File() = default;
@@ -99,18 +99,37 @@ Speex::Properties *Speex::File::audioProperties() const
 
 bool Speex::File::save()
 {
-  if(!d->comment)
-    d->comment = std::make_unique<Ogg::XiphComment>();
-
-  setPacket(1, d->comment->render());
+  setCommentPacket();
 
   return Ogg::File::save();
 }
 
+bool Speex::File::isModified() const
+{
+  const offset_t position = tell();
+  const bool modified = Ogg::File::isModified() ||
+                        isPacketModified(1, renderCommentPacket(), true);
+  stream()->seek(position);
+  return modified;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
+void Speex::File::setCommentPacket()
+{
+  if(!d->comment)
+    d->comment = std::make_unique<Ogg::XiphComment>();
+
+  setPaddedPacket(1, renderCommentPacket());
+}
+
+ByteVector Speex::File::renderCommentPacket() const
+{
+  return d->comment ? d->comment->render() : Ogg::XiphComment().render();
+}
+
 void Speex::File::read(bool readProperties)
 {
   ByteVector speexHeaderData = packet(0);
@@ -62,20 +62,20 @@ bool Vorbis::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-Vorbis::File::File(FileName file, bool readProperties, Properties::ReadStyle) :
+Vorbis::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(file),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-Vorbis::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle) :
+Vorbis::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle) :
   Ogg::File(stream),
   d(std::make_unique<FilePrivate>())
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 Vorbis::File::~File() = default;
@@ -102,21 +102,39 @@ Vorbis::Properties *Vorbis::File::audioProperties() const
 
 bool Vorbis::File::save()
 {
-  ByteVector v(vorbisCommentHeaderID);
-
-  if(!d->comment)
-    d->comment = std::make_unique<Ogg::XiphComment>();
-  v.append(d->comment->render());
-
-  setPacket(1, v);
+  setCommentPacket();
 
   return Ogg::File::save();
 }
 
+bool Vorbis::File::isModified() const
+{
+  const offset_t position = tell();
+  const bool modified = Ogg::File::isModified() ||
+                        isPacketModified(1, renderCommentPacket(), true);
+  stream()->seek(position);
+  return modified;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // private members
 ////////////////////////////////////////////////////////////////////////////////
 
+void Vorbis::File::setCommentPacket()
+{
+  if(!d->comment)
+    d->comment = std::make_unique<Ogg::XiphComment>();
+
+  setPaddedPacket(1, renderCommentPacket());
+}
+
+ByteVector Vorbis::File::renderCommentPacket() const
+{
+  ByteVector v(vorbisCommentHeaderID);
+  v.append(d->comment ? d->comment->render() : Ogg::XiphComment().render());
+  return v;
+}
+
 void Vorbis::File::read(bool readProperties)
 {
   ByteVector commentHeaderData = packet(1);
@@ -125,6 +125,14 @@ namespace TagLib {
        */
       bool save() override;
 
+      /*!
+       * Returns \c true if the comment header differs from the one stored in
+       * the file.
+       *
+       * \see TagLib::File::isModified()
+       */
+      bool isModified() const override;
+
       /*!
        * Check if the given \a stream can be opened as an Ogg Vorbis file.
        *
@@ -134,6 +142,8 @@ namespace TagLib {
       static bool isSupported(IOStream *stream);
 
     private:
+      void setCommentPacket();
+      ByteVector renderCommentPacket() const;
       void read(bool readProperties);
 
       class FilePrivate;
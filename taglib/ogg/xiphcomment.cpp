@@ -126,6 +126,45 @@ unsigned int Ogg::XiphComment::track() const
   return 0;
 }
 
+void Ogg::XiphComment::basicFields(BasicFields &fields) const
+{
+  // The field lists are accessed by reference instead of copying them as
+  // the accessors do.
+
+  const auto values = [this](const char *key) -> const StringList * {
+    const auto it = d->fieldListMap.find(key);
+    return it != d->fieldListMap.end() && !it->second.isEmpty() ? &it->second : nullptr;
+  };
+  const auto text = [&values](const char *key) {
+    const StringList *val = values(key);
+    return val ? joinTagValues(*val) : String();
+  };
+
+  fields.title = text("TITLE");
+  fields.artist = text("ARTIST");
+  fields.album = text("ALBUM");
+  fields.genre = text("GENRE");
+
+  fields.comment = String();
+  for(const char *key : {"DESCRIPTION", "COMMENT"}) {
+    if(const StringList *val = values(key)) {
+      d->commentField = key;
+      fields.comment = joinTagValues(*val);
+      break;
+    }
+  }
+
+  const StringList *date = values("DATE");
+  if(!date)
+    date = values("YEAR");
+  fields.year = date ? date->front().toInt() : 0;
+
+  const StringList *track = values("TRACKNUMBER");
+  if(!track)
+    track = values("TRACKNUM");
+  fields.track = track ? track->front().toInt() : 0;
+}
+
 void Ogg::XiphComment::setTitle(const String &s)
 {
   addField("TITLE", s);
@@ -65,22 +65,22 @@ bool RIFF::AIFF::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-RIFF::AIFF::File::File(FileName file, bool readProperties, Properties::ReadStyle,
+RIFF::AIFF::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle,
                        ID3v2::FrameFactory *frameFactory) :
   RIFF::File(file, BigEndian),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-RIFF::AIFF::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle,
+RIFF::AIFF::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle,
                        ID3v2::FrameFactory *frameFactory) :
   RIFF::File(stream, BigEndian),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 RIFF::AIFF::File::~File() = default;
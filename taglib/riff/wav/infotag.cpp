@@ -120,6 +120,29 @@ unsigned int RIFF::Info::Tag::track() const
   return fieldText("IPRT").toInt();
 }
 
+void RIFF::Info::Tag::basicFields(BasicFields &fields) const
+{
+  // A single pass over the fields, the map of an INFO chunk is small.
+
+  fields = BasicFields();
+  for(const auto &[id, text] : std::as_const(d->fieldListMap)) {
+    if(id == "INAM")
+      fields.title = text;
+    else if(id == "IART")
+      fields.artist = text;
+    else if(id == "IPRD")
+      fields.album = text;
+    else if(id == "ICMT")
+      fields.comment = text;
+    else if(id == "IGNR")
+      fields.genre = text;
+    else if(id == "ICRD")
+      fields.year = text.substr(0, 4).toInt();
+    else if(id == "IPRT")
+      fields.track = text.toInt();
+  }
+}
+
 void RIFF::Info::Tag::setTitle(const String &s)
 {
   setFieldText("INAM", s);
@@ -119,6 +119,7 @@ namespace TagLib {
       String genre() const override;
       unsigned int year() const override;
       unsigned int track() const override;
+      void basicFields(BasicFields &fields) const override;
 
       void setTitle(const String &s) override;
       void setArtist(const String &s) override;
@@ -73,22 +73,22 @@ bool RIFF::WAV::File::isSupported(IOStream *stream)
 // public members
 ////////////////////////////////////////////////////////////////////////////////
 
-RIFF::WAV::File::File(FileName file, bool readProperties, Properties::ReadStyle,
+RIFF::WAV::File::File(FileName file, bool readProperties, Properties::ReadStyle readStyle,
                       ID3v2::FrameFactory *frameFactory) :
   RIFF::File(file, LittleEndian),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
-RIFF::WAV::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle,
+RIFF::WAV::File::File(IOStream *stream, bool readProperties, Properties::ReadStyle readStyle,
                       ID3v2::FrameFactory *frameFactory) :
   RIFF::File(stream, LittleEndian),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 RIFF::WAV::File::~File() = default;
@@ -209,9 +209,12 @@ void RIFF::WAV::File::read(bool readProperties)
       }
     }
     else if(name == "LIST") {
-      if(const ByteVector data = chunkData(i); data.startsWith("INFO")) {
+      // Check the list type before reading the whole chunk, other lists
+      // like "adtl" can be large.
+      seek(chunkOffset(i));
+      if(readBlock(4) == "INFO") {
         if(!d->tag[InfoIndex]) {
-          d->tag.set(InfoIndex, new RIFF::Info::Tag(data));
+          d->tag.set(InfoIndex, new RIFF::Info::Tag(chunkData(i)));
           d->hasInfo = true;
         }
         else {
@@ -37,19 +37,21 @@ using namespace S3M;
 class S3M::File::FilePrivate
 {
 public:
-  FilePrivate(AudioProperties::ReadStyle propertiesStyle)
-    : properties(propertiesStyle)
+  FilePrivate(bool readAudioProperties, AudioProperties::ReadStyle propertiesStyle)
+    : properties(propertiesStyle),
+      readProperties(readAudioProperties && propertiesStyle != AudioProperties::TagsOnly)
   {
   }
 
   Mod::Tag        tag;
   S3M::Properties properties;
+  bool readProperties;
 };
 
 S3M::File::File(FileName file, bool readProperties,
                 AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(file),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -58,7 +60,7 @@ S3M::File::File(FileName file, bool readProperties,
 S3M::File::File(IOStream *stream, bool readProperties,
                 AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(stream),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -83,7 +85,7 @@ PropertyMap S3M::File::setProperties(const PropertyMap &properties)
 
 S3M::Properties *S3M::File::audioProperties() const
 {
-  return &d->properties;
+  return d->readProperties ? &d->properties : nullptr;
 }
 
 bool S3M::File::save()
@@ -51,6 +51,17 @@ bool Tag::isEmpty() const
          track() == 0;
 }
 
+void Tag::basicFields(BasicFields &fields) const
+{
+  fields.title = title();
+  fields.artist = artist();
+  fields.album = album();
+  fields.comment = comment();
+  fields.genre = genre();
+  fields.year = year();
+  fields.track = track();
+}
+
 PropertyMap Tag::properties() const
 {
   PropertyMap map;
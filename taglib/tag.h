@@ -49,6 +49,20 @@ namespace TagLib {
   {
   public:
 
+    /*!
+     * The values of the basic fields of a tag, as returned by title(),
+     * artist(), album(), comment(), genre(), year() and track().
+     */
+    struct BasicFields {
+      String title;
+      String artist;
+      String album;
+      String comment;
+      String genre;
+      unsigned int year { 0 };
+      unsigned int track { 0 };
+    };
+
     /*!
      * Destroys this Tag instance.
      */
@@ -164,6 +178,14 @@ namespace TagLib {
      */
     virtual unsigned int track() const = 0;
 
+    /*!
+     * Sets \a fields to the values returned by title(), artist(), album(),
+     * comment(), genre(), year() and track().  The tag implementations
+     * reimplement this to look up their fields only once, which is faster
+     * than calling the accessors one by one, e.g. to fill a list view.
+     */
+    virtual void basicFields(BasicFields &fields) const;
+
     /*!
      * Sets the title to \a s.  If \a s is an empty string then this value will be
      * cleared.
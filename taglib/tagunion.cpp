@@ -34,23 +34,23 @@ using namespace TagLib;
 
 #define stringUnion(method)                                               \
   do {                                                                    \
-    if(tag(0) && !tag(0)->method().isEmpty())                             \
-      return tag(0)->method();                                            \
-    if(tag(1) && !tag(1)->method().isEmpty())                             \
-      return tag(1)->method();                                            \
-    if(tag(2) && !tag(2)->method().isEmpty())                             \
-      return tag(2)->method();                                            \
+    for(const Tag *t : d->tags) {                                         \
+      if(t) {                                                             \
+        if(String value = t->method(); !value.isEmpty())                  \
+          return value;                                                   \
+      }                                                                   \
+    }                                                                     \
     return String();                                                      \
   } while(0)
 
 #define numberUnion(method)                                               \
   do {                                                                    \
-    if(tag(0) && tag(0)->method() > 0)                                    \
-      return tag(0)->method();                                            \
-    if(tag(1) && tag(1)->method() > 0)                                    \
-      return tag(1)->method();                                            \
-    if(tag(2) && tag(2)->method() > 0)                                    \
-      return tag(2)->method();                                            \
+    for(const Tag *t : d->tags) {                                         \
+      if(t) {                                                             \
+        if(unsigned int value = t->method(); value > 0)                   \
+          return value;                                                   \
+      }                                                                   \
+    }                                                                     \
     return 0;                                                             \
   } while(0)
 
@@ -106,10 +106,18 @@ void TagUnion::set(int index, Tag *tag)
 
 PropertyMap TagUnion::properties() const
 {
-  auto it = std::find_if(d->tags.cbegin(), d->tags.cend(), [](const Tag *t) {
-    return t && !t->isEmpty();
-  });
-  return it != d->tags.cend() ? (*it)->properties() : PropertyMap();
+  // The properties of the first tag which is not empty are returned.  As
+  // building them is usually as expensive as checking the tag, isEmpty() is
+  // only called if the tag has no properties.
+
+  for(const auto &t : d->tags) {
+    if(!t)
+      continue;
+    if(PropertyMap properties = t->properties();
+       !properties.isEmpty() || !properties.unsupportedData().isEmpty() || !t->isEmpty())
+      return properties;
+  }
+  return PropertyMap();
 }
 
 void TagUnion::removeUnsupportedProperties(const StringList &unsupported)
@@ -233,3 +241,35 @@ bool TagUnion::isEmpty() const
 {
   return std::none_of(d->tags.begin(), d->tags.end(), [](auto t) { return t && !t->isEmpty(); });
 }
+
+void TagUnion::basicFields(BasicFields &fields) const
+{
+  fields = BasicFields();
+  for(const auto &t : d->tags) {
+    if(!t)
+      continue;
+
+    BasicFields tagFields;
+    t->basicFields(tagFields);
+
+    if(fields.title.isEmpty())
+      fields.title = tagFields.title;
+    if(fields.artist.isEmpty())
+      fields.artist = tagFields.artist;
+    if(fields.album.isEmpty())
+      fields.album = tagFields.album;
+    if(fields.comment.isEmpty())
+      fields.comment = tagFields.comment;
+    if(fields.genre.isEmpty())
+      fields.genre = tagFields.genre;
+    if(fields.year == 0)
+      fields.year = tagFields.year;
+    if(fields.track == 0)
+      fields.track = tagFields.track;
+
+    if(!fields.title.isEmpty() && !fields.artist.isEmpty() &&
+       !fields.album.isEmpty() && !fields.comment.isEmpty() &&
+       !fields.genre.isEmpty() && fields.year > 0 && fields.track > 0)
+      break;
+  }
+}
@@ -83,6 +83,13 @@ namespace TagLib {
     void setTrack(unsigned int i) override;
     bool isEmpty() const override;
 
+    /*!
+     * Sets \a fields to the values of all basic fields.  Each field is taken
+     * from the first tag where it is not empty, the tags are only accessed
+     * until all fields are set.
+     */
+    void basicFields(BasicFields &fields) const override;
+
     template <class T> T *access(int index, bool create)
     {
       if(!create || tag(index))
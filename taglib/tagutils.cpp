@@ -89,6 +89,55 @@ offset_t Utils::findAPE(File *file, offset_t id3v1Location)
   return -1;
 }
 
+ByteVector Utils::readTail(File *file, offset_t *tailOffset)
+{
+  if(!file->isValid())
+    return ByteVector();
+
+  // An ID3v1 tag (128 bytes) preceded by an APE footer (32 bytes)
+
+  const offset_t length = file->length();
+  const offset_t offset = length > 160 ? length - 160 : 0;
+
+  file->seek(offset);
+  const ByteVector tail = file->readBlock(static_cast<unsigned long>(length - offset));
+
+  if(tailOffset)
+    *tailOffset = offset;
+
+  return tail;
+}
+
+offset_t Utils::findID3v1(const ByteVector &tail, offset_t tailOffset)
+{
+  if(tail.size() < 128)
+    return -1;
+
+  // Differentiate between a match of APEv2 magic and a match of ID3v1 magic.
+
+  const unsigned int p = tail.size() - 128;
+
+  if(!tail.containsAt(ID3v1::Tag::fileIdentifier(), p))
+    return -1;
+
+  if(p >= 3 && tail.mid(p - 3, 8) == APE::Tag::fileIdentifier())
+    return -1;
+
+  return tailOffset + p;
+}
+
+offset_t Utils::findAPE(const ByteVector &tail, offset_t tailOffset, offset_t id3v1Location)
+{
+  const offset_t end = id3v1Location >= 0 ? id3v1Location : tailOffset + tail.size();
+  const offset_t p = end - 32;
+
+  if(p < tailOffset ||
+     !tail.containsAt(APE::Tag::fileIdentifier(), static_cast<unsigned int>(p - tailOffset)))
+    return -1;
+
+  return p;
+}
+
 ByteVector TagLib::Utils::readHeader(IOStream *stream, unsigned int length,
                                      bool skipID3v2, offset_t *headerOffset)
 {
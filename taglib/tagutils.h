@@ -46,6 +46,15 @@ namespace TagLib {
 
     offset_t findAPE(File *file, offset_t id3v1Location);
 
+    // Reads the block at the end of the file which can hold an ID3v1 tag and
+    // an APE footer, the functions below look for the tags in this block.
+
+    ByteVector readTail(File *file, offset_t *tailOffset);
+
+    offset_t findID3v1(const ByteVector &tail, offset_t tailOffset);
+
+    offset_t findAPE(const ByteVector &tail, offset_t tailOffset, offset_t id3v1Location);
+
     ByteVector readHeader(IOStream *stream, unsigned int length, bool skipID3v2,
                           offset_t *headerOffset = nullptr);
   }  // namespace Utils
@@ -0,0 +1,249 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "tbudgetstream.h"
+
+#include <atomic>
+#include <chrono>
+
+#include "tstring.h"
+#include "tdebug.h"
+
+using namespace TagLib;
+
+class CancellationToken::CancellationTokenPrivate
+{
+public:
+  std::atomic<bool> cancelled { false };
+};
+
+class BudgetStream::BudgetStreamPrivate
+{
+public:
+  BudgetStreamPrivate(IOStream *stream) :
+    stream(stream)
+  {
+  }
+
+  // Checks the limits which do not depend on the operation.
+  bool check()
+  {
+    if(writing)
+      return true;
+
+    if(exhausted)
+      return false;
+
+    if(token && token->isCancelled()) {
+      debug("BudgetStream -- I/O has been cancelled.");
+      exhausted = true;
+    }
+    else if(hasDeadline && std::chrono::steady_clock::now() >= deadline) {
+      debug("BudgetStream -- Timeout expired.");
+      exhausted = true;
+    }
+
+    return !exhausted;
+  }
+
+  // Checks if a write operation can be started.  The limits are not enforced
+  // anymore once the stream is written, so that a file is never left
+  // partially modified.
+  bool startWrite()
+  {
+    if(!check()) {
+      debug("BudgetStream -- Not writing to a stream with an exhausted budget.");
+      return false;
+    }
+
+    writing = true;
+    return true;
+  }
+
+  IOStream *stream;
+  const CancellationToken *token { nullptr };
+  offset_t maxBytesRead { 0 };
+  offset_t bytesRead { 0 };
+  unsigned int maxSeeks { 0 };
+  unsigned int seekCount { 0 };
+  std::chrono::steady_clock::time_point deadline;
+  bool hasDeadline { false };
+  bool exhausted { false };
+  bool writing { false };
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// CancellationToken
+////////////////////////////////////////////////////////////////////////////////
+
+CancellationToken::CancellationToken() :
+  d(std::make_unique<CancellationTokenPrivate>())
+{
+}
+
+CancellationToken::~CancellationToken() = default;
+
+void CancellationToken::cancel()
+{
+  d->cancelled = true;
+}
+
+bool CancellationToken::isCancelled() const
+{
+  return d->cancelled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+BudgetStream::BudgetStream(IOStream *stream) :
+  d(std::make_unique<BudgetStreamPrivate>(stream))
+{
+}
+
+BudgetStream::~BudgetStream() = default;
+
+void BudgetStream::setMaxBytesRead(offset_t bytes)
+{
+  d->maxBytesRead = bytes;
+}
+
+void BudgetStream::setMaxSeeks(unsigned int seeks)
+{
+  d->maxSeeks = seeks;
+}
+
+void BudgetStream::setTimeout(unsigned int milliseconds)
+{
+  d->hasDeadline = milliseconds > 0;
+  d->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+}
+
+void BudgetStream::setCancellationToken(const CancellationToken *token)
+{
+  d->token = token;
+}
+
+bool BudgetStream::isExhausted() const
+{
+  return d->exhausted;
+}
+
+offset_t BudgetStream::bytesRead() const
+{
+  return d->bytesRead;
+}
+
+unsigned int BudgetStream::seekCount() const
+{
+  return d->seekCount;
+}
+
+FileName BudgetStream::name() const
+{
+  return d->stream->name();
+}
+
+ByteVector BudgetStream::readBlock(size_t length)
+{
+  if(!d->check())
+    return ByteVector();
+
+  if(!d->writing && d->maxBytesRead > 0 &&
+     d->bytesRead + static_cast<offset_t>(length) > d->maxBytesRead) {
+    debug("BudgetStream::readBlock() -- Maximum number of bytes read.");
+    d->exhausted = true;
+    return ByteVector();
+  }
+
+  ByteVector data = d->stream->readBlock(length);
+  d->bytesRead += data.size();
+  return data;
+}
+
+void BudgetStream::writeBlock(const ByteVector &data)
+{
+  if(d->startWrite())
+    d->stream->writeBlock(data);
+}
+
+void BudgetStream::insert(const ByteVector &data, offset_t start, size_t replace)
+{
+  if(d->startWrite())
+    d->stream->insert(data, start, replace);
+}
+
+void BudgetStream::removeBlock(offset_t start, size_t length)
+{
+  if(d->startWrite())
+    d->stream->removeBlock(start, length);
+}
+
+bool BudgetStream::readOnly() const
+{
+  return d->exhausted || d->stream->readOnly();
+}
+
+bool BudgetStream::isOpen() const
+{
+  return d->stream->isOpen();
+}
+
+void BudgetStream::seek(offset_t offset, Position p)
+{
+  if(!d->check())
+    return;
+
+  if(!d->writing && d->maxSeeks > 0 && d->seekCount >= d->maxSeeks) {
+    debug("BudgetStream::seek() -- Maximum number of seeks done.");
+    d->exhausted = true;
+    return;
+  }
+
+  ++d->seekCount;
+  d->stream->seek(offset, p);
+}
+
+void BudgetStream::clear()
+{
+  d->stream->clear();
+}
+
+offset_t BudgetStream::tell() const
+{
+  return d->stream->tell();
+}
+
+offset_t BudgetStream::length()
+{
+  return d->stream->length();
+}
+
+void BudgetStream::truncate(offset_t length)
+{
+  if(d->startWrite())
+    d->stream->truncate(length);
+}
@@ -0,0 +1,236 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_BUDGETSTREAM_H
+#define TAGLIB_BUDGETSTREAM_H
+
+#include "tbytevector.h"
+#include "tiostream.h"
+#include "taglib_export.h"
+#include "taglib.h"
+
+namespace TagLib {
+
+  //! A flag to cancel the I/O on a BudgetStream from another thread
+
+  class TAGLIB_EXPORT CancellationToken
+  {
+  public:
+    /*!
+     * Constructs a token which is not cancelled.
+     */
+    CancellationToken();
+
+    /*!
+     * Destroys this CancellationToken instance.
+     */
+    ~CancellationToken();
+
+    CancellationToken(const CancellationToken &) = delete;
+    CancellationToken &operator=(const CancellationToken &) = delete;
+
+    /*!
+     * Requests the cancellation of the I/O on all streams using this token.
+     * This method can be called from any thread.
+     */
+    void cancel();
+
+    /*!
+     * Returns \c true if cancel() has been called.
+     */
+    bool isCancelled() const;
+
+  private:
+    class CancellationTokenPrivate;
+    TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+    std::unique_ptr<CancellationTokenPrivate> d;
+  };
+
+  //! Stream class limiting the I/O done on another stream
+
+  /*!
+   * This class forwards all calls to another IOStream until the configured
+   * number of bytes has been read, the number of seeks has been done, the
+   * timeout has expired or the CancellationToken has been cancelled.  From
+   * then on, reads return an empty vector, seeks and writes are ignored,
+   * readOnly() and isExhausted() return \c true.  The scans which are done to
+   * look for tags or frame headers stop at the next read, and files using the
+   * stream are not valid anymore, see File::isValid().  isOpen() still
+   * reports the state of the wrapped stream.
+   *
+   * The limits only apply until the stream is written for the first time.
+   * A file which is being saved is never interrupted, so that it is not left
+   * partially modified, and a file whose budget is exhausted cannot be saved
+   * because the stream is read only.
+   *
+   * \code
+   * FileStream fileStream(fileName, true);
+   * BudgetStream stream(&fileStream);
+   * stream.setMaxBytesRead(1024 * 1024);
+   * stream.setTimeout(100);
+   * FileRef f(&stream);
+   * if(f.isNull() && stream.isExhausted()) {
+   *   // Too expensive, give up
+   * }
+   * \endcode
+   *
+   * \note The BudgetStream does not take ownership of the wrapped stream.
+   */
+
+  class TAGLIB_EXPORT BudgetStream : public IOStream
+  {
+  public:
+    /*!
+     * Constructs a BudgetStream forwarding to \a stream without any limits.
+     */
+    explicit BudgetStream(IOStream *stream);
+
+    /*!
+     * Destroys this BudgetStream instance.
+     */
+    ~BudgetStream() override;
+
+    BudgetStream(const BudgetStream &) = delete;
+    BudgetStream &operator=(const BudgetStream &) = delete;
+
+    /*!
+     * Sets the maximum number of bytes which can be read to \a bytes.
+     * 0 means that there is no limit.
+     */
+    void setMaxBytesRead(offset_t bytes);
+
+    /*!
+     * Sets the maximum number of seek operations to \a seeks.
+     * 0 means that there is no limit.
+     */
+    void setMaxSeeks(unsigned int seeks);
+
+    /*!
+     * Sets a deadline \a milliseconds from now, after which all I/O fails.
+     * 0 means that there is no deadline.
+     */
+    void setTimeout(unsigned int milliseconds);
+
+    /*!
+     * Sets the \a token which is checked before each I/O operation, the
+     * stream does not take ownership of it.  Pass null to remove the token.
+     */
+    void setCancellationToken(const CancellationToken *token);
+
+    /*!
+     * Returns \c true if one of the limits has been hit or the operation has
+     * been cancelled.
+     */
+    bool isExhausted() const;
+
+    /*!
+     * Returns the number of bytes which have been read.
+     */
+    offset_t bytesRead() const;
+
+    /*!
+     * Returns the number of seek operations which have been done.
+     */
+    unsigned int seekCount() const;
+
+    /*!
+     * Returns the name of the wrapped stream.
+     */
+    FileName name() const override;
+
+    /*!
+     * Reads a block of size \a length at the current get pointer.  Returns an
+     * empty vector if the read would exceed the budget.
+     */
+    ByteVector readBlock(size_t length) override;
+
+    /*!
+     * Writes the block \a data at the current get pointer.
+     */
+    void writeBlock(const ByteVector &data) override;
+
+    /*!
+     * Insert \a data at position \a start in the file overwriting \a replace
+     * bytes of the original content.
+     */
+    void insert(const ByteVector &data, offset_t start = 0, size_t replace = 0) override;
+
+    /*!
+     * Removes a block of the file starting a \a start and continuing for
+     * \a length bytes.
+     */
+    void removeBlock(offset_t start = 0, size_t length = 0) override;
+
+    /*!
+     * Returns \c true if the wrapped stream is read only or the budget is
+     * exhausted.
+     */
+    bool readOnly() const override;
+
+    /*!
+     * Returns \c true if the wrapped stream is open, independent of the
+     * budget.
+     *
+     * \see isExhausted()
+     */
+    bool isOpen() const override;
+
+    /*!
+     * Move the I/O pointer to \a offset in the file from position \a p.  This
+     * defaults to seeking from the beginning of the file.
+     *
+     * \see Position
+     */
+    void seek(offset_t offset, Position p = Beginning) override;
+
+    /*!
+     * Reset the end-of-file and error flags on the wrapped stream.
+     */
+    void clear() override;
+
+    /*!
+     * Returns the current offset within the file.
+     */
+    offset_t tell() const override;
+
+    /*!
+     * Returns the length of the file.
+     */
+    offset_t length() override;
+
+    /*!
+     * Truncates the file to a \a length.
+     */
+    void truncate(offset_t length) override;
+
+  private:
+    class BudgetStreamPrivate;
+    TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+    std::unique_ptr<BudgetStreamPrivate> d;
+  };
+
+}  // namespace TagLib
+
+#endif
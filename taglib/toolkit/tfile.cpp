@@ -25,9 +25,13 @@
 
 #include "tfile.h"
 
+#include <algorithm>
+
 #include "tfilestream.h"
+#include "tbudgetstream.h"
 #include "tpropertymap.h"
 #include "tstring.h"
+#include "tdebug.h"
 
 #ifdef _WIN32
 # include <windows.h>
@@ -50,6 +54,7 @@ class File::FilePrivate
 public:
   FilePrivate(IOStream *stream, bool owner) :
     stream(stream),
+    budgetStream(dynamic_cast<const BudgetStream *>(stream)),
     streamOwner(owner)
   {
   }
@@ -64,8 +69,10 @@ public:
   FilePrivate &operator=(const FilePrivate &) = delete;
 
   IOStream *stream;
+  const BudgetStream *budgetStream;
   bool streamOwner;
   bool valid { true };
+  std::unique_ptr<PaddingPolicy> paddingPolicy;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +101,17 @@ PropertyMap File::properties() const
   return tag()->properties();
 }
 
+PropertyMap File::selectedProperties(const StringList &keys) const
+{
+  const PropertyMap allProperties = properties();
+  PropertyMap result;
+  for(const auto &key : keys) {
+    if(const auto it = allProperties.find(key); it != allProperties.end())
+      result.replace(it->first, it->second);
+  }
+  return result;
+}
+
 void File::removeUnsupportedProperties(const StringList &properties)
 {
   tag()->removeUnsupportedProperties(properties);
@@ -119,6 +137,11 @@ bool File::setComplexProperties(const String &key, const List<VariantMap> &value
   return tag()->setComplexProperties(key, value);
 }
 
+bool File::isModified() const
+{
+  return true;
+}
+
 ByteVector File::readBlock(size_t length)
 {
   return d->stream->readBlock(length);
@@ -307,6 +330,62 @@ void File::removeBlock(offset_t start, size_t length)
   d->stream->removeBlock(start, length);
 }
 
+bool File::containsBlock(const ByteVector &data, offset_t start, size_t length) const
+{
+  if(data.size() != length || start < 0 || !d->stream)
+    return false;
+
+  const unsigned int chunkSize = bufferSize() * 64;
+  for(unsigned int position = 0; position < data.size(); position += chunkSize) {
+    const unsigned int size = std::min(chunkSize, data.size() - position);
+    d->stream->seek(start + position);
+    if(d->stream->readBlock(size) != data.mid(position, size))
+      return false;
+  }
+
+  return true;
+}
+
+bool File::copyTo(IOStream *target, const Map<offset_t, size_t> &skippedBlocks)
+{
+  if(!isValid() || !target || !target->isOpen() || target->readOnly()) {
+    debug("File::copyTo() -- Cannot copy the file to the target stream.");
+    return false;
+  }
+
+  const offset_t chunkSize = bufferSize() * 64;
+  const offset_t fileLength = length();
+
+  target->seek(0);
+  offset_t written = 0;
+
+  const auto copyRange = [&](offset_t position, offset_t end) {
+    while(position < end) {
+      seek(position);
+      const ByteVector data = readBlock(static_cast<size_t>(std::min(chunkSize, end - position)));
+      if(data.isEmpty())
+        return false;
+      target->writeBlock(data);
+      position += data.size();
+      written += data.size();
+    }
+    return true;
+  };
+
+  offset_t position = 0;
+  for(const auto &[start, blockLength] : skippedBlocks) {
+    if(start > position && !copyRange(position, std::min(start, fileLength)))
+      return false;
+    position = std::max(position, start + static_cast<offset_t>(blockLength));
+  }
+
+  if(!copyRange(position, fileLength))
+    return false;
+
+  target->truncate(written);
+  return true;
+}
+
 bool File::readOnly() const
 {
   return d->stream->readOnly();
@@ -319,6 +398,10 @@ bool File::isOpen() const
 
 bool File::isValid() const
 {
+  // A file which ran out of budget while it was read is incomplete.
+  if(d->budgetStream && d->budgetStream->isExhausted())
+    return false;
+
   return isOpen() && d->valid;
 }
 
@@ -347,6 +430,16 @@ offset_t File::length()
   return d->stream->length();
 }
 
+PaddingPolicy File::paddingPolicy() const
+{
+  return d->paddingPolicy ? *d->paddingPolicy : PaddingPolicy::defaultPolicy();
+}
+
+void File::setPaddingPolicy(const PaddingPolicy &policy)
+{
+  d->paddingPolicy = std::make_unique<PaddingPolicy>(policy);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // protected members
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,3 +453,8 @@ void File::setValid(bool valid)
 {
   d->valid = valid;
 }
+
+IOStream *File::stream() const
+{
+  return d->stream;
+}
@@ -28,9 +28,11 @@
 
 #include "tbytevector.h"
 #include "tiostream.h"
+#include "tmap.h"
 #include "taglib_export.h"
 #include "taglib.h"
 #include "tag.h"
+#include "tpaddingpolicy.h"
 
 namespace TagLib {
 
@@ -111,6 +113,21 @@ namespace TagLib {
      */
     virtual PropertyMap properties() const;
 
+    /*!
+     * Returns the properties for the given \a keys only, as a subset of
+     * properties().  The keys are case-insensitive, the returned map does not
+     * contain unsupported data.
+     *
+     * \note To avoid decoding metadata which is not needed for \a keys when
+     * the file is read, open the file with
+     * FileRef::FileRef(FileName, bool, AudioProperties::ReadStyle, const StringList &)
+     * or pass an ID3v2::SelectiveFrameFactory to the file constructor.
+     *
+     * \note This method has a name distinct from properties(), so that it is
+     * not hidden by the reimplementations of properties() in subclasses.
+     */
+    PropertyMap selectedProperties(const StringList &keys) const;
+
     /*!
      * Removes unsupported properties, or a subset of them, from the file's metadata.
      * The parameter \a properties must contain only entries from
@@ -174,6 +191,25 @@ namespace TagLib {
      */
     virtual bool save() = 0;
 
+    /*!
+     * Returns \c true if the tags have been modified since the file was read
+     * or last saved.  This is determined by comparing the rendered tags with
+     * the data in the file in the format in which they are stored, e.g. an
+     * ID3v2.3 tag is rendered as ID3v2.3, so setting a value which is already
+     * stored does not modify the file.  Neither the file nor its tags are
+     * changed by this check.
+     *
+     * The default implementation returns \c true, file types which support
+     * this check reimplement it.  Their save() methods do not write to the
+     * file if this returns \c false.  The position of the stream is not
+     * changed.
+     *
+     * \note Format specific save methods which are explicitly given a tag
+     * version, e.g. MPEG::File::save(int, StripTags, ID3v2::Version,
+     * DuplicateTags), can still convert the tags of an unmodified file.
+     */
+    virtual bool isModified() const;
+
     /*!
      * Reads a block of size \a length at the current get pointer.
      */
@@ -240,6 +276,28 @@ namespace TagLib {
      */
     void removeBlock(offset_t start = 0, size_t length = 0);
 
+    /*!
+     * Returns \c true if the \a length bytes of the file starting at \a start
+     * are equal to \a data.  This can be used to avoid writing data which is
+     * already stored in the file.
+     */
+    bool containsBlock(const ByteVector &data, offset_t start, size_t length) const;
+
+    /*!
+     * Writes the contents of the file to \a target, leaving out the blocks
+     * in \a skippedBlocks, which maps the start of each block to its length.
+     * The data is copied sequentially from the start of the file, \a target
+     * is overwritten from its start and truncated to the written data.  This
+     * file is not modified.
+     *
+     * This can be used instead of removeBlock() to avoid rewriting a large
+     * part of the file in place, e.g. by writing to a temporary file which
+     * replaces the original file afterwards.
+     *
+     * Returns \c true if all data has been copied.
+     */
+    bool copyTo(IOStream *target, const Map<offset_t, size_t> &skippedBlocks);
+
     /*!
      * Returns \c true if the file is read only (or if the file can not be opened).
      */
@@ -253,6 +311,9 @@ namespace TagLib {
 
     /*!
      * Returns \c true if the file is open and readable.
+     *
+     * \note A file read from a BudgetStream is not valid once the budget of
+     * the stream is exhausted.
      */
     bool isValid() const;
 
@@ -279,6 +340,19 @@ namespace TagLib {
      */
     offset_t length();
 
+    /*!
+     * Returns the policy for the padding written when the file is saved.
+     * This is the policy set with setPaddingPolicy() or
+     * PaddingPolicy::defaultPolicy() if no policy has been set for this file.
+     */
+    PaddingPolicy paddingPolicy() const;
+
+    /*!
+     * Sets the policy for the padding written when the file is saved to
+     * \a policy.
+     */
+    void setPaddingPolicy(const PaddingPolicy &policy);
+
   protected:
     /*!
      * Construct a File object and open the \a fileName.  \a fileName should be a
@@ -317,7 +391,15 @@ namespace TagLib {
      */
     static unsigned int bufferSize();
 
+    /*!
+     * Returns the stream of the file.  It can be used to read the data
+     * stored in the file from const methods, e.g. by isModified().
+     */
+    IOStream *stream() const;
+
   private:
+    friend class PictureReference;
+
     class FilePrivate;
     TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
     std::unique_ptr<FilePrivate> d;
@@ -25,14 +25,32 @@
 
 #include "tfilestream.h"
 
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <algorithm>
+
 #ifdef _WIN32
 # include <windows.h>
+# include <io.h>
 #else
+# include <cerrno>
 # include <climits>
 # include <cstdio>
 # include <unistd.h>
 #endif
 
+#ifdef HAVE_SENDFILE
+# include <sys/sendfile.h>
+#endif
+
+#ifdef HAVE_FALLOC_FL_COLLAPSE_RANGE
+# include <fcntl.h>
+# include <linux/falloc.h>
+# include <sys/stat.h>
+#endif
+
 #include "tstring.h"
 #include "tdebug.h"
 
@@ -100,6 +118,12 @@ namespace
     return 0;
   }
 
+  bool writeDescriptor(int fileDescriptor, const ByteVector &buffer)
+  {
+    return _write(fileDescriptor, buffer.data(), buffer.size()) ==
+           static_cast<int>(buffer.size());
+  }
+
 #else   // _WIN32
 
   struct FileNameHandle : public std::string
@@ -137,6 +161,22 @@ namespace
     return fwrite(buffer.data(), sizeof(char), buffer.size(), file);
   }
 
+  bool writeDescriptor(int fileDescriptor, const ByteVector &buffer)
+  {
+    const char *data = buffer.data();
+    size_t remaining = buffer.size();
+    while(remaining > 0) {
+      const ssize_t count = write(fileDescriptor, data, remaining);
+      if(count < 0 && errno == EINTR)
+        continue;
+      if(count <= 0)
+        return false;
+      data += count;
+      remaining -= static_cast<size_t>(count);
+    }
+    return true;
+  }
+
 #endif  // _WIN32
 }  // namespace
 
@@ -334,6 +374,41 @@ void FileStream::removeBlock(offset_t start, size_t length)
     return;
   }
 
+#ifdef HAVE_FALLOC_FL_COLLAPSE_RANGE
+
+  // If the length is a multiple of the file system block size, the file
+  // system can remove the range without moving the data following it.  The
+  // collapsed range has to start at a block boundary, so it starts at the
+  // first boundary after start and the data which will follow the removed
+  // block up to this boundary is written in place of the collapsed data.
+
+  if(length > 0) {
+    fflush(d->file);
+    const int fileDescriptor = fileno(d->file);
+    struct stat st;
+    if(fstat(fileDescriptor, &st) == 0 && st.st_blksize > 0 &&
+       length % static_cast<size_t>(st.st_blksize) == 0) {
+      const offset_t blockSize = st.st_blksize;
+      const offset_t collapseStart = (start + blockSize - 1) / blockSize * blockSize;
+
+      // The collapsed range must not reach the end of the file.
+
+      if(collapseStart + static_cast<offset_t>(length) < this->length()) {
+        seek(start + length);
+        const ByteVector head = readBlock(static_cast<size_t>(collapseStart - start));
+        if(head.size() == collapseStart - start &&
+           fallocate(fileDescriptor, FALLOC_FL_COLLAPSE_RANGE,
+                     collapseStart, static_cast<off_t>(length)) == 0) {
+          seek(start);
+          writeBlock(head);
+          return;
+        }
+      }
+    }
+  }
+
+#endif
+
   unsigned int bufferLength = bufferSize();
 
   offset_t readPosition = start + length;
@@ -452,6 +527,67 @@ offset_t FileStream::tell() const
 #endif
 }
 
+bool FileStream::copyTo(int fileDescriptor, offset_t offset, size_t length)
+{
+  if(!isOpen()) {
+    debug("FileStream::copyTo() -- invalid file.");
+    return false;
+  }
+
+#if defined(HAVE_COPY_FILE_RANGE) || defined(HAVE_SENDFILE)
+
+  // Let the kernel copy the data.  The input is read at an explicit offset,
+  // so the position of the file is not changed.  copy_file_range() does not
+  // support all kinds of output, e.g. sockets, sendfile() is tried then.
+
+  fflush(d->file);
+  const int inputDescriptor = fileno(d->file);
+  auto position = static_cast<off_t>(offset);
+# ifdef HAVE_COPY_FILE_RANGE
+  bool useCopyFileRange = true;
+# else
+  bool useCopyFileRange = false;
+# endif
+  while(length > 0) {
+    ssize_t count = -1;
+# ifdef HAVE_COPY_FILE_RANGE
+    if(useCopyFileRange) {
+      count = copy_file_range(inputDescriptor, &position, fileDescriptor, nullptr, length, 0);
+      useCopyFileRange = count >= 0 || errno == EINTR;
+    }
+# endif
+# ifdef HAVE_SENDFILE
+    if(count < 0 && !useCopyFileRange)
+      count = sendfile(fileDescriptor, inputDescriptor, &position, length);
+# endif
+    if(count < 0 && errno == EINTR)
+      continue;
+    if(count <= 0)
+      break;
+    length -= static_cast<size_t>(count);
+  }
+  offset = position;
+
+  if(length == 0)
+    return true;
+
+#endif
+
+  const offset_t currentPosition = tell();
+  seek(offset);
+
+  constexpr size_t chunkSize = 64 * 1024;
+  while(length > 0) {
+    const ByteVector data = readBlock(std::min(length, chunkSize));
+    if(data.isEmpty() || !writeDescriptor(fileDescriptor, data))
+      break;
+    length -= data.size();
+  }
+
+  seek(currentPosition);
+  return length == 0;
+}
+
 offset_t FileStream::length()
 {
   if(!isOpen()) {
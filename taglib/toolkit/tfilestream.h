@@ -96,7 +96,10 @@ namespace TagLib {
      * \a length bytes.
      *
      * \note This method is slow since it involves rewriting all of the file
-     * after the removed portion.
+     * after the removed portion.  On Linux, if \a length is a multiple of the
+     * block size of the file system and the file system supports it, the
+     * block is removed with FALLOC_FL_COLLAPSE_RANGE without rewriting the
+     * rest of the file.
      */
     void removeBlock(offset_t start = 0, size_t length = 0) override;
 
@@ -139,6 +142,19 @@ namespace TagLib {
      */
     void truncate(offset_t length) override;
 
+    /*!
+     * Copies \a length bytes starting at \a offset to the file descriptor
+     * \a fileDescriptor, which is written at its current position.  The
+     * position of this stream is not changed.
+     *
+     * If supported by the system, copy_file_range() or sendfile() is used, so
+     * that the data is copied by the kernel without passing through user
+     * space.  Otherwise the data is read and written in chunks.
+     *
+     * Returns \c true if all \a length bytes have been copied.
+     */
+    bool copyTo(int fileDescriptor, offset_t offset, size_t length);
+
   protected:
 
     /*!
@@ -0,0 +1,151 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "tpaddingpolicy.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace TagLib;
+
+class PaddingPolicy::PaddingPolicyPrivate
+{
+public:
+  int reserve { -1 };
+  unsigned int percentage { 0 };
+  unsigned int maximum { 1024 * 1024 };
+  ShrinkMode shrinkMode { DefaultShrinkMode };
+};
+
+namespace
+{
+  std::mutex defaultPaddingPolicyMutex;
+  PaddingPolicy defaultPaddingPolicy;
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+PaddingPolicy::PaddingPolicy() :
+  d(std::make_unique<PaddingPolicyPrivate>())
+{
+}
+
+PaddingPolicy::PaddingPolicy(const PaddingPolicy &other) :
+  d(std::make_unique<PaddingPolicyPrivate>(*other.d))
+{
+}
+
+PaddingPolicy::~PaddingPolicy() = default;
+
+PaddingPolicy &PaddingPolicy::operator=(const PaddingPolicy &other)
+{
+  if(&other != this)
+    *d = *other.d;
+  return *this;
+}
+
+int PaddingPolicy::reserve() const
+{
+  return d->reserve;
+}
+
+void PaddingPolicy::setReserve(int bytes)
+{
+  d->reserve = std::max(bytes, -1);
+}
+
+unsigned int PaddingPolicy::percentage() const
+{
+  return d->percentage;
+}
+
+void PaddingPolicy::setPercentage(unsigned int percent)
+{
+  d->percentage = percent;
+}
+
+unsigned int PaddingPolicy::maximum() const
+{
+  return d->maximum;
+}
+
+void PaddingPolicy::setMaximum(unsigned int bytes)
+{
+  d->maximum = bytes;
+}
+
+PaddingPolicy::ShrinkMode PaddingPolicy::shrinkMode() const
+{
+  return d->shrinkMode;
+}
+
+void PaddingPolicy::setShrinkMode(ShrinkMode mode)
+{
+  d->shrinkMode = mode;
+}
+
+offset_t PaddingPolicy::padding(offset_t available, offset_t fileLength,
+                                offset_t defaultReserve,
+                                ShrinkMode defaultShrinkMode) const
+{
+  const offset_t maximum = d->maximum;
+
+  offset_t reserved = d->reserve >= 0 ? d->reserve : defaultReserve;
+  reserved = std::max<offset_t>(reserved, fileLength / 100 * d->percentage);
+  reserved = std::min(reserved, maximum);
+
+  const ShrinkMode mode = d->shrinkMode != DefaultShrinkMode
+    ? d->shrinkMode : defaultShrinkMode;
+
+  if(mode == NeverShrink && available >= 0)
+    return available;
+
+  if(mode == ShrinkLargePadding && available > 0) {
+    // Padding won't increase beyond 1% of the file size or the maximum,
+    // unless more padding is reserved.
+
+    offset_t threshold = std::min(fileLength / 100, maximum);
+    threshold = std::max(threshold, reserved);
+
+    if(available <= threshold)
+      return available;
+  }
+
+  return reserved;
+}
+
+PaddingPolicy PaddingPolicy::defaultPolicy() // static
+{
+  std::lock_guard<std::mutex> lock(defaultPaddingPolicyMutex);
+  return defaultPaddingPolicy;
+}
+
+void PaddingPolicy::setDefaultPolicy(const PaddingPolicy &policy) // static
+{
+  std::lock_guard<std::mutex> lock(defaultPaddingPolicyMutex);
+  defaultPaddingPolicy = policy;
+}
@@ -0,0 +1,188 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_PADDINGPOLICY_H
+#define TAGLIB_PADDINGPOLICY_H
+
+#include <memory>
+
+#include "taglib_export.h"
+#include "taglib.h"
+
+namespace TagLib {
+
+  //! A policy for the padding written with the tags of a file
+
+  /*!
+   * Many formats can store unused space (padding) together with the tag, so
+   * that the tag can later grow or shrink without moving the audio data
+   * following it.  This class controls how much padding is written when a
+   * file is saved.  It is used for ID3v2 tags, FLAC metadata, MP4 "free"
+   * atoms, the comment packets of Ogg Vorbis, Opus and Speex files and ASF
+   * padding objects.
+   *
+   * A policy can be set for a single file using File::setPaddingPolicy() or
+   * for all files which do not have their own policy using
+   * setDefaultPolicy().  All values of a default constructed policy keep the
+   * behavior of the respective format.
+   *
+   * \code
+   * PaddingPolicy policy;
+   * policy.setReserve(64 * 1024);
+   * policy.setShrinkMode(PaddingPolicy::NeverShrink);
+   * PaddingPolicy::setDefaultPolicy(policy);
+   * \endcode
+   */
+  class TAGLIB_EXPORT PaddingPolicy
+  {
+  public:
+    /*!
+     * Specifies what happens to existing padding which is larger than needed.
+     */
+    enum ShrinkMode {
+      //! Use the behavior of the format.
+      DefaultShrinkMode,
+      //! Keep the padding unless it is larger than the reserved padding,
+      //! 1% of the file size and maximum().
+      ShrinkLargePadding,
+      //! Keep all available padding, the tag data never shrinks.
+      NeverShrink,
+      //! Always write the reserved padding.
+      AlwaysShrink
+    };
+
+    /*!
+     * Constructs a policy which uses the defaults of the file formats.
+     */
+    PaddingPolicy();
+
+    /*!
+     * Constructs a copy of \a other.
+     */
+    PaddingPolicy(const PaddingPolicy &other);
+
+    /*!
+     * Destroys this PaddingPolicy instance.
+     */
+    ~PaddingPolicy();
+
+    /*!
+     * Copies the values of \a other into this policy.
+     */
+    PaddingPolicy &operator=(const PaddingPolicy &other);
+
+    /*!
+     * Returns the number of bytes reserved as padding when the tag data
+     * does not fit into the existing space, or -1 to use the default of the
+     * format.
+     *
+     * \see setReserve()
+     */
+    int reserve() const;
+
+    /*!
+     * Sets the number of bytes reserved as padding when the tag data does
+     * not fit into the existing space to \a bytes.  If \a bytes is -1, the
+     * default of the format is used.
+     */
+    void setReserve(int bytes);
+
+    /*!
+     * Returns the reserved padding as a percentage of the file size.
+     *
+     * \see setPercentage()
+     */
+    unsigned int percentage() const;
+
+    /*!
+     * Sets the reserved padding to \a percent of the file size if this is
+     * larger than reserve().  The default is 0.
+     */
+    void setPercentage(unsigned int percent);
+
+    /*!
+     * Returns the maximum number of bytes of reserved padding.
+     *
+     * \see setMaximum()
+     */
+    unsigned int maximum() const;
+
+    /*!
+     * Sets the maximum number of bytes of reserved padding to \a bytes.
+     * The default is 1 MB.
+     */
+    void setMaximum(unsigned int bytes);
+
+    /*!
+     * Returns what happens to existing padding which is larger than needed.
+     *
+     * \see setShrinkMode()
+     */
+    ShrinkMode shrinkMode() const;
+
+    /*!
+     * Sets what happens to existing padding which is larger than needed to
+     * \a mode.
+     */
+    void setShrinkMode(ShrinkMode mode);
+
+    /*!
+     * Returns the number of bytes of padding to write.  \a available is the
+     * space which is left for the padding when the new tag data is written
+     * into the space of the existing tag, it is negative if the tag data
+     * does not fit.  \a fileLength is the current size of the file.
+     * \a defaultReserve and \a defaultShrinkMode are the defaults of the
+     * format which are used if reserve() is -1 or shrinkMode() is
+     * DefaultShrinkMode.
+     *
+     * If the returned value is equal to \a available, the tag can be written
+     * without moving the data following it.
+     */
+    offset_t padding(offset_t available, offset_t fileLength,
+                     offset_t defaultReserve, ShrinkMode defaultShrinkMode) const;
+
+    /*!
+     * Returns the policy used for files which do not have their own policy.
+     *
+     * \see File::paddingPolicy()
+     */
+    static PaddingPolicy defaultPolicy();
+
+    /*!
+     * Sets the policy used for files which do not have their own policy to
+     * \a policy.  This method can be called from any thread, files which
+     * are saved concurrently use either the old or the new policy.
+     */
+    static void setDefaultPolicy(const PaddingPolicy &policy);
+
+  private:
+    class PaddingPolicyPrivate;
+    TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+    std::unique_ptr<PaddingPolicyPrivate> d;
+  };
+
+}  // namespace TagLib
+
+#endif
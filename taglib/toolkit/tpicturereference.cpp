@@ -0,0 +1,206 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "tpicturereference.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tfile.h"
+#include "tfilestream.h"
+#include "tiostream.h"
+
+using namespace TagLib;
+
+namespace
+{
+  constexpr unsigned int ChunkSize = 64 * 1024;
+}  // namespace
+
+class PictureReference::PictureReferencePrivate
+{
+public:
+  PictureReferencePrivate(File *file, offset_t offset, unsigned int length,
+                          Encoding encoding) :
+    file(file),
+    offset(offset),
+    length(length),
+    encoding(encoding)
+  {
+  }
+
+  // Reads the data in chunks and passes the decoded chunks to function,
+  // which returns false to stop reading.
+  template <typename F>
+  bool readChunks(F function) const
+  {
+    if(!file || !file->isOpen())
+      return false;
+
+    file->seek(offset);
+
+    bool lastWasFF = false;
+    unsigned int remaining = length;
+    while(remaining > 0) {
+      ByteVector chunk = file->readBlock(std::min(remaining, ChunkSize));
+      if(chunk.isEmpty())
+        return false;
+      remaining -= chunk.size();
+
+      if(encoding == Unsynchronised) {
+        // Remove the 0x00 bytes following 0xFF, also across chunk borders.
+        auto dst = chunk.begin();
+        for(auto src = chunk.cbegin(); src != chunk.cend(); ++src) {
+          if(lastWasFF && *src == '\0') {
+            lastWasFF = false;
+            continue;
+          }
+          lastWasFF = static_cast<unsigned char>(*src) == 0xFF;
+          *dst++ = *src;
+        }
+        chunk.resize(static_cast<unsigned int>(dst - chunk.begin()));
+      }
+
+      if(!function(chunk))
+        return true;
+    }
+    return true;
+  }
+
+  File *file;
+  offset_t offset;
+  unsigned int length;
+  Encoding encoding;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// public members
+////////////////////////////////////////////////////////////////////////////////
+
+PictureReference::PictureReference() = default;
+
+PictureReference::PictureReference(File *file, offset_t offset,
+                                   unsigned int length, Encoding encoding) :
+  d(std::make_shared<PictureReferencePrivate>(file, offset, length, encoding))
+{
+}
+
+PictureReference::PictureReference(const PictureReference &other) = default;
+
+PictureReference::~PictureReference() = default;
+
+PictureReference &PictureReference::operator=(const PictureReference &other) = default;
+
+bool PictureReference::isNull() const
+{
+  return !d || !d->file;
+}
+
+File *PictureReference::file() const
+{
+  return d ? d->file : nullptr;
+}
+
+offset_t PictureReference::offset() const
+{
+  return d ? d->offset : 0;
+}
+
+unsigned int PictureReference::length() const
+{
+  return d ? d->length : 0;
+}
+
+PictureReference::Encoding PictureReference::encoding() const
+{
+  return d ? d->encoding : Plain;
+}
+
+unsigned int PictureReference::size() const
+{
+  if(isNull())
+    return 0;
+
+  if(d->encoding == Plain)
+    return d->length;
+
+  unsigned int size = 0;
+  d->readChunks([&size](const ByteVector &chunk) {
+    size += chunk.size();
+    return true;
+  });
+  return size;
+}
+
+ByteVector PictureReference::data() const
+{
+  if(isNull())
+    return ByteVector();
+
+  ByteVector data;
+  d->readChunks([&data](const ByteVector &chunk) {
+    data.append(chunk);
+    return true;
+  });
+  return data;
+}
+
+unsigned int PictureReference::readInto(char *buffer, unsigned int maxSize) const
+{
+  if(isNull() || !buffer)
+    return 0;
+
+  unsigned int size = 0;
+  d->readChunks([&size, buffer, maxSize](const ByteVector &chunk) {
+    const unsigned int count = std::min(chunk.size(), maxSize - size);
+    ::memcpy(buffer + size, chunk.data(), count);
+    size += count;
+    return size < maxSize;
+  });
+  return size;
+}
+
+bool PictureReference::readTo(IOStream *stream) const
+{
+  if(isNull() || !stream)
+    return false;
+
+  return d->readChunks([stream](const ByteVector &chunk) {
+    stream->writeBlock(chunk);
+    return true;
+  });
+}
+
+bool PictureReference::copyTo(int fileDescriptor) const
+{
+  if(isNull() || d->encoding != Plain || !d->file->isOpen())
+    return false;
+
+  auto stream = dynamic_cast<FileStream *>(d->file->stream());
+  if(!stream)
+    return false;
+
+  return stream->copyTo(fileDescriptor, d->offset, d->length);
+}
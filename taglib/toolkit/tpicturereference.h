@@ -0,0 +1,162 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_PICTUREREFERENCE_H
+#define TAGLIB_PICTUREREFERENCE_H
+
+#include "tbytevector.h"
+#include "taglib_export.h"
+#include "taglib.h"
+
+namespace TagLib {
+
+  class File;
+  class IOStream;
+
+  //! A reference to picture data stored in a file
+
+  /*!
+   * This class records where the data of an embedded picture is located in
+   * the file it was read from, so that it can be copied to another stream or
+   * buffer in chunks without holding the complete picture in memory.
+   *
+   * References are returned by FLAC::Picture::dataReference(),
+   * MP4::CoverArt::dataReference(), ASF::Picture::pictureReference() and
+   * ID3v2::AttachedPictureFrame::pictureReference().  They are null if the
+   * picture was not read from a file or if its data is not stored in the file
+   * as it is or unsynchronised, e.g. for compressed ID3v2 frames.
+   *
+   * \note A reference is only valid as long as the file it refers to exists
+   * and has not been saved.
+   */
+  class TAGLIB_EXPORT PictureReference
+  {
+  public:
+    /*!
+     * The encoding of the referenced data in the file.
+     */
+    enum Encoding {
+      //! The data is stored as it is.
+      Plain,
+      //! The data is stored with ID3v2 unsynchronisation.
+      Unsynchronised
+    };
+
+    /*!
+     * Constructs a null reference.
+     */
+    PictureReference();
+
+    /*!
+     * Constructs a reference to \a length bytes at \a offset in \a file
+     * which are stored using \a encoding.
+     */
+    PictureReference(File *file, offset_t offset, unsigned int length,
+                     Encoding encoding = Plain);
+
+    /*!
+     * Constructs a copy of \a other.
+     */
+    PictureReference(const PictureReference &other);
+
+    /*!
+     * Destroys this PictureReference instance.
+     */
+    ~PictureReference();
+
+    /*!
+     * Copies the contents of \a other into this reference.
+     */
+    PictureReference &operator=(const PictureReference &other);
+
+    /*!
+     * Returns \c true if this reference does not refer to any data.
+     */
+    bool isNull() const;
+
+    /*!
+     * Returns the file containing the data.
+     */
+    File *file() const;
+
+    /*!
+     * Returns the offset of the data in the file.
+     */
+    offset_t offset() const;
+
+    /*!
+     * Returns the number of bytes used by the data in the file.
+     */
+    unsigned int length() const;
+
+    /*!
+     * Returns the encoding of the data in the file.
+     */
+    Encoding encoding() const;
+
+    /*!
+     * Returns the size of the decoded data.  For plain data, this is
+     * length() and no data is read.  Unsynchronised data has to be scanned,
+     * which is done in chunks.
+     */
+    unsigned int size() const;
+
+    /*!
+     * Reads and returns the decoded data.
+     */
+    ByteVector data() const;
+
+    /*!
+     * Reads up to \a maxSize decoded bytes into \a buffer and returns the
+     * number of bytes written.
+     */
+    unsigned int readInto(char *buffer, unsigned int maxSize) const;
+
+    /*!
+     * Writes the decoded data to \a stream in chunks.  Returns \c false if
+     * the reference is null or the data could not be read completely.
+     */
+    bool readTo(IOStream *stream) const;
+
+    /*!
+     * Copies the data to the file descriptor \a fileDescriptor using
+     * FileStream::copyTo(), so that the data is copied by the kernel where
+     * the system supports it.
+     *
+     * This is only possible for plain data in a file which has been opened
+     * using a FileStream, otherwise \c false is returned without writing
+     * anything.  Use readTo() for unsynchronised data or other streams.
+     */
+    bool copyTo(int fileDescriptor) const;
+
+  private:
+    class PictureReferencePrivate;
+    TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+    std::shared_ptr<PictureReferencePrivate> d;
+  };
+
+}  // namespace TagLib
+
+#endif
@@ -0,0 +1,576 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "tserialization.h"
+
+#include <vector>
+
+#include "tstringlist.h"
+#include "tdebug.h"
+
+using namespace TagLib;
+
+namespace
+{
+  const char Magic[] = "TLSR";
+  constexpr unsigned int MagicSize = 4;
+  constexpr char FormatVersion = 1;
+  constexpr unsigned int HeaderSize = MagicSize + 2;
+
+  // Identifies the container stored after the header.
+  constexpr char PropertyMapKind = 'P';
+  constexpr char ComplexPropertiesKind = 'C';
+  constexpr char AudioPropertiesKind = 'A';
+
+  // Protects against stack exhaustion by maliciously nested variants.
+  constexpr int MaxVariantDepth = 64;
+
+  ByteVector header(char kind)
+  {
+    ByteVector data(Magic, MagicSize);
+    data.append(FormatVersion);
+    data.append(kind);
+    return data;
+  }
+
+  void writeUInt(ByteVector &data, unsigned int value)
+  {
+    data.append(ByteVector::fromUInt(value, false));
+  }
+
+  void writeBytes(ByteVector &data, const ByteVector &bytes)
+  {
+    writeUInt(data, bytes.size());
+    data.append(bytes);
+  }
+
+  void writeString(ByteVector &data, const String &s)
+  {
+    writeBytes(data, s.data(String::UTF8));
+  }
+
+  void writeStringList(ByteVector &data, const StringList &list)
+  {
+    writeUInt(data, list.size());
+    for(const auto &s : list)
+      writeString(data, s);
+  }
+
+  void writeVariant(ByteVector &data, const Variant &v);
+
+  void writeVariantMap(ByteVector &data, const VariantMap &map)
+  {
+    writeUInt(data, map.size());
+    for(const auto &[key, value] : map) {
+      writeString(data, key);
+      writeVariant(data, value);
+    }
+  }
+
+  void writeVariant(ByteVector &data, const Variant &v)
+  {
+    data.append(static_cast<char>(v.type()));
+
+    switch(v.type()) {
+    case Variant::Void:
+      break;
+    case Variant::Bool:
+      data.append(static_cast<char>(v.toBool() ? 1 : 0));
+      break;
+    case Variant::Int:
+      writeUInt(data, static_cast<unsigned int>(v.toInt()));
+      break;
+    case Variant::UInt:
+      writeUInt(data, v.toUInt());
+      break;
+    case Variant::LongLong:
+      data.append(ByteVector::fromLongLong(v.toLongLong(), false));
+      break;
+    case Variant::ULongLong:
+      data.append(ByteVector::fromULongLong(v.toULongLong(), false));
+      break;
+    case Variant::Double:
+      data.append(ByteVector::fromFloat64LE(v.toDouble()));
+      break;
+    case Variant::String:
+      writeString(data, v.toString());
+      break;
+    case Variant::StringList:
+      writeStringList(data, v.toStringList());
+      break;
+    case Variant::ByteVector:
+      writeBytes(data, v.toByteVector());
+      break;
+    case Variant::ByteVectorList: {
+      const ByteVectorList list = v.toByteVectorList();
+      writeUInt(data, list.size());
+      for(const auto &bytes : list)
+        writeBytes(data, bytes);
+      break;
+    }
+    case Variant::VariantList: {
+      const VariantList list = v.toList();
+      writeUInt(data, list.size());
+      for(const auto &item : list)
+        writeVariant(data, item);
+      break;
+    }
+    case Variant::VariantMap:
+      writeVariantMap(data, v.toMap());
+      break;
+    }
+  }
+
+  // Sequential reader for serialized data.  All accessors return empty values
+  // once the data has been found to be truncated or corrupt, so that callers
+  // only have to check isValid() at the end.  Byte vectors returned by
+  // readBytes() share the storage of the data.
+
+  class Reader
+  {
+  public:
+    Reader(const ByteVector &data, char kind) :
+      data(data)
+    {
+      ok = data.size() >= HeaderSize &&
+           data.startsWith(ByteVector(Magic, MagicSize)) &&
+           data[MagicSize] == FormatVersion &&
+           data[MagicSize + 1] == kind;
+      pos = HeaderSize;
+    }
+
+    bool isValid() const
+    {
+      return ok;
+    }
+
+    bool atEnd() const
+    {
+      return pos == data.size();
+    }
+
+    unsigned int position() const
+    {
+      return pos;
+    }
+
+    bool require(unsigned int length)
+    {
+      if(ok && data.size() - pos < length)
+        ok = false;
+      return ok;
+    }
+
+    // Reads an element count, each element taking at least \a minimumSize
+    // bytes, which prevents huge allocations for corrupt counts.
+    unsigned int readCount(unsigned int minimumSize)
+    {
+      const unsigned int count = readUInt();
+      if(ok && static_cast<unsigned long long>(count) * minimumSize > data.size() - pos)
+        ok = false;
+      return ok ? count : 0;
+    }
+
+    char readByte()
+    {
+      if(!require(1))
+        return 0;
+      return data[pos++];
+    }
+
+    unsigned int readUInt()
+    {
+      if(!require(4))
+        return 0;
+      const unsigned int value = data.toUInt(pos, false);
+      pos += 4;
+      return value;
+    }
+
+    ByteVector readRaw(unsigned int length)
+    {
+      if(!require(length))
+        return ByteVector();
+      const ByteVector bytes = data.mid(pos, length);
+      pos += length;
+      return bytes;
+    }
+
+    ByteVector readBytes()
+    {
+      return readRaw(readUInt());
+    }
+
+    String readString()
+    {
+      return String(readBytes(), String::UTF8);
+    }
+
+    StringList readStringList()
+    {
+      StringList list;
+      for(unsigned int i = readCount(4); i > 0 && ok; --i)
+        list.append(readString());
+      return list;
+    }
+
+    Variant readVariant(int depth);
+
+    VariantMap readVariantMap(int depth)
+    {
+      VariantMap map;
+      for(unsigned int i = readCount(5); i > 0 && ok; --i) {
+        const String key = readString();
+        map.insert(key, readVariant(depth));
+      }
+      return map;
+    }
+
+  private:
+    const ByteVector &data;
+    unsigned int pos;
+    bool ok;
+  };
+
+  Variant Reader::readVariant(int depth)
+  {
+    if(depth > MaxVariantDepth) {
+      ok = false;
+      return Variant();
+    }
+
+    switch(readByte()) {
+    case Variant::Void:
+      return Variant();
+    case Variant::Bool:
+      return readByte() != 0;
+    case Variant::Int:
+      return static_cast<int>(readUInt());
+    case Variant::UInt:
+      return readUInt();
+    case Variant::LongLong:
+      return require(8) ? readRaw(8).toLongLong(false) : 0LL;
+    case Variant::ULongLong:
+      return require(8) ? readRaw(8).toULongLong(false) : 0ULL;
+    case Variant::Double:
+      return require(8) ? readRaw(8).toFloat64LE(0) : 0.0;
+    case Variant::String:
+      return readString();
+    case Variant::StringList:
+      return readStringList();
+    case Variant::ByteVector:
+      return readBytes();
+    case Variant::ByteVectorList: {
+      ByteVectorList list;
+      for(unsigned int i = readCount(4); i > 0 && ok; --i)
+        list.append(readBytes());
+      return list;
+    }
+    case Variant::VariantList: {
+      VariantList list;
+      for(unsigned int i = readCount(1); i > 0 && ok; --i)
+        list.append(readVariant(depth + 1));
+      return list;
+    }
+    case Variant::VariantMap:
+      return readVariantMap(depth + 1);
+    default:
+      ok = false;
+      return Variant();
+    }
+  }
+
+  PropertyMap readPropertyMap(Reader &reader)
+  {
+    PropertyMap properties;
+    for(unsigned int i = reader.readCount(8); i > 0 && reader.isValid(); --i) {
+      const String key = reader.readString();
+      properties.insert(key, reader.readStringList());
+    }
+    for(const auto &key : reader.readStringList())
+      properties.addUnsupportedData(key);
+    return properties;
+  }
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Serialization functions
+////////////////////////////////////////////////////////////////////////////////
+
+ByteVector Serialization::serialize(const PropertyMap &properties)
+{
+  ByteVector data = header(PropertyMapKind);
+  writeUInt(data, properties.size());
+  for(const auto &[key, values] : properties) {
+    writeString(data, key);
+    writeStringList(data, values);
+  }
+  writeStringList(data, properties.unsupportedData());
+  return data;
+}
+
+ByteVector Serialization::serialize(const List<VariantMap> &properties)
+{
+  ByteVector data = header(ComplexPropertiesKind);
+  writeUInt(data, properties.size());
+  for(const auto &map : properties)
+    writeVariantMap(data, map);
+  return data;
+}
+
+ByteVector Serialization::serialize(const AudioProperties &properties)
+{
+  ByteVector data = header(AudioPropertiesKind);
+  writeUInt(data, static_cast<unsigned int>(properties.lengthInMilliseconds()));
+  writeUInt(data, static_cast<unsigned int>(properties.bitrate()));
+  writeUInt(data, static_cast<unsigned int>(properties.sampleRate()));
+  writeUInt(data, static_cast<unsigned int>(properties.channels()));
+  return data;
+}
+
+bool Serialization::deserialize(const ByteVector &data, PropertyMap &properties)
+{
+  Reader reader(data, PropertyMapKind);
+  PropertyMap result = readPropertyMap(reader);
+  if(!reader.isValid() || !reader.atEnd()) {
+    debug("Serialization::deserialize() -- Invalid property map data.");
+    return false;
+  }
+
+  properties = result;
+  return true;
+}
+
+bool Serialization::deserialize(const ByteVector &data, List<VariantMap> &properties)
+{
+  Reader reader(data, ComplexPropertiesKind);
+  List<VariantMap> result;
+  for(unsigned int i = reader.readCount(4); i > 0 && reader.isValid(); --i)
+    result.append(reader.readVariantMap(0));
+
+  if(!reader.isValid() || !reader.atEnd()) {
+    debug("Serialization::deserialize() -- Invalid complex properties data.");
+    return false;
+  }
+
+  properties = result;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// PropertyMapView
+////////////////////////////////////////////////////////////////////////////////
+
+class Serialization::PropertyMapView::PropertyMapViewPrivate
+{
+public:
+  struct Entry {
+    ByteVector key;
+    unsigned int valuesOffset;
+  };
+
+  PropertyMapViewPrivate(const ByteVector &data) :
+    data(data)
+  {
+  }
+
+  ByteVectorList readValues(unsigned int offset) const
+  {
+    // The offsets have been validated when indexing the data, so the values
+    // can be read without further checks.
+    ByteVectorList values;
+    unsigned int count = data.toUInt(offset, false);
+    unsigned int pos = offset + 4;
+    for(; count > 0; --count) {
+      const unsigned int length = data.toUInt(pos, false);
+      pos += 4;
+      values.append(data.mid(pos, length));
+      pos += length;
+    }
+    return values;
+  }
+
+  const ByteVector data;
+  std::vector<Entry> entries;
+  unsigned int unsupportedOffset { 0 };
+  bool valid { false };
+};
+
+Serialization::PropertyMapView::PropertyMapView(const ByteVector &data) :
+  d(std::make_unique<PropertyMapViewPrivate>(data))
+{
+  Reader reader(d->data, PropertyMapKind);
+  const unsigned int count = reader.readCount(8);
+  d->entries.reserve(count);
+  for(unsigned int i = 0; i < count && reader.isValid(); ++i) {
+    const ByteVector key = reader.readBytes();
+    const unsigned int valuesOffset = reader.position();
+    for(unsigned int j = reader.readCount(4); j > 0 && reader.isValid(); --j)
+      reader.readBytes();
+    d->entries.push_back({ key, valuesOffset });
+  }
+  d->unsupportedOffset = reader.position();
+  for(unsigned int j = reader.readCount(4); j > 0 && reader.isValid(); --j)
+    reader.readBytes();
+
+  d->valid = reader.isValid() && reader.atEnd();
+  if(!d->valid) {
+    debug("Serialization::PropertyMapView -- Invalid property map data.");
+    d->entries.clear();
+  }
+}
+
+Serialization::PropertyMapView::~PropertyMapView() = default;
+
+bool Serialization::PropertyMapView::isValid() const
+{
+  return d->valid;
+}
+
+unsigned int Serialization::PropertyMapView::size() const
+{
+  return static_cast<unsigned int>(d->entries.size());
+}
+
+ByteVector Serialization::PropertyMapView::key(unsigned int index) const
+{
+  if(index >= d->entries.size())
+    return ByteVector();
+  return d->entries[index].key;
+}
+
+ByteVectorList Serialization::PropertyMapView::values(unsigned int index) const
+{
+  if(index >= d->entries.size())
+    return ByteVectorList();
+  return d->readValues(d->entries[index].valuesOffset);
+}
+
+int Serialization::PropertyMapView::find(const String &key) const
+{
+  const ByteVector utf8Key = key.upper().data(String::UTF8);
+  for(size_t i = 0; i < d->entries.size(); ++i) {
+    if(d->entries[i].key == utf8Key)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+StringList Serialization::PropertyMapView::value(const String &key) const
+{
+  StringList result;
+  if(const int index = find(key); index >= 0) {
+    for(const auto &value : values(index))
+      result.append(String(value, String::UTF8));
+  }
+  return result;
+}
+
+ByteVectorList Serialization::PropertyMapView::unsupportedData() const
+{
+  if(!d->valid)
+    return ByteVectorList();
+  return d->readValues(d->unsupportedOffset);
+}
+
+PropertyMap Serialization::PropertyMapView::toPropertyMap() const
+{
+  PropertyMap properties;
+  if(d->valid)
+    Serialization::deserialize(d->data, properties);
+  return properties;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// AudioPropertiesSnapshot
+////////////////////////////////////////////////////////////////////////////////
+
+class AudioPropertiesSnapshot::AudioPropertiesSnapshotPrivate
+{
+public:
+  int length { 0 };
+  int bitrate { 0 };
+  int sampleRate { 0 };
+  int channels { 0 };
+};
+
+AudioPropertiesSnapshot::AudioPropertiesSnapshot() :
+  AudioProperties(AudioProperties::Average),
+  d(std::make_unique<AudioPropertiesSnapshotPrivate>())
+{
+}
+
+AudioPropertiesSnapshot::AudioPropertiesSnapshot(const AudioProperties &properties) :
+  AudioProperties(AudioProperties::Average),
+  d(std::make_unique<AudioPropertiesSnapshotPrivate>())
+{
+  d->length     = properties.lengthInMilliseconds();
+  d->bitrate    = properties.bitrate();
+  d->sampleRate = properties.sampleRate();
+  d->channels   = properties.channels();
+}
+
+AudioPropertiesSnapshot::~AudioPropertiesSnapshot() = default;
+
+int AudioPropertiesSnapshot::lengthInMilliseconds() const
+{
+  return d->length;
+}
+
+int AudioPropertiesSnapshot::bitrate() const
+{
+  return d->bitrate;
+}
+
+int AudioPropertiesSnapshot::sampleRate() const
+{
+  return d->sampleRate;
+}
+
+int AudioPropertiesSnapshot::channels() const
+{
+  return d->channels;
+}
+
+bool Serialization::deserialize(const ByteVector &data, AudioPropertiesSnapshot &properties)
+{
+  Reader reader(data, AudioPropertiesKind);
+  const int length     = static_cast<int>(reader.readUInt());
+  const int bitrate    = static_cast<int>(reader.readUInt());
+  const int sampleRate = static_cast<int>(reader.readUInt());
+  const int channels   = static_cast<int>(reader.readUInt());
+
+  if(!reader.isValid() || !reader.atEnd()) {
+    debug("Serialization::deserialize() -- Invalid audio properties data.");
+    return false;
+  }
+
+  properties.d->length     = length;
+  properties.d->bitrate    = bitrate;
+  properties.d->sampleRate = sampleRate;
+  properties.d->channels   = channels;
+  return true;
+}
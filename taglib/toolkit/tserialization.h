@@ -0,0 +1,226 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#ifndef TAGLIB_SERIALIZATION_H
+#define TAGLIB_SERIALIZATION_H
+
+#include "tbytevector.h"
+#include "tbytevectorlist.h"
+#include "tpropertymap.h"
+#include "tvariant.h"
+#include "taglib_export.h"
+#include "audioproperties.h"
+
+namespace TagLib {
+
+  class AudioPropertiesSnapshot;
+
+  //! Compact binary serialization of metadata containers
+
+  /*!
+   * These functions convert property maps, complex properties and audio
+   * properties to and from a compact, length-prefixed binary representation.
+   * It is intended to pass metadata read by TagLib between processes without
+   * the cost of a textual format.
+   *
+   * All serialized data starts with the four bytes "TLSR", a format version
+   * byte and a byte identifying the serialized container.  Integers are stored
+   * as little-endian values, strings as UTF-8 with a 32-bit length prefix.
+   * The format is not meant for long-term storage, it is only guaranteed to
+   * be readable by the same format version.
+   */
+
+  namespace Serialization {
+
+    /*!
+     * Returns the binary representation of \a properties including its
+     * unsupportedData() list.
+     */
+    TAGLIB_EXPORT ByteVector serialize(const PropertyMap &properties);
+
+    /*!
+     * Returns the binary representation of the complex properties
+     * \a properties, as returned by File::complexProperties().
+     */
+    TAGLIB_EXPORT ByteVector serialize(const List<VariantMap> &properties);
+
+    /*!
+     * Returns the binary representation of the values of \a properties which
+     * are common to all audio formats.
+     *
+     * \see AudioPropertiesSnapshot
+     */
+    TAGLIB_EXPORT ByteVector serialize(const AudioProperties &properties);
+
+    /*!
+     * Replaces the contents of \a properties with the property map stored in
+     * \a data.  Returns \c false and leaves \a properties untouched if \a data
+     * is not a valid serialized property map.
+     */
+    TAGLIB_EXPORT bool deserialize(const ByteVector &data, PropertyMap &properties);
+
+    /*!
+     * Replaces the contents of \a properties with the complex properties
+     * stored in \a data.  Returns \c false and leaves \a properties untouched
+     * if \a data is not a valid serialized list of variant maps.
+     */
+    TAGLIB_EXPORT bool deserialize(const ByteVector &data, List<VariantMap> &properties);
+
+    /*!
+     * Replaces the values of \a properties with the audio properties stored in
+     * \a data.  Returns \c false and leaves \a properties untouched if \a data
+     * is not a valid serialized audio properties snapshot.
+     */
+    TAGLIB_EXPORT bool deserialize(const ByteVector &data, AudioPropertiesSnapshot &properties);
+
+    //! A read-only view on a serialized property map
+
+    /*!
+     * This class gives access to the entries of a serialized property map
+     * without building a PropertyMap.  The keys and values are returned as
+     * UTF-8 encoded byte vectors which share the memory of the serialized
+     * data, so no string data is copied or converted until it is needed.
+     *
+     * \code
+     * Serialization::PropertyMapView view(data);
+     * for(unsigned int i = 0; i < view.size(); ++i) {
+     *   if(view.key(i) == "TITLE")
+     *     indexTitle(view.values(i));
+     * }
+     * \endcode
+     */
+    class TAGLIB_EXPORT PropertyMapView
+    {
+    public:
+      /*!
+       * Constructs a view on the serialized property map \a data.  Only the
+       * entry offsets are indexed, \a data itself is not copied.
+       */
+      explicit PropertyMapView(const ByteVector &data);
+
+      /*!
+       * Destroys this PropertyMapView instance.
+       */
+      ~PropertyMapView();
+
+      PropertyMapView(const PropertyMapView &) = delete;
+      PropertyMapView &operator=(const PropertyMapView &) = delete;
+
+      /*!
+       * Returns \c true if the data passed to the constructor is a valid
+       * serialized property map.
+       */
+      bool isValid() const;
+
+      /*!
+       * Returns the number of keys in the map.
+       */
+      unsigned int size() const;
+
+      /*!
+       * Returns the UTF-8 encoded key of the entry at \a index.
+       */
+      ByteVector key(unsigned int index) const;
+
+      /*!
+       * Returns the UTF-8 encoded values of the entry at \a index.
+       */
+      ByteVectorList values(unsigned int index) const;
+
+      /*!
+       * Returns the index of the entry for \a key or -1 if the map does not
+       * contain \a key.  The lookup is case-insensitive as for PropertyMap.
+       */
+      int find(const String &key) const;
+
+      /*!
+       * Returns the values for \a key decoded to strings or an empty list if
+       * the map does not contain \a key.
+       */
+      StringList value(const String &key) const;
+
+      /*!
+       * Returns the UTF-8 encoded unsupported data entries of the map.
+       */
+      ByteVectorList unsupportedData() const;
+
+      /*!
+       * Decodes all entries and returns them as a PropertyMap.
+       */
+      PropertyMap toPropertyMap() const;
+
+    private:
+      class PropertyMapViewPrivate;
+      TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+      std::unique_ptr<PropertyMapViewPrivate> d;
+    };
+
+  }  // namespace Serialization
+
+  //! A detached copy of the common audio properties
+
+  /*!
+   * This class stores the values of the AudioProperties interface of a file,
+   * so that they can be used after the file has been closed or passed to
+   * another process using Serialization::serialize() and
+   * Serialization::deserialize().
+   */
+  class TAGLIB_EXPORT AudioPropertiesSnapshot : public AudioProperties
+  {
+  public:
+    /*!
+     * Constructs an empty snapshot, all values are 0.
+     */
+    AudioPropertiesSnapshot();
+
+    /*!
+     * Constructs a snapshot of the values of \a properties.
+     */
+    explicit AudioPropertiesSnapshot(const AudioProperties &properties);
+
+    /*!
+     * Destroys this AudioPropertiesSnapshot instance.
+     */
+    ~AudioPropertiesSnapshot() override;
+
+    AudioPropertiesSnapshot(const AudioPropertiesSnapshot &) = delete;
+    AudioPropertiesSnapshot &operator=(const AudioPropertiesSnapshot &) = delete;
+
+    int lengthInMilliseconds() const override;
+    int bitrate() const override;
+    int sampleRate() const override;
+    int channels() const override;
+
+  private:
+    friend bool Serialization::deserialize(const ByteVector &, AudioPropertiesSnapshot &);
+
+    class AudioPropertiesSnapshotPrivate;
+    TAGLIB_MSVC_SUPPRESS_WARNING_NEEDS_TO_HAVE_DLL_INTERFACE
+    std::unique_ptr<AudioPropertiesSnapshotPrivate> d;
+  };
+
+}  // namespace TagLib
+
+#endif
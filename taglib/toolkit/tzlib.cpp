@@ -30,6 +30,8 @@
 #endif
 
 #ifdef HAVE_ZLIB
+# include <algorithm>
+# include <limits>
 # include <zlib.h>
 # include "tstring.h"
 # include "tdebug.h"
@@ -37,6 +39,60 @@
 
 using namespace TagLib;
 
+#ifdef HAVE_ZLIB
+
+namespace
+{
+  // A zlib stream which is initialized on first use and reset for each
+  // further use, so that its state is not allocated again for every frame.
+
+  template <bool Deflate>
+  class StreamContext
+  {
+  public:
+    StreamContext() = default;
+    StreamContext(const StreamContext &) = delete;
+    StreamContext &operator=(const StreamContext &) = delete;
+
+    ~StreamContext()
+    {
+      if(initialized) {
+        if constexpr(Deflate)
+          deflateEnd(&zstream);
+        else
+          inflateEnd(&zstream);
+      }
+    }
+
+    z_stream *stream()
+    {
+      if(initialized) {
+        if constexpr(Deflate)
+          initialized = deflateReset(&zstream) == Z_OK;
+        else
+          initialized = inflateReset(&zstream) == Z_OK;
+      }
+      if(!initialized) {
+        zstream = {};
+        if constexpr(Deflate)
+          initialized = deflateInit(&zstream, Z_DEFAULT_COMPRESSION) == Z_OK;
+        else
+          initialized = inflateInit(&zstream) == Z_OK;
+      }
+      return initialized ? &zstream : nullptr;
+    }
+
+  private:
+    z_stream zstream {};
+    bool initialized { false };
+  };
+
+  thread_local StreamContext<false> inflateContext;
+  thread_local StreamContext<true> deflateContext;
+}  // namespace
+
+#endif
+
 bool zlib::isAvailable()
 {
 #ifdef HAVE_ZLIB
@@ -50,50 +106,100 @@ bool zlib::isAvailable()
 #endif
 }
 
-ByteVector zlib::decompress([[maybe_unused]] const ByteVector &data)
+ByteVector zlib::decompress([[maybe_unused]] const ByteVector &data,
+                            [[maybe_unused]] unsigned int size)
 {
 #ifdef HAVE_ZLIB
 
-  z_stream stream = {};
-
-  if(inflateInit(&stream) != Z_OK) {
+  z_stream *stream = inflateContext.stream();
+  if(!stream) {
     debug("zlib::decompress() - Failed to initialize zlib.");
     return ByteVector();
   }
 
-  ByteVector inData = data;
-
-  stream.avail_in = inData.size();
-  stream.next_in  = reinterpret_cast<Bytef *>(inData.data());
-
-  ByteVector outData;
+  // zlib does not modify the input, so it is not copied.
+
+  stream->avail_in = data.size();
+  stream->next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+
+  // Trust the expected size only as far as zlib could possibly inflate the
+  // data, so that a corrupt size cannot cause a huge allocation.
+
+  constexpr unsigned int chunkSize = 1024;
+  constexpr unsigned int maxRatio = 1032;
+  unsigned int capacity = chunkSize;
+  if(size > 0 && size / maxRatio <= data.size())
+    capacity = size;
+  else if(data.size() < std::numeric_limits<unsigned int>::max() / 4)
+    capacity = std::max(capacity, data.size() * 4);
+
+  ByteVector outData(capacity);
+  unsigned int outSize = 0;
+
+  while(true) {
+    if(outSize == outData.size()) {
+      const unsigned int growth = std::min(
+        std::max(outData.size(), chunkSize),
+        std::numeric_limits<unsigned int>::max() - outData.size());
+      if(growth == 0) {
+        debug("zlib::decompress() - Decompressed data is too large.");
+        return ByteVector();
+      }
+      outData.resize(outData.size() + growth);
+    }
 
-  do {
-    constexpr unsigned int chunkSize = 1024;
-    const size_t offset = outData.size();
-    outData.resize(outData.size() + chunkSize);
+    stream->avail_out = static_cast<uInt>(outData.size() - outSize);
+    stream->next_out  = reinterpret_cast<Bytef *>(outData.data() + outSize);
 
-    stream.avail_out = static_cast<uInt>(chunkSize);
-    stream.next_out  = reinterpret_cast<Bytef *>(outData.data() + offset);
+    const int result = inflate(stream, Z_NO_FLUSH);
+    outSize = outData.size() - stream->avail_out;
 
-    if(const int result = inflate(&stream, Z_NO_FLUSH);
-       result == Z_STREAM_ERROR ||
-       result == Z_NEED_DICT ||
-       result == Z_DATA_ERROR ||
-       result == Z_MEM_ERROR)
-    {
-      if(result != Z_STREAM_ERROR)
-        inflateEnd(&stream);
+    if(result == Z_STREAM_END)
+      break;
 
+    if(result != Z_OK && result != Z_BUF_ERROR) {
       debug("zlib::decompress() - Error reading compressed stream.");
       return ByteVector();
     }
 
-    outData.resize(outData.size() - stream.avail_out);
-  } while(stream.avail_out == 0);
+    // The input is exhausted before the end of the stream.
+    if(stream->avail_out != 0)
+      break;
+  }
+
+  outData.resize(outSize);
+  return outData;
+
+#else
+
+  return ByteVector();
 
-  inflateEnd(&stream);
+#endif
+}
+
+ByteVector zlib::compress([[maybe_unused]] const ByteVector &data)
+{
+#ifdef HAVE_ZLIB
+
+  z_stream *stream = deflateContext.stream();
+  if(!stream) {
+    debug("zlib::compress() - Failed to initialize zlib.");
+    return ByteVector();
+  }
+
+  ByteVector outData(static_cast<unsigned int>(deflateBound(stream, data.size())));
+
+  stream->avail_in  = data.size();
+  stream->next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  stream->avail_out = static_cast<uInt>(outData.size());
+  stream->next_out  = reinterpret_cast<Bytef *>(outData.data());
+
+  if(deflate(stream, Z_FINISH) != Z_STREAM_END) {
+    debug("zlib::compress() - Error writing compressed stream.");
+    return ByteVector();
+  }
 
+  outData.resize(outData.size() - stream->avail_out);
   return outData;
 
 #else
@@ -42,9 +42,19 @@ namespace TagLib {
      bool TAGLIB_EXPORT isAvailable();
 
      /*!
-      * Decompress \a data by zlib.
+      * Decompress \a data by zlib.  If the decompressed \a size is known, e.g.
+      * from the data length indicator of an ID3v2 frame, the output is
+      * allocated at once, otherwise it is grown geometrically.  The zlib
+      * stream is reused for all calls from the same thread.
       */
-     ByteVector decompress(const ByteVector &data);
+     ByteVector decompress(const ByteVector &data, unsigned int size = 0);
+
+     /*!
+      * Compress \a data by zlib.  Returns an empty ByteVector if zlib is not
+      * available or compression fails.  The zlib stream is reused for all
+      * calls from the same thread.
+      */
+     ByteVector compress(const ByteVector &data);
 
   }  // namespace zlib
 }  // namespace TagLib
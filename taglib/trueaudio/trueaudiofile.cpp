@@ -79,43 +79,43 @@ bool TrueAudio::File::isSupported(IOStream *stream)
 ////////////////////////////////////////////////////////////////////////////////
 
 TrueAudio::File::File(FileName file, bool readProperties,
-                      Properties::ReadStyle,
+                      Properties::ReadStyle readStyle,
                       ID3v2::FrameFactory *frameFactory) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>(
     frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 TrueAudio::File::File(FileName file, ID3v2::FrameFactory *frameFactory,
-                      bool readProperties, Properties::ReadStyle) :
+                      bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(file),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 TrueAudio::File::File(IOStream *stream, bool readProperties,
-                      Properties::ReadStyle,
+                      Properties::ReadStyle readStyle,
                       ID3v2::FrameFactory *frameFactory) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>(
     frameFactory ? frameFactory : ID3v2::FrameFactory::instance()))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 TrueAudio::File::File(IOStream *stream, ID3v2::FrameFactory *frameFactory,
-                      bool readProperties, Properties::ReadStyle) :
+                      bool readProperties, Properties::ReadStyle readStyle) :
   TagLib::File(stream),
   d(std::make_unique<FilePrivate>(frameFactory))
 {
   if(isOpen())
-    read(readProperties);
+    read(readProperties && readStyle != Properties::TagsOnly);
 }
 
 TrueAudio::File::~File() = default;
@@ -165,7 +165,7 @@ bool TrueAudio::File::save()
       d->ID3v2Location = 0;
 
     const ByteVector data = ID3v2Tag()->render();
-    insert(data, d->ID3v2Location, d->ID3v2OriginalSize);
+    ID3v2Tag()->write(this, data, d->ID3v2Location, d->ID3v2OriginalSize);
 
     if(d->ID3v1Location >= 0)
       d->ID3v1Location += static_cast<long>(data.size()) - d->ID3v2OriginalSize;
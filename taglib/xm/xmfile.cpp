@@ -344,19 +344,21 @@ private:
 class XM::File::FilePrivate
 {
 public:
-  FilePrivate(AudioProperties::ReadStyle propertiesStyle)
-    :  properties(propertiesStyle)
+  FilePrivate(bool readAudioProperties, AudioProperties::ReadStyle propertiesStyle)
+    : properties(propertiesStyle),
+      readProperties(readAudioProperties && propertiesStyle != AudioProperties::TagsOnly)
   {
   }
 
   Mod::Tag       tag;
   XM::Properties properties;
+  bool readProperties;
 };
 
 XM::File::File(FileName file, bool readProperties,
                AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(file),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -365,7 +367,7 @@ XM::File::File(FileName file, bool readProperties,
 XM::File::File(IOStream *stream, bool readProperties,
                AudioProperties::ReadStyle propertiesStyle) :
   Mod::FileBase(stream),
-  d(std::make_unique<FilePrivate>(propertiesStyle))
+  d(std::make_unique<FilePrivate>(readProperties, propertiesStyle))
 {
   if(isOpen())
     read(readProperties);
@@ -390,7 +392,7 @@ PropertyMap XM::File::setProperties(const PropertyMap &properties)
 
 XM::Properties *XM::File::audioProperties() const
 {
-  return &d->properties;
+  return d->readProperties ? &d->properties : nullptr;
 }
 
 bool XM::File::save()
@@ -57,9 +57,9 @@ namespace TagLib {
         /*!
          * Constructs an Extended Module file from \a file.
          *
-         * \note In the current implementation, both \a readProperties and
-         * \a propertiesStyle are ignored.  The audio properties are always
-         * read.
+         * \note The module header is always parsed, as the tag depends on it,
+         * but audioProperties() returns a null pointer if \a readProperties is
+         * \c false or \a propertiesStyle is AudioProperties::TagsOnly.
          */
         File(FileName file, bool readProperties = true,
              AudioProperties::ReadStyle propertiesStyle =
@@ -68,9 +68,9 @@ namespace TagLib {
         /*!
          * Constructs an Extended Module file from \a stream.
          *
-         * \note In the current implementation, both \a readProperties and
-         * \a propertiesStyle are ignored.  The audio properties are always
-         * read.
+         * \note The module header is always parsed, as the tag depends on it,
+         * but audioProperties() returns a null pointer if \a readProperties is
+         * \c false or \a propertiesStyle is AudioProperties::TagsOnly.
          *
          * \note TagLib will *not* take ownership of the stream, the caller is
          * responsible for deleting it after the File object.
@@ -32,6 +32,8 @@
 #include "apetag.h"
 #include "id3v1tag.h"
 #include "apefile.h"
+#include "tbytevectorstream.h"
+#include "plainfile.h"
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -49,6 +51,7 @@ class TestAPE : public CppUnit::TestFixture
   CPPUNIT_TEST(testFuzzedFile1);
   CPPUNIT_TEST(testFuzzedFile2);
   CPPUNIT_TEST(testStripAndProperties);
+  CPPUNIT_TEST(testStripTo);
   CPPUNIT_TEST(testRepeatedSave);
   CPPUNIT_TEST_SUITE_END();
 
@@ -156,6 +159,33 @@ public:
     }
   }
 
+  void testStripTo()
+  {
+    ScopedFileCopy copy("mac-399", ".ape");
+    {
+      APE::File f(copy.fileName().c_str());
+      f.APETag(true)->setTitle("APE");
+      f.ID3v1Tag(true)->setTitle("ID3v1");
+      f.save();
+    }
+    const ByteVector data = PlainFile(copy.fileName().c_str()).readAll();
+
+    APE::File f(copy.fileName().c_str());
+    ByteVectorStream target(data);
+    CPPUNIT_ASSERT(f.stripTo(APE::File::APE, &target));
+    {
+      APE::File stripped(&target);
+      CPPUNIT_ASSERT(stripped.isValid());
+      CPPUNIT_ASSERT(!stripped.hasAPETag());
+      CPPUNIT_ASSERT(stripped.hasID3v1Tag());
+      CPPUNIT_ASSERT_EQUAL(String("ID3v1"), stripped.tag()->title());
+    }
+
+    CPPUNIT_ASSERT(f.stripTo(APE::File::AllTags, &target));
+    CPPUNIT_ASSERT_EQUAL(PlainFile(TEST_FILE_PATH_C("mac-399.ape")).readAll(), *target.data());
+    CPPUNIT_ASSERT_EQUAL(data, PlainFile(copy.fileName().c_str()).readAll());
+  }
+
   void testProperties()
   {
     PropertyMap tags;
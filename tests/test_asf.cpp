@@ -31,6 +31,7 @@
 #include "tpropertymap.h"
 #include "tag.h"
 #include "asffile.h"
+#include "plainfile.h"
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -53,6 +54,8 @@ class TestASF : public CppUnit::TestFixture
   CPPUNIT_TEST(testProperties);
   CPPUNIT_TEST(testPropertiesAllSupported);
   CPPUNIT_TEST(testRepeatedSave);
+  CPPUNIT_TEST(testPaddingPolicy);
+  CPPUNIT_TEST(testIsModified);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -404,6 +407,65 @@ public:
     CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(68202), f.length());
   }
 
+  void testPaddingPolicy()
+  {
+    ScopedFileCopy copy("silence-1", ".wma");
+
+    PaddingPolicy policy;
+    policy.setReserve(8192);
+    policy.setShrinkMode(PaddingPolicy::NeverShrink);
+
+    offset_t length;
+    {
+      ASF::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      f.tag()->setTitle(longText(16 * 1024));
+      f.save();
+      length = f.length();
+    }
+    {
+      ASF::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      f.tag()->setTitle("title");
+      f.tag()->setArtist(longText(4 * 1024));
+      f.save();
+      CPPUNIT_ASSERT_EQUAL(length, f.length());
+    }
+    {
+      ASF::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(f.isValid());
+      CPPUNIT_ASSERT_EQUAL(String("title"), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(longText(4 * 1024), f.tag()->artist());
+      CPPUNIT_ASSERT_EQUAL(3712, f.audioProperties()->lengthInMilliseconds());
+    }
+  }
+
+  void testIsModified()
+  {
+    ScopedFileCopy copy("silence-1", ".wma");
+    {
+      ASF::File f(copy.fileName().c_str());
+      f.tag()->setTitle("Title");
+      CPPUNIT_ASSERT(f.isModified());
+      f.save();
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    const ByteVector fileData = PlainFile(copy.fileName().c_str()).readAll();
+    {
+      ASF::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.setProperties(f.properties());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.save();
+    }
+    CPPUNIT_ASSERT_EQUAL(fileData, PlainFile(copy.fileName().c_str()).readAll());
+    {
+      ASF::File f(copy.fileName().c_str());
+      f.tag()->setTitle("Other");
+      CPPUNIT_ASSERT(f.isModified());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestASF);
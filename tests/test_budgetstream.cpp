@@ -0,0 +1,192 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include <chrono>
+#include <thread>
+
+#include "tbudgetstream.h"
+#include "tbytevectorstream.h"
+#include "mpegfile.h"
+#include "fileref.h"
+#include "plainfile.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace std;
+using namespace TagLib;
+
+class TestBudgetStream : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestBudgetStream);
+  CPPUNIT_TEST(testUnlimited);
+  CPPUNIT_TEST(testMaxBytesRead);
+  CPPUNIT_TEST(testMaxSeeks);
+  CPPUNIT_TEST(testTimeout);
+  CPPUNIT_TEST(testCancel);
+  CPPUNIT_TEST(testScanStopped);
+  CPPUNIT_TEST(testExhaustedFileRef);
+  CPPUNIT_TEST(testWriteNotInterrupted);
+  CPPUNIT_TEST(testWithinBudget);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+
+  void testUnlimited()
+  {
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    BudgetStream stream(&data);
+
+    stream.seek(2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("cdef"), stream.readBlock(4));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(6), stream.tell());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(8), stream.length());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(4), stream.bytesRead());
+    CPPUNIT_ASSERT_EQUAL(1U, stream.seekCount());
+    CPPUNIT_ASSERT(stream.isOpen());
+    CPPUNIT_ASSERT(!stream.isExhausted());
+  }
+
+  void testMaxBytesRead()
+  {
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    BudgetStream stream(&data);
+    stream.setMaxBytesRead(6);
+
+    CPPUNIT_ASSERT_EQUAL(ByteVector("abcd"), stream.readBlock(4));
+    CPPUNIT_ASSERT(!stream.isExhausted());
+    CPPUNIT_ASSERT(stream.readBlock(4).isEmpty());
+    CPPUNIT_ASSERT(stream.isExhausted());
+    CPPUNIT_ASSERT(stream.isOpen());
+    CPPUNIT_ASSERT(stream.readOnly());
+    CPPUNIT_ASSERT(stream.readBlock(1).isEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(4), stream.bytesRead());
+
+    stream.seek(0);
+    stream.writeBlock("xy");
+    CPPUNIT_ASSERT_EQUAL(ByteVector("abcdefgh"), *data.data());
+  }
+
+  void testMaxSeeks()
+  {
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    BudgetStream stream(&data);
+    stream.setMaxSeeks(2);
+
+    stream.seek(1);
+    stream.seek(2);
+    CPPUNIT_ASSERT(!stream.isExhausted());
+    stream.seek(3);
+    CPPUNIT_ASSERT(stream.isExhausted());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(2), stream.tell());
+    CPPUNIT_ASSERT(stream.readBlock(1).isEmpty());
+  }
+
+  void testTimeout()
+  {
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    BudgetStream stream(&data);
+    stream.setTimeout(1);
+
+    this_thread::sleep_for(chrono::milliseconds(10));
+    CPPUNIT_ASSERT(stream.readBlock(1).isEmpty());
+    CPPUNIT_ASSERT(stream.isExhausted());
+  }
+
+  void testCancel()
+  {
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    CancellationToken token;
+    BudgetStream stream(&data);
+    stream.setCancellationToken(&token);
+
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ab"), stream.readBlock(2));
+    token.cancel();
+    CPPUNIT_ASSERT(token.isCancelled());
+    CPPUNIT_ASSERT(stream.readBlock(2).isEmpty());
+    CPPUNIT_ASSERT(stream.isExhausted());
+  }
+
+  void testScanStopped()
+  {
+    // Without a budget, the search for the first MPEG frame reads the
+    // whole file.
+
+    ByteVectorStream data(ByteVector(1024 * 1024, '\0'));
+    BudgetStream stream(&data);
+    stream.setMaxBytesRead(64 * 1024);
+
+    MPEG::File f(&stream);
+    CPPUNIT_ASSERT(!f.isValid());
+    CPPUNIT_ASSERT(f.readOnly());
+    CPPUNIT_ASSERT(!f.save());
+    CPPUNIT_ASSERT(stream.isExhausted());
+    CPPUNIT_ASSERT(stream.bytesRead() <= 64 * 1024);
+  }
+
+  void testExhaustedFileRef()
+  {
+    ByteVectorStream data(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    BudgetStream stream(&data);
+    stream.setMaxBytesRead(100);
+
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(f.isNull());
+    CPPUNIT_ASSERT(stream.isExhausted());
+  }
+
+  void testWriteNotInterrupted()
+  {
+    // Once the stream is written, the limits are not enforced anymore.
+    ByteVectorStream data(ByteVector("abcdefgh"));
+    BudgetStream stream(&data);
+    stream.setMaxSeeks(1);
+
+    stream.seek(0);
+    stream.writeBlock("xy");
+    stream.seek(4);
+    stream.writeBlock("z");
+    stream.seek(0);
+    CPPUNIT_ASSERT(!stream.isExhausted());
+    CPPUNIT_ASSERT(!stream.readOnly());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("xycdzfgh"), stream.readBlock(8));
+  }
+
+  void testWithinBudget()
+  {
+    ByteVectorStream data(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    BudgetStream stream(&data);
+    stream.setMaxBytesRead(64 * 1024);
+    stream.setMaxSeeks(100);
+    stream.setTimeout(10000);
+
+    FileRef f(&stream);
+    CPPUNIT_ASSERT(!f.isNull());
+    CPPUNIT_ASSERT(f.audioProperties());
+    CPPUNIT_ASSERT(!stream.isExhausted());
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestBudgetStream);
@@ -23,13 +23,34 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <cstdio>
+
 #include "tfile.h"
+#include "tfilestream.h"
+#include "tbytevectorstream.h"
 #include "plainfile.h"
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
 using namespace TagLib;
 
+namespace
+{
+  // Restores the default padding policy when it goes out of scope.
+  class ScopedDefaultPaddingPolicy
+  {
+  public:
+    ScopedDefaultPaddingPolicy() : policy(PaddingPolicy::defaultPolicy()) {}
+    ~ScopedDefaultPaddingPolicy() { PaddingPolicy::setDefaultPolicy(policy); }
+
+    ScopedDefaultPaddingPolicy(const ScopedDefaultPaddingPolicy &) = delete;
+    ScopedDefaultPaddingPolicy &operator=(const ScopedDefaultPaddingPolicy &) = delete;
+
+  private:
+    const PaddingPolicy policy;
+  };
+}  // namespace
+
 class TestFile : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestFile);
@@ -37,6 +58,10 @@ class TestFile : public CppUnit::TestFixture
   CPPUNIT_TEST(testRFindInSmallFile);
   CPPUNIT_TEST(testSeek);
   CPPUNIT_TEST(testTruncate);
+  CPPUNIT_TEST(testCopyTo);
+  CPPUNIT_TEST(testRemoveBlock);
+  CPPUNIT_TEST(testCopyToStream);
+  CPPUNIT_TEST(testPaddingPolicy);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -139,6 +164,115 @@ public:
     }
   }
 
+  void testCopyTo()
+  {
+    const ByteVector data = PlainFile(TEST_FILE_PATH_C("empty.ogg")).readAll();
+    FILE *output = tmpfile();
+    CPPUNIT_ASSERT(output);
+
+    FileStream stream(TEST_FILE_PATH_C("empty.ogg"), true);
+    stream.seek(100);
+    CPPUNIT_ASSERT(stream.copyTo(fileno(output), 1000, 3000));
+    CPPUNIT_ASSERT(stream.copyTo(fileno(output), 0, 10));
+    CPPUNIT_ASSERT(!stream.copyTo(fileno(output), 4320, 10));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(100), stream.tell());
+
+    ByteVector copied(3018U);
+    rewind(output);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3018),
+                         fread(copied.data(), 1, copied.size(), output));
+    CPPUNIT_ASSERT_EQUAL(data.mid(1000, 3000) + data.mid(0, 10) + data.mid(4320),
+                         copied);
+    fclose(output);
+  }
+
+  void testRemoveBlock()
+  {
+    ScopedFileCopy copy("sinewave", ".flac");
+    const ByteVector data = PlainFile(copy.fileName().c_str()).readAll();
+
+    FileStream stream(copy.fileName().c_str());
+
+    // The length is a multiple of common file system block sizes, so the
+    // block can be collapsed if supported.
+    stream.removeBlock(100, 8192);
+    stream.removeBlock(5000, 100);
+    stream.removeBlock(8192, 8192);
+
+    ByteVector expected = data.mid(0, 100) + data.mid(8292);
+    expected = expected.mid(0, 5000) + expected.mid(5100);
+    expected = expected.mid(0, 8192) + expected.mid(16384);
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(expected.size()), stream.length());
+    stream.seek(0);
+    CPPUNIT_ASSERT_EQUAL(expected, stream.readBlock(expected.size()));
+  }
+
+  void testCopyToStream()
+  {
+    const ByteVector data = PlainFile(TEST_FILE_PATH_C("empty.ogg")).readAll();
+
+    PlainFile f(TEST_FILE_PATH_C("empty.ogg"));
+    ByteVectorStream target(ByteVector(5000, 'x'));
+    Map<offset_t, size_t> skippedBlocks;
+    skippedBlocks.insert(100, 50);
+    skippedBlocks.insert(120, 100);
+    skippedBlocks.insert(4300, 100);
+    CPPUNIT_ASSERT(f.copyTo(&target, skippedBlocks));
+    CPPUNIT_ASSERT_EQUAL(data.mid(0, 100) + data.mid(220, 4080), *target.data());
+
+    CPPUNIT_ASSERT(f.copyTo(&target, Map<offset_t, size_t>()));
+    CPPUNIT_ASSERT_EQUAL(data, *target.data());
+
+    CPPUNIT_ASSERT(!f.copyTo(nullptr, skippedBlocks));
+  }
+
+  void testPaddingPolicy()
+  {
+    PaddingPolicy policy;
+    CPPUNIT_ASSERT_EQUAL(-1, policy.reserve());
+    CPPUNIT_ASSERT_EQUAL(PaddingPolicy::DefaultShrinkMode, policy.shrinkMode());
+
+    // The defaults of the format are used.
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(1024),
+      policy.padding(-10, 1000000, 1024, PaddingPolicy::ShrinkLargePadding));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(5000),
+      policy.padding(5000, 1000000, 1024, PaddingPolicy::ShrinkLargePadding));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(1024),
+      policy.padding(20000, 1000000, 1024, PaddingPolicy::ShrinkLargePadding));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(20000),
+      policy.padding(20000, 1000000, 1024, PaddingPolicy::NeverShrink));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(0),
+      policy.padding(20000, 1000000, 0, PaddingPolicy::AlwaysShrink));
+
+    policy.setReserve(4096);
+    policy.setPercentage(2);
+    policy.setMaximum(15000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(15000),
+      policy.padding(-10, 1000000, 1024, PaddingPolicy::ShrinkLargePadding));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(4096),
+      policy.padding(-10, 100000, 1024, PaddingPolicy::ShrinkLargePadding));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(12000),
+      policy.padding(12000, 1000000, 1024, PaddingPolicy::ShrinkLargePadding));
+
+    policy.setShrinkMode(PaddingPolicy::AlwaysShrink);
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(15000),
+      policy.padding(12000, 1000000, 1024, PaddingPolicy::NeverShrink));
+
+    // A file uses the default policy unless it has its own.  The global
+    // default is restored even if an assertion fails.
+    {
+      const ScopedDefaultPaddingPolicy restoreDefault;
+      PaddingPolicy defaultPolicy;
+      defaultPolicy.setReserve(100);
+      PaddingPolicy::setDefaultPolicy(defaultPolicy);
+      PlainFile file(TEST_FILE_PATH_C("empty.ogg"));
+      CPPUNIT_ASSERT_EQUAL(100, file.paddingPolicy().reserve());
+      file.setPaddingPolicy(policy);
+      CPPUNIT_ASSERT_EQUAL(4096, file.paddingPolicy().reserve());
+    }
+    CPPUNIT_ASSERT_EQUAL(-1, PaddingPolicy::defaultPolicy().reserve());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFile);
@@ -28,6 +28,7 @@
 
 #include "tfilestream.h"
 #include "tbytevectorstream.h"
+#include "tpropertymap.h"
 #include "tag.h"
 #include "fileref.h"
 #include "oggflacfile.h"
@@ -44,10 +45,17 @@
 #include "aifffile.h"
 #include "wavpackfile.h"
 #include "opusfile.h"
+#include "modfile.h"
+#include "itfile.h"
+#include "s3mfile.h"
 #include "xmfile.h"
 #include "dsffile.h"
 #include "dsdifffile.h"
+#include "id3v2tag.h"
+#include "attachedpictureframe.h"
+#include "unknownframe.h"
 #include <cppunit/extensions/HelperMacros.h>
+#include "plainfile.h"
 #include "utils.h"
 
 using namespace std;
@@ -77,6 +85,21 @@ namespace
       return new MP4::File(s);
     }
   };
+
+  class CountingStream : public ByteVectorStream
+  {
+  public:
+    explicit CountingStream(const ByteVector &data) : ByteVectorStream(data) {}
+
+    ByteVector readBlock(size_t length) override
+    {
+      ByteVector data = ByteVectorStream::readBlock(length);
+      bytesRead += data.size();
+      return data;
+    }
+
+    size_t bytesRead { 0 };
+  };
 } // namespace
 
 class TestFileRef : public CppUnit::TestFixture
@@ -107,10 +130,26 @@ class TestFileRef : public CppUnit::TestFixture
   CPPUNIT_TEST(testAudioProperties);
   CPPUNIT_TEST(testDefaultFileExtensions);
   CPPUNIT_TEST(testFileResolver);
+  CPPUNIT_TEST(testPropertyKeys);
+  CPPUNIT_TEST(testPropertyKeysID3v22And23);
+  CPPUNIT_TEST(testTagsOnly);
+  CPPUNIT_TEST(testCreateFile);
   CPPUNIT_TEST_SUITE_END();
 
 public:
 
+  template <typename T>
+  size_t bytesRead(const string &filename, AudioProperties::ReadStyle readStyle)
+  {
+    CountingStream stream(PlainFile(TEST_FILE_PATH_C(filename)).readAll());
+    T f(&stream, true, readStyle);
+    CPPUNIT_ASSERT(f.isValid());
+    CPPUNIT_ASSERT(f.tag());
+    CPPUNIT_ASSERT_EQUAL(readStyle == AudioProperties::TagsOnly,
+                         f.audioProperties() == nullptr);
+    return stream.bytesRead;
+  }
+
   template <typename T>
   void fileRefSave(const string &filename, const string &ext)
   {
@@ -140,6 +179,15 @@ public:
       CPPUNIT_ASSERT_EQUAL(f.tag()->comment(), String("a comment"));
       CPPUNIT_ASSERT_EQUAL(f.tag()->track(), static_cast<unsigned int>(5));
       CPPUNIT_ASSERT_EQUAL(f.tag()->year(), static_cast<unsigned int>(2020));
+      Tag::BasicFields fields;
+      f.tag()->basicFields(fields);
+      CPPUNIT_ASSERT_EQUAL(String("test artist"), fields.artist);
+      CPPUNIT_ASSERT_EQUAL(String("test title"), fields.title);
+      CPPUNIT_ASSERT_EQUAL(String("Test!"), fields.genre);
+      CPPUNIT_ASSERT_EQUAL(String("albummmm"), fields.album);
+      CPPUNIT_ASSERT_EQUAL(String("a comment"), fields.comment);
+      CPPUNIT_ASSERT_EQUAL(5U, fields.track);
+      CPPUNIT_ASSERT_EQUAL(2020U, fields.year);
       f.tag()->setArtist("ttest artist");
       f.tag()->setTitle("ytest title");
       f.tag()->setGenre("uTest!");
@@ -414,6 +462,193 @@ public:
     FileRef::clearFileTypeResolvers();
   }
 
+  void testPropertyKeys()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    {
+      MPEG::File f(newname.c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag(true);
+      tag->setTitle("Title");
+      tag->setArtist("Artist");
+      tag->setComment("Comment");
+      auto frame = new ID3v2::AttachedPictureFrame;
+      frame->setMimeType("image/jpeg");
+      frame->setPicture("JFIF");
+      tag->addFrame(frame);
+      f.save();
+    }
+    {
+      FileRef f(newname.c_str(), false, AudioProperties::Average,
+                StringList({"title", "ARTIST", "ALBUM"}));
+      CPPUNIT_ASSERT(!f.isNull());
+      CPPUNIT_ASSERT(!f.audioProperties());
+
+      const PropertyMap properties = f.properties(StringList({"TITLE", "ARTIST", "ALBUM"}));
+      CPPUNIT_ASSERT_EQUAL(2U, properties.size());
+      CPPUNIT_ASSERT_EQUAL(StringList("Title"), properties["TITLE"]);
+      CPPUNIT_ASSERT_EQUAL(StringList("Artist"), properties["ARTIST"]);
+      CPPUNIT_ASSERT(properties.unsupportedData().isEmpty());
+
+      auto mpegFile = dynamic_cast<MPEG::File *>(f.file());
+      CPPUNIT_ASSERT(mpegFile);
+      CPPUNIT_ASSERT_EQUAL(StringList("Title"),
+                           mpegFile->selectedProperties(StringList("TITLE"))["TITLE"]);
+      const ID3v2::FrameList pictures = mpegFile->ID3v2Tag()->frameList("APIC");
+      CPPUNIT_ASSERT_EQUAL(1U, pictures.size());
+      CPPUNIT_ASSERT(dynamic_cast<ID3v2::UnknownFrame *>(pictures.front()));
+      const ID3v2::FrameList comments = mpegFile->ID3v2Tag()->frameList("COMM");
+      CPPUNIT_ASSERT_EQUAL(1U, comments.size());
+      CPPUNIT_ASSERT(dynamic_cast<ID3v2::UnknownFrame *>(comments.front()));
+
+      f.tag()->setAlbum("Album");
+      f.save();
+    }
+    {
+      MPEG::File f(newname.c_str());
+      CPPUNIT_ASSERT_EQUAL(String("Album"), f.tag()->album());
+      CPPUNIT_ASSERT_EQUAL(String("Comment"), f.tag()->comment());
+      const ID3v2::FrameList pictures = f.ID3v2Tag()->frameList("APIC");
+      CPPUNIT_ASSERT_EQUAL(1U, pictures.size());
+      auto frame = dynamic_cast<ID3v2::AttachedPictureFrame *>(pictures.front());
+      CPPUNIT_ASSERT(frame);
+      CPPUNIT_ASSERT_EQUAL(ByteVector("JFIF"), frame->picture());
+    }
+    {
+      FileRef f(newname.c_str(), true, AudioProperties::Average,
+                StringList("PICTURE"));
+      auto mpegFile = dynamic_cast<MPEG::File *>(f.file());
+      CPPUNIT_ASSERT(mpegFile);
+      CPPUNIT_ASSERT_EQUAL(1U, f.complexProperties("PICTURE").size());
+      CPPUNIT_ASSERT(f.properties(StringList("TITLE")).isEmpty());
+    }
+  }
+
+
+  void testPropertyKeysID3v22And23()
+  {
+    {
+      // The PIC frame of an ID3v2.2 tag is kept if it is not requested.
+      ScopedFileCopy copy("itunes10", ".mp3");
+      string newname = copy.fileName();
+      ByteVector picture;
+      {
+        MPEG::File f(newname.c_str());
+        const ID3v2::FrameList pictures = f.ID3v2Tag()->frameList("APIC");
+        CPPUNIT_ASSERT_EQUAL(1U, pictures.size());
+        picture = dynamic_cast<ID3v2::AttachedPictureFrame *>(pictures.front())->picture();
+        CPPUNIT_ASSERT(!picture.isEmpty());
+      }
+      {
+        FileRef f(newname.c_str(), false, AudioProperties::Average,
+                  StringList("TITLE"));
+        f.tag()->setTitle("Title");
+        CPPUNIT_ASSERT(f.save());
+      }
+      {
+        MPEG::File f(newname.c_str());
+        CPPUNIT_ASSERT_EQUAL(String("Title"), f.tag()->title());
+        const ID3v2::FrameList pictures = f.ID3v2Tag()->frameList("APIC");
+        CPPUNIT_ASSERT_EQUAL(1U, pictures.size());
+        auto frame = dynamic_cast<ID3v2::AttachedPictureFrame *>(pictures.front());
+        CPPUNIT_ASSERT(frame);
+        CPPUNIT_ASSERT_EQUAL(picture, frame->picture());
+      }
+    }
+    {
+      // TDAT and TIME of an ID3v2.3 tag are merged into DATE.
+      ScopedFileCopy copy("xing", ".mp3");
+      string newname = copy.fileName();
+      {
+        MPEG::File f(newname.c_str());
+        PropertyMap properties;
+        properties["TITLE"] = StringList("Title");
+        properties["DATE"] = StringList("2001-03-15T10:20");
+        f.ID3v2Tag(true)->setProperties(properties);
+        CPPUNIT_ASSERT(f.save(MPEG::File::ID3v2, MPEG::File::StripOthers, ID3v2::v3));
+      }
+      const StringList date = MPEG::File(newname.c_str()).properties()["DATE"];
+      CPPUNIT_ASSERT_EQUAL(StringList("2001-03-15 10:20"), date);
+      {
+        FileRef f(newname.c_str(), false, AudioProperties::Average,
+                  StringList("DATE"));
+        CPPUNIT_ASSERT_EQUAL(date, f.properties(StringList("DATE"))["DATE"]);
+      }
+    }
+  }
+
+  void testTagsOnly()
+  {
+    // Only the tags and the headers needed to find them shall be read.  For
+    // formats whose audio properties are read from the audio data or from
+    // the end of the file, this is far less than with the default read style.
+    // The limits for TagsOnly leave some headroom over the bytes read by the
+    // current implementation.
+    struct {
+      size_t (TestFileRef::*bytesRead)(const string &, AudioProperties::ReadStyle);
+      const char *fileName;
+      bool skipsAudioData;
+      size_t maxTagsOnly;
+    } formats[] = {
+      { &TestFileRef::bytesRead<MPEG::File>, "garbage.mp3", true, 64 },
+      { &TestFileRef::bytesRead<MPEG::File>, "xing.mp3", true, 64 },
+      { &TestFileRef::bytesRead<FLAC::File>, "silence-44-s.flac", true, 2048 },
+      { &TestFileRef::bytesRead<FLAC::File>, "sinewave.flac", false, 2048 },
+      { &TestFileRef::bytesRead<MP4::File>, "has-tags.m4a", false, 1024 },
+      { &TestFileRef::bytesRead<MP4::File>, "no-tags.m4a", true, 128 },
+      { &TestFileRef::bytesRead<Ogg::Vorbis::File>, "test.ogg", true, 6144 },
+      { &TestFileRef::bytesRead<Ogg::Opus::File>, "correctness_gain_silent_output.opus", true, 2048 },
+      { &TestFileRef::bytesRead<Ogg::Speex::File>, "empty.spx", true, 2048 },
+      { &TestFileRef::bytesRead<Ogg::FLAC::File>, "empty_flac.oga", false, 12288 },
+      { &TestFileRef::bytesRead<APE::File>, "mac-399-tagged.ape", false, 8192 },
+      { &TestFileRef::bytesRead<MPC::File>, "click.mpc", true, 64 },
+      { &TestFileRef::bytesRead<WavPack::File>, "tagged.wv", false, 512 },
+      { &TestFileRef::bytesRead<TrueAudio::File>, "tagged.tta", false, 3072 },
+      { &TestFileRef::bytesRead<RIFF::WAV::File>, "duplicate_tags.wav", false, 2048 },
+      { &TestFileRef::bytesRead<RIFF::AIFF::File>, "duplicate_id3v2.aiff", false, 2048 },
+      { &TestFileRef::bytesRead<DSF::File>, "empty10ms.dsf", true, 64 },
+      { &TestFileRef::bytesRead<DSDIFF::File>, "empty10ms.dff", false, 128 },
+      { &TestFileRef::bytesRead<ASF::File>, "silence-1.wma", false, 6144 },
+      { &TestFileRef::bytesRead<Mod::File>, "test.mod", false, 1024 },
+      { &TestFileRef::bytesRead<S3M::File>, "test.s3m", false, 512 },
+      { &TestFileRef::bytesRead<IT::File>, "test.it", false, 512 },
+      { &TestFileRef::bytesRead<XM::File>, "test.xm", false, 5120 },
+    };
+
+    for(const auto &format : formats) {
+      const size_t tagsOnly = (this->*format.bytesRead)(format.fileName, AudioProperties::TagsOnly);
+      const size_t average = (this->*format.bytesRead)(format.fileName, AudioProperties::Average);
+      const size_t accurate = (this->*format.bytesRead)(format.fileName, AudioProperties::Accurate);
+      CPPUNIT_ASSERT(tagsOnly <= format.maxTagsOnly);
+      CPPUNIT_ASSERT(tagsOnly <= average);
+      CPPUNIT_ASSERT(average <= accurate);
+      if(format.skipsAudioData)
+        CPPUNIT_ASSERT(tagsOnly * 2 < average);
+    }
+  }
+
+  void testCreateFile()
+  {
+    const StringList formats = FileRef::supportedFormats();
+    CPPUNIT_ASSERT_EQUAL(20U, formats.size());
+    CPPUNIT_ASSERT(formats.contains("MPEG"));
+    CPPUNIT_ASSERT(formats.contains("OggFLAC"));
+    CPPUNIT_ASSERT(formats.contains("DSDIFF"));
+
+    {
+      FileRef f(FileRef::createFile("FLAC", TEST_FILE_PATH_C("no-tags.flac")));
+      CPPUNIT_ASSERT(!f.isNull());
+      CPPUNIT_ASSERT(dynamic_cast<FLAC::File *>(f.file()));
+    }
+    {
+      // The extension is ignored.
+      FileRef f(FileRef::createFile("MP4", TEST_FILE_PATH_C("no-extension")));
+      CPPUNIT_ASSERT(dynamic_cast<MP4::File *>(f.file()));
+    }
+    CPPUNIT_ASSERT(!FileRef::createFile("Unknown", TEST_FILE_PATH_C("no-tags.flac")));
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFileRef);
@@ -28,6 +28,7 @@
 
 #include "tstringlist.h"
 #include "tpropertymap.h"
+#include "tbytevectorstream.h"
 #include "tag.h"
 #include "flacfile.h"
 #include "xiphcomment.h"
@@ -46,6 +47,7 @@ class TestFLAC : public CppUnit::TestFixture
   CPPUNIT_TEST(testSignature);
   CPPUNIT_TEST(testMultipleCommentBlocks);
   CPPUNIT_TEST(testReadPicture);
+  CPPUNIT_TEST(testPictureReference);
   CPPUNIT_TEST(testAddPicture);
   CPPUNIT_TEST(testReplacePicture);
   CPPUNIT_TEST(testRemoveAllPictures);
@@ -60,13 +62,17 @@ class TestFLAC : public CppUnit::TestFixture
   CPPUNIT_TEST(testZeroSizedPadding1);
   CPPUNIT_TEST(testZeroSizedPadding2);
   CPPUNIT_TEST(testShrinkPadding);
+  CPPUNIT_TEST(testPaddingPolicy);
   CPPUNIT_TEST(testSaveID3v1);
   CPPUNIT_TEST(testUpdateID3v2);
   CPPUNIT_TEST(testEmptyID3v2);
   CPPUNIT_TEST(testStripTags);
+  CPPUNIT_TEST(testStripTo);
   CPPUNIT_TEST(testRemoveXiphField);
   CPPUNIT_TEST(testEmptySeekTable);
   CPPUNIT_TEST(testPictureStoredAfterComment);
+  CPPUNIT_TEST(testSaveTagsOnly);
+  CPPUNIT_TEST(testIsModified);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -116,6 +122,50 @@ public:
     CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(150), pic->data().size());
   }
 
+  void testPictureReference()
+  {
+    ScopedFileCopy copy("silence-44-s", ".flac");
+    string newname = copy.fileName();
+
+    ByteVector data;
+    {
+      FLAC::File f(newname.c_str());
+      FLAC::Picture *pic = f.pictureList().front();
+      const PictureReference ref = pic->dataReference();
+      CPPUNIT_ASSERT(!ref.isNull());
+      CPPUNIT_ASSERT_EQUAL(PictureReference::Plain, ref.encoding());
+      CPPUNIT_ASSERT_EQUAL(150U, ref.length());
+
+      ByteVectorStream stream((ByteVector()));
+      CPPUNIT_ASSERT(ref.readTo(&stream));
+      data = *stream.data();
+      CPPUNIT_ASSERT_EQUAL(150U, data.size());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("\x89PNG"), data.mid(0, 4));
+      CPPUNIT_ASSERT_EQUAL(data, pic->data());
+
+      FILE *output = tmpfile();
+      CPPUNIT_ASSERT(ref.copyTo(fileno(output)));
+      ByteVector copied(150U);
+      rewind(output);
+      CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(150),
+                           fread(copied.data(), 1, copied.size(), output));
+      CPPUNIT_ASSERT_EQUAL(data, copied);
+      fclose(output);
+
+      f.setProperties(PropertyMap());
+      CPPUNIT_ASSERT(f.save());
+      CPPUNIT_ASSERT(pic->dataReference().isNull());
+      CPPUNIT_ASSERT_EQUAL(data, pic->data());
+    }
+    {
+      FLAC::File f(newname.c_str());
+      FLAC::Picture *pic = f.pictureList().front();
+      CPPUNIT_ASSERT_EQUAL(data, pic->data());
+      pic->setData("data");
+      CPPUNIT_ASSERT(pic->dataReference().isNull());
+    }
+  }
+
   void testAddPicture()
   {
     ScopedFileCopy copy("silence-44-s", ".flac");
@@ -441,6 +491,43 @@ public:
     }
   }
 
+  void testPaddingPolicy()
+  {
+    ScopedFileCopy copy("no-tags", ".flac");
+
+    PaddingPolicy policy;
+    policy.setReserve(64 * 1024);
+    policy.setShrinkMode(PaddingPolicy::NeverShrink);
+
+    offset_t length;
+    {
+      FLAC::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      f.xiphComment()->setTitle(longText(16 * 1024));
+      f.save();
+      length = f.length();
+      CPPUNIT_ASSERT(length > 80 * 1024);
+    }
+    {
+      FLAC::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      f.xiphComment()->setTitle(longText(32 * 1024));
+      f.save();
+      CPPUNIT_ASSERT_EQUAL(length, f.length());
+      f.xiphComment()->setTitle("0123456789");
+      f.save();
+      CPPUNIT_ASSERT_EQUAL(length, f.length());
+    }
+    {
+      FLAC::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(f.isValid());
+      CPPUNIT_ASSERT_EQUAL(String("0123456789"), f.xiphComment()->title());
+      f.xiphComment()->setTitle("ABC");
+      f.save();
+      CPPUNIT_ASSERT(f.length() < 8 * 1024);
+    }
+  }
+
   void testSaveID3v1()
   {
     ScopedFileCopy copy("no-tags", ".flac");
@@ -546,6 +633,44 @@ public:
     }
   }
 
+  void testStripTo()
+  {
+    ByteVectorStream stream(PlainFile(TEST_FILE_PATH_C("silence-44-s.flac")).readAll());
+    {
+      FLAC::File f(&stream);
+      f.ID3v1Tag(true)->setTitle("ID3v1 Title");
+      f.ID3v2Tag(true)->setTitle("ID3v2 Title");
+      CPPUNIT_ASSERT(f.save());
+    }
+    const ByteVector data = *stream.data();
+
+    FLAC::File f(&stream);
+    ByteVectorStream target(ByteVector(100, 'x'));
+    CPPUNIT_ASSERT(f.stripTo(FLAC::File::ID3v2, &target));
+    CPPUNIT_ASSERT_EQUAL(data, *stream.data());
+    CPPUNIT_ASSERT(f.hasID3v2Tag());
+    {
+      FLAC::File stripped(&target);
+      CPPUNIT_ASSERT(stripped.isValid());
+      CPPUNIT_ASSERT(!stripped.hasID3v2Tag());
+      CPPUNIT_ASSERT(stripped.hasID3v1Tag());
+      CPPUNIT_ASSERT_EQUAL(String("ID3v1 Title"), stripped.ID3v1Tag()->title());
+      CPPUNIT_ASSERT_EQUAL(String("Silence"), stripped.xiphComment()->title());
+      CPPUNIT_ASSERT_EQUAL(f.audioProperties()->sampleFrames(),
+                           stripped.audioProperties()->sampleFrames());
+    }
+
+    CPPUNIT_ASSERT(f.stripTo(FLAC::File::AllTags, &target));
+    CPPUNIT_ASSERT_EQUAL(data.size() - f.ID3v2Tag()->header()->completeTagSize() - 128,
+                         target.data()->size());
+    {
+      FLAC::File stripped(&target);
+      CPPUNIT_ASSERT(!stripped.hasID3v2Tag());
+      CPPUNIT_ASSERT(!stripped.hasID3v1Tag());
+      CPPUNIT_ASSERT(stripped.hasXiphComment());
+    }
+  }
+
   void testRemoveXiphField()
   {
     ScopedFileCopy copy("silence-44-s", ".flac");
@@ -663,6 +788,65 @@ public:
     CPPUNIT_ASSERT(fileData.startsWith(expectedData));
   }
 
+
+  void testSaveTagsOnly()
+  {
+    ByteVector expected;
+    {
+      ScopedFileCopy copy("silence-44-s", ".flac");
+      {
+        FLAC::File f(copy.fileName().c_str());
+        f.tag()->setTitle(longText(8192));
+        f.save();
+      }
+      expected = PlainFile(copy.fileName().c_str()).readAll();
+    }
+    {
+      ScopedFileCopy copy("silence-44-s", ".flac");
+      {
+        FLAC::File f(copy.fileName().c_str(), true, AudioProperties::TagsOnly);
+        CPPUNIT_ASSERT(f.isValid());
+        CPPUNIT_ASSERT(!f.audioProperties());
+        f.tag()->setTitle(longText(8192));
+        f.save();
+      }
+      CPPUNIT_ASSERT(PlainFile(copy.fileName().c_str()).readAll() == expected);
+    }
+  }
+
+  void testIsModified()
+  {
+    ScopedFileCopy copy("silence-44-s", ".flac");
+    {
+      FLAC::File f(copy.fileName().c_str());
+      f.xiphComment()->setTitle("Title");
+      CPPUNIT_ASSERT(f.isModified());
+      f.save();
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    const ByteVector fileData = PlainFile(copy.fileName().c_str()).readAll();
+    {
+      FLAC::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.setProperties(f.properties());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.save();
+    }
+    CPPUNIT_ASSERT_EQUAL(fileData, PlainFile(copy.fileName().c_str()).readAll());
+    {
+      FLAC::File f(copy.fileName().c_str());
+      f.xiphComment()->setTitle("Other");
+      CPPUNIT_ASSERT(f.isModified());
+    }
+    {
+      ScopedFileCopy noTags("no-tags", ".flac");
+      FLAC::File f(noTags.fileName().c_str());
+      CPPUNIT_ASSERT(!f.hasXiphComment());
+      CPPUNIT_ASSERT(f.isModified());
+      CPPUNIT_ASSERT(!f.hasXiphComment());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestFLAC);
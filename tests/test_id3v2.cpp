@@ -29,7 +29,9 @@
 
 #include "tpropertymap.h"
 #include "tzlib.h"
+#include "tbytevectorstream.h"
 #include "id3v2tag.h"
+#include "id3v2synchdata.h"
 #include "mpegfile.h"
 #include "id3v2frame.h"
 #include "uniquefileidentifierframe.h"
@@ -68,6 +70,32 @@ class PublicFrame : public ID3v2::Frame
     ByteVector renderFields() const override { return ByteVector(); }
 };
 
+class CountingFrameFactory : public ID3v2::FrameFactory
+{
+  public:
+    using ID3v2::FrameFactory::createFrame;
+    mutable ByteVectorList createdFrames;
+  protected:
+    ID3v2::Frame *createFrame(const ByteVector &data, ID3v2::Frame::Header *header,
+                              const ID3v2::Header *tagHeader) const override
+    {
+      createdFrames.append(header->frameID());
+      return ID3v2::FrameFactory::createFrame(data, header, tagHeader);
+    }
+};
+
+class WriteCountingStream : public ByteVectorStream
+{
+  public:
+    explicit WriteCountingStream(const ByteVector &data) : ByteVectorStream(data) {}
+    void writeBlock(const ByteVector &data) override
+    {
+      bytesWritten += data.size();
+      ByteVectorStream::writeBlock(data);
+    }
+    size_t bytesWritten { 0 };
+};
+
 class TestID3v2 : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestID3v2);
@@ -76,6 +104,7 @@ class TestID3v2 : public CppUnit::TestFixture
   CPPUNIT_TEST(testDowngradeUTF8ForID3v23_2);
   CPPUNIT_TEST(testUTF16BEDelimiter);
   CPPUNIT_TEST(testUTF16Delimiter);
+  CPPUNIT_TEST(testParseUTF8Fields);
   CPPUNIT_TEST(testReadStringField);
   CPPUNIT_TEST(testParseAPIC);
   CPPUNIT_TEST(testParseAPIC_UTF16_BOM);
@@ -139,6 +168,20 @@ class TestID3v2 : public CppUnit::TestFixture
   CPPUNIT_TEST(testEmptyFrame);
   CPPUNIT_TEST(testDuplicateTags);
   CPPUNIT_TEST(testParseTOCFrameWithManyChildren);
+  CPPUNIT_TEST(testChapterIndex);
+  CPPUNIT_TEST(testChapterIndexNested);
+  CPPUNIT_TEST(testIsEmptyDiscardedFrames);
+  CPPUNIT_TEST(testDetachedChapterFrame);
+  CPPUNIT_TEST(testChapterIndexLookup);
+  CPPUNIT_TEST(testTextFrameUTF8Values);
+  CPPUNIT_TEST(testLazyFrames);
+  CPPUNIT_TEST(testLazyFramesID3v22);
+  CPPUNIT_TEST(testRenderUnaccessedFrames);
+  CPPUNIT_TEST(testPictureReference);
+  CPPUNIT_TEST(testUnsynchronisedPictureReference);
+  CPPUNIT_TEST(testSaveInPlace);
+  CPPUNIT_TEST(testFrameClasses);
+  CPPUNIT_TEST(testRenderCompressedFrame);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -246,6 +289,45 @@ public:
     CPPUNIT_ASSERT_EQUAL(String("Foo Bar"), f.toString());
   }
 
+  void testParseUTF8Fields()
+  {
+    const ByteVector fields[] = {
+      ByteVector("\x00" "abc\0d\xe9", 7),
+      ByteVector("\x01" "\xff\xfe" "F\0o\0o\0\0\0" "B\0a\0r\0", 17),
+      ByteVector("\x01" "\xfe\xff" "\0F\0o\0o\0\0" "\xff\xfe" "B\0a\0r\0", 19),
+      ByteVector("\x02" "\0a\xd8\x3d\xde\x00", 7),
+      ByteVector("\x03" "x\0\xc3\xa9\0\0", 7),
+      ByteVector("\x03" "\xff", 2),
+      ByteVector("\x01" "\0\xd8", 3),
+    };
+    for(const auto &data : fields) {
+      ID3v2::TextIdentificationFrame f(ByteVector("TPE1\x00\x00\x00", 7) +
+                                       ByteVector(static_cast<char>(data.size())) +
+                                       ByteVector(2, '\0') + data);
+      CPPUNIT_ASSERT_EQUAL(f.fieldListUTF8(),
+                           ID3v2::TextIdentificationFrame::parseUTF8Fields(data));
+    }
+
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"abc", "d\xc3\xa9"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[0]));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"Foo", "Bar"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[1]));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"Foo", "Bar"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[2]));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"a\xf0\x9f\x98\x80"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[3]));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"x", "\xc3\xa9"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[4]));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{""}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(fields[5]));
+
+    const ByteVector txxx("\x03" "\0" "value", 7);
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"value"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(txxx));
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"", "value"}),
+                         ID3v2::TextIdentificationFrame::parseUTF8Fields(txxx, true));
+  }
+
   void testBrokenFrame1()
   {
     MPEG::File f(TEST_FILE_PATH_C("broken-tenc.id3"), false);
@@ -1704,6 +1786,493 @@ public:
     CPPUNIT_ASSERT(tocFrame->embeddedFrameList().isEmpty());
   }
 
+  void testChapterIndex()
+  {
+    CountingFrameFactory factory;
+    MPEG::File f(TEST_FILE_PATH_C("toc_many_children.mp3"), true,
+                 MPEG::Properties::Average, &factory);
+    ID3v2::Tag *tag = f.ID3v2Tag();
+
+    // The index is built without creating any frames.
+    ID3v2::ChapterIndex index = tag->chapterIndex();
+    CPPUNIT_ASSERT(factory.createdFrames.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(129U, index.size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter0"), index.chapter(0).elementID);
+    CPPUNIT_ASSERT_EQUAL(100U, index.chapter(0).startTime);
+    CPPUNIT_ASSERT_EQUAL(128, index.find("chapter128"));
+    CPPUNIT_ASSERT_EQUAL(12900U, index.chapter(128).startTime);
+    CPPUNIT_ASSERT_EQUAL(-1, index.find("chap2"));
+
+    CPPUNIT_ASSERT_EQUAL(1U, index.tablesOfContents().size());
+    CPPUNIT_ASSERT(index.chapterOrder().isEmpty());
+    const ByteVectorList order = index.chapterOrder("toc");
+    CPPUNIT_ASSERT_EQUAL(129U, order.size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter0"), order.front());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter128"), order.back());
+
+    // Only the chapter which is looked up is created, together with its
+    // embedded frames, using the factory of the tag.
+    ID3v2::ChapterFrame *chapter = ID3v2::ChapterFrame::findByElementID(tag, "chapter2");
+    CPPUNIT_ASSERT(chapter);
+    CPPUNIT_ASSERT_EQUAL((ByteVectorList{"CHAP", "TIT2"}), factory.createdFrames);
+    CPPUNIT_ASSERT_EQUAL(String("Marker 3"), chapter->embeddedFrameList("TIT2").front()->toString());
+    CPPUNIT_ASSERT_EQUAL(chapter, ID3v2::ChapterFrame::findByElementID(tag, "chapter2"));
+    CPPUNIT_ASSERT(!ID3v2::ChapterFrame::findByElementID(tag, "chap2"));
+    CPPUNIT_ASSERT_EQUAL(2U, factory.createdFrames.size());
+
+    // Changes of the created chapter are reflected by the index.
+    chapter->setStartTime(50);
+    index = tag->chapterIndex();
+    CPPUNIT_ASSERT_EQUAL(129U, index.size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter2"), index.chapter(0).elementID);
+
+    // The other chapters are created in the order of the tag.
+    const ID3v2::FrameList &chapters = tag->frameList("CHAP");
+    CPPUNIT_ASSERT_EQUAL(129U, chapters.size());
+    CPPUNIT_ASSERT_EQUAL(chapter, dynamic_cast<ID3v2::ChapterFrame *>(chapters[2]));
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter0"),
+                         dynamic_cast<ID3v2::ChapterFrame *>(chapters.front())->elementID());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter128"),
+                         dynamic_cast<ID3v2::ChapterFrame *>(chapters.back())->elementID());
+    index = tag->chapterIndex();
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter2"), index.chapter(0).elementID);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter2"),
+                         ID3v2::ChapterFrame::findByElementID(tag, "chapter2")->elementID());
+  }
+
+  void testIsEmptyDiscardedFrames()
+  {
+    // A tag whose only frame has the tag alter preservation flag set is
+    // empty, as render() discards the frame.
+    const ByteVector frame = ByteVector("TIT2") + ByteVector::fromUInt(6U) +
+                             ByteVector("\x40\x00", 2) + ByteVector("\x03Title", 6);
+    ByteVectorStream stream(ByteVector("ID3\x04\x00\x00", 6) +
+                            ByteVector::fromUInt(frame.size()) + frame +
+                            ByteVector(1024, '\0'));
+    MPEG::File f(&stream);
+    ID3v2::Tag *tag = f.ID3v2Tag();
+    CPPUNIT_ASSERT(tag);
+    CPPUNIT_ASSERT(tag->isEmpty());
+    CPPUNIT_ASSERT_EQUAL(1U, tag->frameList().size());
+    CPPUNIT_ASSERT(tag->isEmpty());
+    CPPUNIT_ASSERT_EQUAL(-1, tag->render().find("TIT2"));
+
+    tag->setArtist("Artist");
+    CPPUNIT_ASSERT(!tag->isEmpty());
+  }
+
+  void testChapterIndexNested()
+  {
+    const ID3v2::ChapterIndex index(
+      List<ID3v2::ChapterIndex::Chapter>{
+        { "a", 0, 100, 0xFFFFFFFF, 0xFFFFFFFF },
+        { "b", 10, 20, 0xFFFFFFFF, 0xFFFFFFFF },
+        { "c", 30, 40, 0xFFFFFFFF, 0xFFFFFFFF }
+      },
+      List<ID3v2::ChapterIndex::TableOfContents>());
+    CPPUNIT_ASSERT_EQUAL(0, index.chapterAt(5));
+    CPPUNIT_ASSERT_EQUAL(1, index.chapterAt(15));
+    CPPUNIT_ASSERT_EQUAL(0, index.chapterAt(25));
+    CPPUNIT_ASSERT_EQUAL(2, index.chapterAt(35));
+    CPPUNIT_ASSERT_EQUAL(0, index.chapterAt(50));
+    CPPUNIT_ASSERT_EQUAL(-1, index.chapterAt(100));
+  }
+
+  void testDetachedChapterFrame()
+  {
+    ID3v2::ChapterFrame *chapter = nullptr;
+    {
+      MPEG::File f(TEST_FILE_PATH_C("toc_many_children.mp3"));
+      chapter = ID3v2::ChapterFrame::findByElementID(f.ID3v2Tag(), "chapter2");
+      CPPUNIT_ASSERT(chapter);
+      f.ID3v2Tag()->removeFrame(chapter, false);
+    }
+
+    // The frame does not depend on the tag after it has been removed.
+    CPPUNIT_ASSERT_EQUAL(ByteVector("chapter2"), chapter->elementID());
+    CPPUNIT_ASSERT_EQUAL(1U, chapter->embeddedFrameList().size());
+    CPPUNIT_ASSERT_EQUAL(String("Marker 3"), chapter->embeddedFrameList("TIT2").front()->toString());
+    CPPUNIT_ASSERT(!chapter->render().isEmpty());
+    delete chapter;
+  }
+
+  void testChapterIndexLookup()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    {
+      MPEG::File f(copy.fileName().c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag(true);
+      tag->addFrame(new ID3v2::ChapterFrame("c2", 5000, 9000, 0xFFFFFFFF, 0xFFFFFFFF));
+      tag->addFrame(new ID3v2::ChapterFrame("c1", 1000, 5000, 0xFFFFFFFF, 0xFFFFFFFF));
+      tag->addFrame(new ID3v2::ChapterFrame("c3", 9000, 9500, 0xFFFFFFFF, 0xFFFFFFFF));
+      auto top = new ID3v2::TableOfContentsFrame("top", ByteVectorList{"c1", "sub"});
+      top->setIsTopLevel(true);
+      tag->addFrame(top);
+      tag->addFrame(new ID3v2::TableOfContentsFrame("sub", ByteVectorList{"c3", "c2"}));
+
+      const ID3v2::ChapterIndex index = tag->chapterIndex();
+      CPPUNIT_ASSERT_EQUAL(ByteVector("c1"), index.chapter(0).elementID);
+      CPPUNIT_ASSERT_EQUAL(1, index.chapterAt(5000));
+      f.save();
+    }
+    {
+      MPEG::File f(copy.fileName().c_str());
+      const ID3v2::ChapterIndex index = f.ID3v2Tag()->chapterIndex();
+      CPPUNIT_ASSERT_EQUAL(3U, index.size());
+      CPPUNIT_ASSERT_EQUAL(-1, index.chapterAt(999));
+      CPPUNIT_ASSERT_EQUAL(0, index.chapterAt(1000));
+      CPPUNIT_ASSERT_EQUAL(0, index.chapterAt(4999));
+      CPPUNIT_ASSERT_EQUAL(1, index.chapterAt(5000));
+      CPPUNIT_ASSERT_EQUAL(2, index.chapterAt(9499));
+      CPPUNIT_ASSERT_EQUAL(-1, index.chapterAt(9500));
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"c1", "c3", "c2"}), index.chapterOrder());
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"c3", "c2"}), index.chapterOrder("sub"));
+    }
+  }
+
+  void testTextFrameUTF8Values()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    {
+      MPEG::File f(copy.fileName().c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag(true);
+      auto artists = new ID3v2::TextIdentificationFrame("TPE1", String::UTF16);
+      artists->setText(StringList{"Foo", String(L"B\u00e4r")});
+      tag->addFrame(artists);
+      tag->setTitle(String(L"T\u00eftle"));
+      tag->setGenre("Pop");
+      f.save(MPEG::File::ID3v2, File::StripOthers, ID3v2::v4);
+    }
+    {
+      MPEG::File f(copy.fileName().c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag();
+
+      // Decoded from the tag data
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"Foo", "B\xc3\xa4r"}),
+                           tag->textFrameUTF8Values("TPE1"));
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"T\xc3\xaftle"}),
+                           tag->textFrameUTF8Values("TIT2"));
+      CPPUNIT_ASSERT(tag->textFrameUTF8Values("TALB").isEmpty());
+
+      // Decoded from the frames
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"Pop"}), tag->textFrameUTF8Values("TCON"));
+      CPPUNIT_ASSERT_EQUAL(String(L"B\u00e4r"), tag->frameList("TPE1").front()->toStringList().back());
+      CPPUNIT_ASSERT_EQUAL((ByteVectorList{"Foo", "B\xc3\xa4r"}),
+                           tag->textFrameUTF8Values("TPE1"));
+    }
+  }
+
+  void testLazyFrames()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+    {
+      MPEG::File f(newname.c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag(true);
+      tag->setTitle("Title");
+      tag->setArtist("Artist");
+      auto picture = new ID3v2::AttachedPictureFrame;
+      picture->setMimeType("image/png");
+      picture->setPicture(ByteVector(4096, 'x'));
+      tag->addFrame(picture);
+      f.save(MPEG::File::ID3v2);
+    }
+    {
+      CountingFrameFactory factory;
+      MPEG::File f(newname.c_str(), true, MPEG::Properties::Average, &factory);
+      ID3v2::Tag *tag = f.ID3v2Tag();
+      CPPUNIT_ASSERT(!tag->isEmpty());
+      CPPUNIT_ASSERT(factory.createdFrames.isEmpty());
+      CPPUNIT_ASSERT_EQUAL(String("Title"), tag->title());
+      CPPUNIT_ASSERT_EQUAL(ByteVectorList{"TIT2"}, factory.createdFrames);
+      tag->setTitle("New Title");
+      f.save(MPEG::File::ID3v2, File::StripNone, ID3v2::v4, File::DoNotDuplicate);
+      CPPUNIT_ASSERT_EQUAL(ByteVectorList{"TIT2"}, factory.createdFrames);
+      CPPUNIT_ASSERT_EQUAL(3U, tag->frameList().size());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("TIT2"), tag->frameList().front()->frameID());
+      CPPUNIT_ASSERT_EQUAL(ByteVector("APIC"), tag->frameList().back()->frameID());
+      CPPUNIT_ASSERT_EQUAL(3U, factory.createdFrames.size());
+    }
+    {
+      MPEG::File f(newname.c_str());
+      ID3v2::Tag *tag = f.ID3v2Tag();
+      CPPUNIT_ASSERT_EQUAL(String("New Title"), tag->title());
+      CPPUNIT_ASSERT_EQUAL(String("Artist"), tag->artist());
+      auto picture = dynamic_cast<ID3v2::AttachedPictureFrame *>(
+        tag->frameList("APIC").front());
+      CPPUNIT_ASSERT(picture);
+      CPPUNIT_ASSERT_EQUAL(String("image/png"), picture->mimeType());
+      CPPUNIT_ASSERT_EQUAL(ByteVector(4096, 'x'), picture->picture());
+    }
+  }
+
+  void testLazyFramesID3v22()
+  {
+    // The PIC frame is found by its ID3v2.4 ID before it is created.
+    MPEG::File f(TEST_FILE_PATH_C("itunes10.mp3"));
+    ID3v2::Tag *tag = f.ID3v2Tag();
+    CPPUNIT_ASSERT_EQUAL(2U, tag->header()->majorVersion());
+    const ID3v2::FrameList pictures = tag->frameList("APIC");
+    CPPUNIT_ASSERT_EQUAL(1U, pictures.size());
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::AttachedPictureFrame *>(pictures.front()));
+    CPPUNIT_ASSERT(tag->complexPropertyKeys().contains("PICTURE"));
+    CPPUNIT_ASSERT_EQUAL(1U, tag->complexProperties("PICTURE").size());
+    CPPUNIT_ASSERT_EQUAL(1U, tag->frameList("APIC").size());
+  }
+
+  void testRenderUnaccessedFrames()
+  {
+    // The read only flag of the TIT2 frame is not rendered by TagLib, so the
+    // frame is only preserved if it is copied.
+    const ByteVector frames =
+      ByteVector("TIT2\x00\x00\x00\x06\x10\x00\x00Title", 16) +
+      ByteVector("TPE1\x00\x00\x00\x07\x00\x00\x00" "Artist", 17);
+    const ByteVector tagData =
+      ByteVector("ID3\x04\x00\x00", 6) +
+      ID3v2::SynchData::fromUInt(frames.size() + 1024) +
+      frames + ByteVector(1024, '\0');
+    ByteVectorStream stream(tagData +
+                            PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    {
+      MPEG::File f(&stream);
+      ID3v2::Tag *tag = f.ID3v2Tag();
+      CPPUNIT_ASSERT_EQUAL(String("Artist"), tag->artist());
+      CPPUNIT_ASSERT_EQUAL(tagData, tag->render());
+      CPPUNIT_ASSERT(f.save(MPEG::File::ID3v2, File::StripNone, ID3v2::v4,
+                            File::DoNotDuplicate));
+      CPPUNIT_ASSERT_EQUAL(tagData, stream.data()->mid(0, tagData.size()));
+
+      CPPUNIT_ASSERT_EQUAL(String("Title"), tag->title());
+      const ByteVector rendered = tag->render();
+      CPPUNIT_ASSERT_EQUAL(tagData.size(), rendered.size());
+      CPPUNIT_ASSERT_EQUAL(static_cast<char>(0), rendered[18]);
+      CPPUNIT_ASSERT_EQUAL(tagData.mid(20), rendered.mid(20));
+    }
+  }
+
+  void testPictureReference()
+  {
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+    ByteVector pictureData;
+    for(int i = 0; i < 100000; ++i)
+      pictureData.append(static_cast<char>(i * 7));
+    {
+      MPEG::File f(newname.c_str());
+      auto picture = new ID3v2::AttachedPictureFrame;
+      picture->setMimeType("image/png");
+      picture->setPicture(pictureData);
+      CPPUNIT_ASSERT(picture->pictureReference().isNull());
+      f.ID3v2Tag(true)->addFrame(picture);
+      f.save(MPEG::File::ID3v2);
+    }
+    {
+      MPEG::File f(newname.c_str());
+      auto picture = dynamic_cast<ID3v2::AttachedPictureFrame *>(
+        f.ID3v2Tag()->frameList("APIC").front());
+      const PictureReference ref = picture->pictureReference();
+      CPPUNIT_ASSERT(!ref.isNull());
+      CPPUNIT_ASSERT_EQUAL(static_cast<File *>(&f), ref.file());
+      CPPUNIT_ASSERT_EQUAL(PictureReference::Plain, ref.encoding());
+      CPPUNIT_ASSERT_EQUAL(pictureData.size(), ref.length());
+      CPPUNIT_ASSERT_EQUAL(pictureData.size(), ref.size());
+      CPPUNIT_ASSERT_EQUAL(pictureData, ref.data());
+
+      ByteVectorStream stream(ByteVector("x"));
+      stream.seek(0, IOStream::End);
+      CPPUNIT_ASSERT(ref.readTo(&stream));
+      CPPUNIT_ASSERT_EQUAL(ByteVector("x") + pictureData, *stream.data());
+
+      char buffer[10];
+      CPPUNIT_ASSERT_EQUAL(10U, ref.readInto(buffer, 10));
+      CPPUNIT_ASSERT_EQUAL(pictureData.mid(0, 10), ByteVector(buffer, 10));
+    }
+  }
+
+  void testUnsynchronisedPictureReference()
+  {
+    // Picture data with false synchronisations crossing the chunk borders
+    // used when reading references.
+    ByteVector pictureData;
+    for(int i = 0; i < 150000; ++i)
+      pictureData.append(static_cast<char>(i % 3 == 0 ? 0xFF : i % 3 == 1 ? 0x00 : 0xE5));
+    const ByteVector fields =
+      ByteVector("\x00image/png\x00\x03\x00", 13) + pictureData;
+    ByteVector encoded;
+    for(unsigned int i = 0; i < fields.size(); ++i) {
+      encoded.append(fields[i]);
+      if(static_cast<unsigned char>(fields[i]) == 0xFF &&
+         (i + 1 == fields.size() || fields[i + 1] == '\0' ||
+          static_cast<unsigned char>(fields[i + 1]) >= 0xE0))
+        encoded.append('\0');
+    }
+    const ByteVector frame =
+      ByteVector("APIC") + ID3v2::SynchData::fromUInt(encoded.size()) +
+      ByteVector("\x00\x02", 2) + encoded;
+    const ByteVector tagData =
+      ByteVector("ID3\x04\x00\x00", 6) +
+      ID3v2::SynchData::fromUInt(frame.size()) + frame;
+    ByteVectorStream stream(tagData +
+                            PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+
+    MPEG::File f(&stream);
+    auto picture = dynamic_cast<ID3v2::AttachedPictureFrame *>(
+      f.ID3v2Tag()->frameList("APIC").front());
+    CPPUNIT_ASSERT_EQUAL(pictureData, picture->picture());
+    const PictureReference ref = picture->pictureReference();
+    CPPUNIT_ASSERT(!ref.isNull());
+    CPPUNIT_ASSERT_EQUAL(PictureReference::Unsynchronised, ref.encoding());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(10 + 10 + 13), ref.offset());
+    CPPUNIT_ASSERT_EQUAL(encoded.size() - 13, ref.length());
+    CPPUNIT_ASSERT_EQUAL(pictureData.size(), ref.size());
+    CPPUNIT_ASSERT_EQUAL(pictureData, ref.data());
+
+    ByteVectorStream output((ByteVector()));
+    CPPUNIT_ASSERT(ref.readTo(&output));
+    CPPUNIT_ASSERT_EQUAL(pictureData, *output.data());
+    CPPUNIT_ASSERT(!ref.copyTo(1));
+  }
+
+  void testSaveInPlace()
+  {
+    ByteVector pictureData;
+    for(int i = 0; i < 100000; ++i)
+      pictureData.append(static_cast<char>(i * 7));
+
+    ByteVectorStream initial(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    {
+      MPEG::File f(&initial);
+      auto picture = new ID3v2::AttachedPictureFrame;
+      picture->setMimeType("image/png");
+      picture->setPicture(pictureData);
+      f.ID3v2Tag(true)->addFrame(picture);
+      f.ID3v2Tag()->setTitle("Title");
+      f.save(MPEG::File::ID3v2);
+    }
+    const ByteVector fileData = *initial.data();
+
+    WriteCountingStream stream(fileData);
+    {
+      MPEG::File f(&stream);
+      f.ID3v2Tag()->setTitle("Other");
+      f.save(MPEG::File::ID3v2);
+      CPPUNIT_ASSERT(stream.bytesWritten < 100);
+      CPPUNIT_ASSERT_EQUAL(fileData.size(), stream.data()->size());
+
+      // The title grows into the padding, the picture stays in place.
+      stream.bytesWritten = 0;
+      f.ID3v2Tag()->setTitle("A longer title");
+      f.save(MPEG::File::ID3v2);
+      CPPUNIT_ASSERT(stream.bytesWritten < 100);
+      CPPUNIT_ASSERT_EQUAL(fileData.size(), stream.data()->size());
+    }
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT_EQUAL(String("A longer title"), f.ID3v2Tag()->title());
+      auto picture = dynamic_cast<ID3v2::AttachedPictureFrame *>(
+        f.ID3v2Tag()->frameList("APIC").front());
+      CPPUNIT_ASSERT_EQUAL(pictureData, picture->picture());
+      CPPUNIT_ASSERT(f.isValid());
+    }
+    CPPUNIT_ASSERT_EQUAL(fileData.mid(fileData.size() - 1000),
+                         stream.data()->mid(fileData.size() - 1000));
+  }
+
+  void testFrameClasses()
+  {
+    const auto create = [](const char *frameID, unsigned int version) {
+      ID3v2::Header header;
+      header.setMajorVersion(version);
+      const ByteVector body("\x00" "a\x00" "b", 4);
+      ByteVector data(frameID);
+      if(version < 3)
+        data.append(ByteVector::fromUInt(body.size()).mid(1));
+      else
+        data.append(ByteVector::fromUInt(body.size()) + ByteVector(2, '\0'));
+      data.append(body);
+      return std::unique_ptr<ID3v2::Frame>(
+        ID3v2::FrameFactory::instance()->createFrame(data, &header));
+    };
+
+    auto frame = create("TIT2", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::TextIdentificationFrame *>(frame.get()));
+    CPPUNIT_ASSERT(!dynamic_cast<ID3v2::UserTextIdentificationFrame *>(frame.get()));
+    frame = create("TZZZ", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::TextIdentificationFrame *>(frame.get()));
+    frame = create("TXXX", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UserTextIdentificationFrame *>(frame.get()));
+    frame = create("GRP1", 3);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::TextIdentificationFrame *>(frame.get()));
+    frame = create("WOAR", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UrlLinkFrame *>(frame.get()));
+    CPPUNIT_ASSERT(!dynamic_cast<ID3v2::UserUrlLinkFrame *>(frame.get()));
+    frame = create("WXXX", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UserUrlLinkFrame *>(frame.get()));
+    frame = create("PRIV", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::PrivateFrame *>(frame.get()));
+    frame = create("XYZW", 4);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UnknownFrame *>(frame.get()));
+
+    frame = create("TT2", 2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("TIT2"), frame->frameID());
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::TextIdentificationFrame *>(frame.get()));
+    frame = create("WXX", 2);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("WXXX"), frame->frameID());
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UserUrlLinkFrame *>(frame.get()));
+    frame = create("TIM", 2);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UnknownFrame *>(frame.get()));
+    CPPUNIT_ASSERT(frame->header()->tagAlterPreservation());
+    frame = create("TYER", 3);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("TDRC"), frame->frameID());
+    frame = create("TDAT", 3);
+    CPPUNIT_ASSERT(dynamic_cast<ID3v2::UnknownFrame *>(frame.get()));
+    frame = create("TYER", 4);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("TYER"), frame->frameID());
+  }
+
+  void testRenderCompressedFrame()
+  {
+    if(!zlib::isAvailable())
+      return;
+
+    ScopedFileCopy copy("xing", ".mp3");
+    string newname = copy.fileName();
+
+    ByteVector objectData;
+    for(int i = 0; i < 1000; ++i)
+      objectData.append(ByteVector("compressible ") + ByteVector::fromUInt(i % 10));
+
+    for(auto version : {ID3v2::v3, ID3v2::v4}) {
+      {
+        MPEG::File f(newname.c_str());
+        ID3v2::Tag *tag = f.ID3v2Tag(true);
+        tag->removeFrames("GEOB");
+        auto frame = new ID3v2::GeneralEncapsulatedObjectFrame;
+        frame->setObject(objectData);
+        frame->header()->setCompression(true);
+        tag->addFrame(frame);
+        tag->setTitle("Title");
+        tag->frameList("TIT2").front()->header()->setCompression(true);
+        f.save(MPEG::File::ID3v2, File::StripOthers, version);
+        CPPUNIT_ASSERT(f.ID3v2Tag()->header()->tagSize() < objectData.size());
+      }
+      {
+        MPEG::File f(newname.c_str());
+        ID3v2::Tag *tag = f.ID3v2Tag();
+        auto frame = dynamic_cast<ID3v2::GeneralEncapsulatedObjectFrame *>(
+          tag->frameList("GEOB").front());
+        CPPUNIT_ASSERT(frame);
+        CPPUNIT_ASSERT(frame->header()->compression());
+        CPPUNIT_ASSERT(frame->size() < objectData.size());
+        CPPUNIT_ASSERT_EQUAL(objectData, frame->object());
+
+        // Small frames are not compressed.
+        CPPUNIT_ASSERT(!tag->frameList("TIT2").front()->header()->compression());
+        CPPUNIT_ASSERT_EQUAL(String("Title"), tag->title());
+      }
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestID3v2);
@@ -102,6 +102,9 @@ class TestMP4 : public CppUnit::TestFixture
   CPPUNIT_TEST(testNonFullMetaAtom);
   CPPUNIT_TEST(testItemFactory);
   CPPUNIT_TEST(testNonPrintableAtom);
+  CPPUNIT_TEST(testSaveTagsOnly);
+  CPPUNIT_TEST(testPaddingPolicy);
+  CPPUNIT_TEST(testIsModified);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -388,6 +391,8 @@ public:
     CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(79), l[0].data().size());
     CPPUNIT_ASSERT_EQUAL(MP4::CoverArt::JPEG, l[1].format());
     CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(287), l[1].data().size());
+    CPPUNIT_ASSERT_EQUAL(l[0].data(), l[0].dataReference().data());
+    CPPUNIT_ASSERT_EQUAL(l[1].data(), l[1].dataReference().data());
   }
 
   void testCovrWrite()
@@ -867,6 +872,88 @@ public:
         CPPUNIT_ASSERT_EQUAL(String("TITLE"), f.tag()->title());
     }
   }
+
+  void testSaveTagsOnly()
+  {
+    ByteVector expected;
+    {
+      ScopedFileCopy copy("no-tags", ".3g2");
+      {
+        MP4::File f(copy.fileName().c_str());
+        f.tag()->setTitle(longText(8192));
+        f.save();
+      }
+      expected = PlainFile(copy.fileName().c_str()).readAll();
+    }
+    {
+      ScopedFileCopy copy("no-tags", ".3g2");
+      {
+        MP4::File f(copy.fileName().c_str(), true, AudioProperties::TagsOnly);
+        CPPUNIT_ASSERT(f.isValid());
+        CPPUNIT_ASSERT(!f.audioProperties());
+        f.tag()->setTitle(longText(8192));
+        f.save();
+      }
+      CPPUNIT_ASSERT(PlainFile(copy.fileName().c_str()).readAll() == expected);
+    }
+  }
+
+  void testPaddingPolicy()
+  {
+    ScopedFileCopy copy("has-tags", ".m4a");
+
+    PaddingPolicy policy;
+    policy.setReserve(16 * 1024);
+
+    offset_t length;
+    {
+      MP4::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      length = f.length();
+      f.tag()->setTitle(longText(8192));
+      f.save();
+      CPPUNIT_ASSERT(f.length() > length + 20 * 1024);
+      length = f.length();
+    }
+    {
+      MP4::File f(copy.fileName().c_str());
+      f.tag()->setTitle(longText(16 * 1024));
+      f.save();
+      CPPUNIT_ASSERT_EQUAL(length, f.length());
+    }
+    {
+      MP4::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(f.isValid());
+      CPPUNIT_ASSERT_EQUAL(longText(16 * 1024), f.tag()->title());
+    }
+  }
+
+  void testIsModified()
+  {
+    ScopedFileCopy copy("has-tags", ".m4a");
+    {
+      MP4::File f(copy.fileName().c_str());
+      f.tag()->setTitle("Title");
+      CPPUNIT_ASSERT(f.isModified());
+      f.save();
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    const ByteVector fileData = PlainFile(copy.fileName().c_str()).readAll();
+    {
+      MP4::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.setProperties(f.properties());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.save();
+    }
+    CPPUNIT_ASSERT_EQUAL(fileData, PlainFile(copy.fileName().c_str()).readAll());
+    {
+      MP4::File f(copy.fileName().c_str());
+      f.tag()->setTitle("Other");
+      CPPUNIT_ASSERT(f.isModified());
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMP4);
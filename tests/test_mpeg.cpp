@@ -29,6 +29,8 @@
 
 #include "tstring.h"
 #include "tpropertymap.h"
+#include "tbytevectorstream.h"
+#include "tserialization.h"
 #include "mpegfile.h"
 #include "id3v2tag.h"
 #include "id3v1tag.h"
@@ -36,13 +38,68 @@
 #include "mpegproperties.h"
 #include "xingheader.h"
 #include "mpegheader.h"
+#include "mpegframewalker.h"
 #include "id3v2extendedheader.h"
+#include "plainfile.h"
+#include "tagunion.h"
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
 using namespace std;
 using namespace TagLib;
 
+namespace
+{
+  class WriteCountingStream : public ByteVectorStream
+  {
+  public:
+    explicit WriteCountingStream(const ByteVector &data) : ByteVectorStream(data) {}
+
+    void writeBlock(const ByteVector &data) override
+    {
+      bytesWritten += data.size();
+      ByteVectorStream::writeBlock(data);
+    }
+
+    void insert(const ByteVector &data, offset_t start, size_t replace) override
+    {
+      bytesWritten += data.size();
+      ByteVectorStream::insert(data, start, replace);
+    }
+
+    size_t bytesWritten { 0 };
+  };
+
+  class ReadCountingStream : public ByteVectorStream
+  {
+  public:
+    explicit ReadCountingStream(const ByteVector &data) : ByteVectorStream(data) {}
+
+    ByteVector readBlock(size_t length) override
+    {
+      ++readCount;
+      ByteVector data = ByteVectorStream::readBlock(length);
+      bytesRead += data.size();
+      return data;
+    }
+
+    int readCount { 0 };
+    size_t bytesRead { 0 };
+  };
+
+  // Returns count silent MPEG-1 Layer III mono frames at 48 kHz, which have
+  // no padding, with a bitrate of 64 or 128 kbps.
+  ByteVector layer3Frames(int count, int bitrate)
+  {
+    const ByteVector header(bitrate == 128 ? "\xFF\xFB\x94\xC0" : "\xFF\xFB\x54\xC0", 4);
+    const ByteVector frame = header + ByteVector(144 * bitrate / 48 - 4, '\0');
+    ByteVector data;
+    for(int i = 0; i < count; ++i)
+      data.append(frame);
+    return data;
+  }
+}  // namespace
+
 class TestMPEG : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestMPEG);
@@ -51,6 +108,9 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testAudioPropertiesVBRIHeader);
   CPPUNIT_TEST(testAudioPropertiesNoVBRHeaders);
   CPPUNIT_TEST(testAudioPropertiesADTS);
+  CPPUNIT_TEST(testAudioPropertiesAccurate);
+  CPPUNIT_TEST(testAudioPropertiesAccurateCBR);
+  CPPUNIT_TEST(testAudioPropertiesAccurateVBR);
   CPPUNIT_TEST(testSkipInvalidFrames1);
   CPPUNIT_TEST(testSkipInvalidFrames2);
   CPPUNIT_TEST(testSkipInvalidFrames3);
@@ -58,8 +118,13 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testSaveID3v24);
   CPPUNIT_TEST(testSaveID3v23);
   CPPUNIT_TEST(testDuplicateID3v2);
+  CPPUNIT_TEST(testReadID3v2FromBlock);
   CPPUNIT_TEST(testFuzzedFile);
   CPPUNIT_TEST(testFrameOffset);
+  CPPUNIT_TEST(testFrameWalker);
+  CPPUNIT_TEST(testFrameWalkerADTS);
+  CPPUNIT_TEST(testSeekIndexFromTOC);
+  CPPUNIT_TEST(testSeekIndexFromFrames);
   CPPUNIT_TEST(testStripAndProperties);
   CPPUNIT_TEST(testProperties);
   CPPUNIT_TEST(testRepeatedSave1);
@@ -72,6 +137,13 @@ class TestMPEG : public CppUnit::TestFixture
   CPPUNIT_TEST(testExtendedHeader);
   CPPUNIT_TEST(testReadStyleFast);
   CPPUNIT_TEST(testID3v22Properties);
+  CPPUNIT_TEST(testIsModified);
+  CPPUNIT_TEST(testIsModifiedID3v22);
+  CPPUNIT_TEST(testIsModifiedID3v23);
+  CPPUNIT_TEST(testIsModifiedKeepsPosition);
+  CPPUNIT_TEST(testTagUnionBasicFields);
+  CPPUNIT_TEST(testReadTailTags);
+  CPPUNIT_TEST(testStripTo);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -100,6 +172,20 @@ public:
     CPPUNIT_ASSERT_EQUAL(44100, f.audioProperties()->sampleRate());
     CPPUNIT_ASSERT_EQUAL(MPEG::XingHeader::Xing, f.audioProperties()->xingHeader()->type());
     CPPUNIT_ASSERT(!f.audioProperties()->isADTS());
+    CPPUNIT_ASSERT_EQUAL(576, f.audioProperties()->encoderDelay());
+    CPPUNIT_ASSERT_EQUAL(576, f.audioProperties()->encoderPadding());
+
+    const MPEG::XingHeader *xingHeader = f.audioProperties()->xingHeader();
+    CPPUNIT_ASSERT(xingHeader->hasLameExtension());
+    CPPUNIT_ASSERT_EQUAL(String("LAME3.99r"), xingHeader->encoderVersion());
+    CPPUNIT_ASSERT_EQUAL(0x00fcf82cU, xingHeader->musicLength());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(0x753f), xingHeader->musicCRC());
+    CPPUNIT_ASSERT(xingHeader->isLameTagCRCValid());
+    CPPUNIT_ASSERT_EQUAL(0U, xingHeader->framesPerTableEntry());
+    CPPUNIT_ASSERT_EQUAL(100U, xingHeader->tableOfContents().size());
+    CPPUNIT_ASSERT_EQUAL(0U, xingHeader->tableOfContents().front());
+    CPPUNIT_ASSERT_EQUAL(0x02U, xingHeader->tableOfContents()[1]);
+    CPPUNIT_ASSERT_EQUAL(0xfeU, xingHeader->tableOfContents().back());
   }
 
   void testAudioPropertiesVBRIHeader()
@@ -113,6 +199,13 @@ public:
     CPPUNIT_ASSERT_EQUAL(44100, f.audioProperties()->sampleRate());
     CPPUNIT_ASSERT_EQUAL(MPEG::XingHeader::VBRI, f.audioProperties()->xingHeader()->type());
     CPPUNIT_ASSERT(!f.audioProperties()->isADTS());
+
+    const MPEG::XingHeader *xingHeader = f.audioProperties()->xingHeader();
+    CPPUNIT_ASSERT(!xingHeader->hasLameExtension());
+    CPPUNIT_ASSERT_EQUAL(0, f.audioProperties()->encoderDelay());
+    CPPUNIT_ASSERT_EQUAL(64U, xingHeader->framesPerTableEntry());
+    CPPUNIT_ASSERT_EQUAL(132U, xingHeader->tableOfContents().size());
+    CPPUNIT_ASSERT_EQUAL(0x98b1U, xingHeader->tableOfContents().front());
   }
 
   void testAudioPropertiesNoVBRHeaders()
@@ -146,8 +239,13 @@ public:
       CPPUNIT_ASSERT(f.audioProperties());
       CPPUNIT_ASSERT_EQUAL(readStyle == MPEG::Properties::Fast ? 0 : 1,
         f.audioProperties()->lengthInSeconds());
-      CPPUNIT_ASSERT_EQUAL(readStyle == MPEG::Properties::Fast ? 0 : 1176,
+      // With the Accurate read style, the 12 frames are counted, otherwise the
+      // length is estimated from the average frame size.
+      CPPUNIT_ASSERT_EQUAL(readStyle == MPEG::Properties::Fast ? 0 :
+                           readStyle == MPEG::Properties::Accurate ? 1115 : 1176,
         f.audioProperties()->lengthInMilliseconds());
+      CPPUNIT_ASSERT_EQUAL(readStyle == MPEG::Properties::Accurate ? 12U : 0U,
+        f.audioProperties()->frameCount());
       CPPUNIT_ASSERT_EQUAL(readStyle == MPEG::Properties::Fast ? 0 : 1,
         f.audioProperties()->bitrate());
       CPPUNIT_ASSERT_EQUAL(1, f.audioProperties()->channels());
@@ -165,6 +263,38 @@ public:
     }
   }
 
+  void testAudioPropertiesAccurate()
+  {
+    MPEG::File f(TEST_FILE_PATH_C("bladeenc.mp3"), true, MPEG::Properties::Accurate);
+    CPPUNIT_ASSERT(f.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(136U, f.audioProperties()->frameCount());
+    CPPUNIT_ASSERT_EQUAL(3553, f.audioProperties()->lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(64, f.audioProperties()->bitrate());
+  }
+
+  void testAudioPropertiesAccurateCBR()
+  {
+    // The frames of a CBR stream are not walked, only a few of them are read.
+    ReadCountingStream stream(layer3Frames(2000, 128));
+    MPEG::File f(&stream, true, MPEG::Properties::Accurate);
+    CPPUNIT_ASSERT(f.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(2000U, f.audioProperties()->frameCount());
+    CPPUNIT_ASSERT_EQUAL(48000, f.audioProperties()->lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(128, f.audioProperties()->bitrate());
+    CPPUNIT_ASSERT(stream.bytesRead < static_cast<size_t>(stream.length() / 4));
+  }
+
+  void testAudioPropertiesAccurateVBR()
+  {
+    ReadCountingStream stream(layer3Frames(500, 128) + layer3Frames(1000, 64) +
+                              layer3Frames(500, 128));
+    MPEG::File f(&stream, true, MPEG::Properties::Accurate);
+    CPPUNIT_ASSERT(f.audioProperties());
+    CPPUNIT_ASSERT_EQUAL(2000U, f.audioProperties()->frameCount());
+    CPPUNIT_ASSERT_EQUAL(48000, f.audioProperties()->lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(96, f.audioProperties()->bitrate());
+  }
+
   void testSkipInvalidFrames1()
   {
     MPEG::File f(TEST_FILE_PATH_C("invalid-frames1.mp3"));
@@ -269,6 +399,34 @@ public:
     CPPUNIT_ASSERT_EQUAL(44100, f.audioProperties()->sampleRate());
   }
 
+  void testReadID3v2FromBlock()
+  {
+    const ByteVector data =
+      PlainFile(TEST_FILE_PATH_C("duplicate_id3v2.mp3")).readAll();
+    ByteVectorStream stream(data);
+    MPEG::File f(&stream);
+    CPPUNIT_ASSERT_EQUAL(44100, f.audioProperties()->sampleRate());
+
+    // The tag including the duplicate is read from the data, the file is
+    // not accessed.
+
+    f.seek(100);
+    const ID3v2::Tag tag(&f, 0, ID3v2::FrameFactory::instance(), data);
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(100), f.tell());
+    CPPUNIT_ASSERT_EQUAL(f.ID3v2Tag()->header()->completeTagSize(),
+                         tag.header()->completeTagSize());
+    CPPUNIT_ASSERT(tag.header()->completeTagSize() >
+                   ID3v2::Header(data.mid(0, ID3v2::Header::size())).completeTagSize());
+    CPPUNIT_ASSERT_EQUAL(f.ID3v2Tag()->title(), tag.title());
+
+    // Only the missing part is read if the data is shorter.
+
+    const ID3v2::Tag partialTag(&f, 0, ID3v2::FrameFactory::instance(), data.mid(0, 20));
+    CPPUNIT_ASSERT_EQUAL(tag.header()->completeTagSize(),
+                         partialTag.header()->completeTagSize());
+    CPPUNIT_ASSERT_EQUAL(tag.title(), partialTag.title());
+  }
+
   void testFuzzedFile()
   {
     MPEG::File f(TEST_FILE_PATH_C("excessive_alloc.mp3"));
@@ -297,6 +455,137 @@ public:
     }
   }
 
+  void testFrameWalker()
+  {
+    MPEG::File f(TEST_FILE_PATH_C("ape-id3v2.mp3"));
+    CPPUNIT_ASSERT(f.isValid());
+
+    // Small windows must give the same results as a single window.
+    for(unsigned int windowSize : {8U, 100U, MPEG::FrameWalker::DefaultWindowSize}) {
+      MPEG::FrameWalker walker(&f, windowSize);
+      CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(0x041A), walker.nextFrameOffset(0));
+      CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(0x041A), walker.nextFrameOffset(0x041A));
+      CPPUNIT_ASSERT(walker.isValidFrame(0x041A));
+      CPPUNIT_ASSERT(walker.isValidFrame(0x041A, 5));
+      CPPUNIT_ASSERT(!walker.isValidFrame(0x041B));
+
+      const MPEG::Header header = walker.header(0x041A);
+      const MPEG::Header fileHeader(&f, 0x041A, false);
+      CPPUNIT_ASSERT(header.isValid());
+      CPPUNIT_ASSERT_EQUAL(fileHeader.frameLength(), header.frameLength());
+      CPPUNIT_ASSERT_EQUAL(fileHeader.bitrate(), header.bitrate());
+      CPPUNIT_ASSERT_EQUAL(fileHeader.sampleRate(), header.sampleRate());
+
+      const offset_t second = walker.nextFrameOffset(0x041A + 1);
+      CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(0x041A + header.frameLength()), second);
+
+      const offset_t last = walker.previousFrameOffset(f.length());
+      CPPUNIT_ASSERT(last > second);
+      CPPUNIT_ASSERT_EQUAL(f.lastFrameOffset(), last + walker.header(last).frameLength());
+
+      // A chain cannot extend beyond the last frame.
+      CPPUNIT_ASSERT(!walker.isValidFrame(last, 2));
+    }
+
+    // Headers parsed from a buffer are not checked against the next frame.
+    f.seek(0x041A);
+    const ByteVector data = f.readBlock(6);
+    CPPUNIT_ASSERT(MPEG::Header(data).isValid());
+    CPPUNIT_ASSERT(!MPEG::Header(data.mid(0, 3)).isValid());
+    CPPUNIT_ASSERT(!MPEG::Header(data.mid(1)).isValid());
+  }
+
+  void testFrameWalkerADTS()
+  {
+    MPEG::File f(TEST_FILE_PATH_C("empty1s.aac"));
+    CPPUNIT_ASSERT(f.isValid());
+
+    MPEG::FrameWalker walker(&f);
+    const offset_t first = walker.nextFrameOffset(0);
+    CPPUNIT_ASSERT_EQUAL(f.firstFrameOffset(), first);
+
+    const MPEG::Header header = walker.header(first);
+    CPPUNIT_ASSERT(header.isADTS());
+    CPPUNIT_ASSERT_EQUAL(MPEG::Header(&f, first, false).frameLength(), header.frameLength());
+
+    const offset_t last = walker.previousFrameOffset(f.length());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(125), last);
+    CPPUNIT_ASSERT_EQUAL(11, walker.header(last).frameLength());
+    CPPUNIT_ASSERT_EQUAL(f.lastFrameOffset(), last + walker.header(last).frameLength());
+  }
+
+  void testSeekIndexFromTOC()
+  {
+    {
+      MPEG::File f(TEST_FILE_PATH_C("lame_vbr.mp3"));
+      const MPEG::SeekIndex index = f.buildSeekIndex();
+      CPPUNIT_ASSERT_EQUAL(44100, index.sampleRate());
+
+      const MPEG::SeekIndex::EntryList entries = index.entries();
+      CPPUNIT_ASSERT_EQUAL(100U, entries.size());
+      CPPUNIT_ASSERT_EQUAL(0LL, entries.front().sample);
+      CPPUNIT_ASSERT_EQUAL(f.firstFrameOffset(), entries.front().offset);
+      CPPUNIT_ASSERT_EQUAL(entries[50].offset, index.find(entries[50].sample + 1).offset);
+      CPPUNIT_ASSERT_EQUAL(entries.back().offset, index.find(1LL << 40).offset);
+
+      // A coarser granularity skips entries.
+      CPPUNIT_ASSERT_EQUAL(10U, f.buildSeekIndex(188000).entries().size());
+
+      CPPUNIT_ASSERT_EQUAL(100U, MPEG::SeekIndex(index.render()).entries().size());
+    }
+    {
+      MPEG::File f(TEST_FILE_PATH_C("rare_frames.mp3"));
+      const MPEG::SeekIndex index = f.buildSeekIndex(0);
+      const MPEG::SeekIndex::EntryList entries = index.entries();
+      CPPUNIT_ASSERT_EQUAL(132U, entries.size());
+      CPPUNIT_ASSERT_EQUAL(0LL, entries.front().sample);
+      CPPUNIT_ASSERT_EQUAL(64LL * 1152, entries[1].sample);
+      CPPUNIT_ASSERT_EQUAL(entries.front().offset + 0x98b1, entries[1].offset);
+    }
+  }
+
+  void testSeekIndexFromFrames()
+  {
+    MPEG::File f(TEST_FILE_PATH_C("bladeenc.mp3"));
+    const MPEG::SeekIndex index = f.buildSeekIndex();
+
+    // 136 frames with 1152 samples, at least 44100 samples apart
+    const MPEG::SeekIndex::EntryList entries = index.entries();
+    CPPUNIT_ASSERT_EQUAL(4U, entries.size());
+    CPPUNIT_ASSERT_EQUAL(0LL, entries[0].sample);
+    CPPUNIT_ASSERT_EQUAL(39LL * 1152, entries[1].sample);
+    CPPUNIT_ASSERT_EQUAL(f.firstFrameOffset(), entries[0].offset);
+    for(const auto &entry : entries)
+      CPPUNIT_ASSERT(MPEG::Header(&f, entry.offset).isValid());
+
+    const MPEG::SeekIndex rendered(index.render());
+    CPPUNIT_ASSERT_EQUAL(44100, rendered.sampleRate());
+    CPPUNIT_ASSERT_EQUAL(4U, rendered.entries().size());
+    CPPUNIT_ASSERT_EQUAL(entries[2].sample, rendered.entries()[2].sample);
+    CPPUNIT_ASSERT_EQUAL(entries[2].offset, rendered.entries()[2].offset);
+    CPPUNIT_ASSERT_EQUAL(entries[1].offset, rendered.find(entries[2].sample - 1).offset);
+
+    CPPUNIT_ASSERT(MPEG::SeekIndex(index.render().mid(0, 40)).isEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(-1), MPEG::SeekIndex().find(0).offset);
+
+    // The index is stored using the serialization of complex properties.
+    List<VariantMap> maps;
+    CPPUNIT_ASSERT(Serialization::deserialize(index.render(), maps));
+    CPPUNIT_ASSERT_EQUAL(1U, maps.size());
+    CPPUNIT_ASSERT_EQUAL(44100, maps.front().value("sampleRate").toInt());
+
+    // Entries which are not strictly increasing are rejected.
+    MPEG::SeekIndex::EntryList unsorted;
+    unsorted.append(MPEG::SeekIndex::Entry(0, 100));
+    unsorted.append(MPEG::SeekIndex::Entry(1152, 500));
+    unsorted.append(MPEG::SeekIndex::Entry(1152, 900));
+    CPPUNIT_ASSERT(MPEG::SeekIndex(MPEG::SeekIndex(44100, unsorted).render()).isEmpty());
+    unsorted.back() = MPEG::SeekIndex::Entry(2304, 500);
+    CPPUNIT_ASSERT(MPEG::SeekIndex(MPEG::SeekIndex(44100, unsorted).render()).isEmpty());
+    unsorted.back() = MPEG::SeekIndex::Entry(2304, 900);
+    CPPUNIT_ASSERT_EQUAL(3U, MPEG::SeekIndex(MPEG::SeekIndex(44100, unsorted).render()).entries().size());
+  }
+
   void testStripAndProperties()
   {
     ScopedFileCopy copy("xing", ".mp3");
@@ -669,6 +958,272 @@ public:
     CPPUNIT_ASSERT_EQUAL(2315U, data.size());
   }
 
+  void testIsModified()
+  {
+    ByteVectorStream initial(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    {
+      MPEG::File f(&initial);
+      CPPUNIT_ASSERT(!f.isModified());
+      f.tag()->setTitle("Title");
+      f.tag()->setArtist("Artist");
+      f.APETag(true)->setAlbum("Album");
+      CPPUNIT_ASSERT(f.isModified());
+      f.save();
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+
+    WriteCountingStream stream(*initial.data());
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT(!f.isModified());
+      f.setProperties(f.properties());
+      f.APETag()->setAlbum("Album");
+      CPPUNIT_ASSERT(!f.isModified());
+      CPPUNIT_ASSERT(f.save());
+      CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), stream.bytesWritten);
+
+      f.ID3v1Tag()->setArtist("Other");
+      CPPUNIT_ASSERT(f.isModified());
+      CPPUNIT_ASSERT(f.save());
+      CPPUNIT_ASSERT(stream.bytesWritten > 0);
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT_EQUAL(String("Other"), f.ID3v1Tag()->artist());
+      CPPUNIT_ASSERT_EQUAL(String("Artist"), f.ID3v2Tag()->artist());
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+  }
+
+  void testIsModifiedID3v22()
+  {
+    for(const auto fileName : {"itunes10.mp3", "id3v22-tda.mp3"}) {
+      ByteVectorStream stream(PlainFile(TEST_FILE_PATH_C(fileName)).readAll());
+      {
+        MPEG::File f(&stream);
+        CPPUNIT_ASSERT(!f.isModified());
+        CPPUNIT_ASSERT_EQUAL(2U, f.ID3v2Tag()->header()->majorVersion());
+
+        f.ID3v2Tag()->setProperties(f.ID3v2Tag()->properties());
+        CPPUNIT_ASSERT(!f.isModified());
+        CPPUNIT_ASSERT_EQUAL(2U, f.ID3v2Tag()->header()->majorVersion());
+
+        f.ID3v2Tag()->setTitle("Title");
+        CPPUNIT_ASSERT(f.isModified());
+        CPPUNIT_ASSERT(f.save(MPEG::File::AllTags, File::StripNone, ID3v2::v3));
+        CPPUNIT_ASSERT(!f.isModified());
+        CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+      }
+      {
+        MPEG::File f(&stream);
+        CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+        CPPUNIT_ASSERT_EQUAL(String("Title"), f.ID3v2Tag()->title());
+        CPPUNIT_ASSERT(!f.isModified());
+      }
+    }
+  }
+
+  void testIsModifiedID3v23()
+  {
+    ByteVector fileData = PlainFile(TEST_FILE_PATH_C("lame_cbr.mp3")).readAll();
+    WriteCountingStream stream(fileData);
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+      CPPUNIT_ASSERT(!f.isModified());
+      CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+
+      f.ID3v2Tag()->setProperties(f.ID3v2Tag()->properties());
+      CPPUNIT_ASSERT(!f.isModified());
+
+      f.ID3v2Tag()->setTitle("Title");
+      CPPUNIT_ASSERT(f.isModified());
+      CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+      CPPUNIT_ASSERT(f.save(MPEG::File::AllTags, File::StripNone, ID3v2::v3));
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+      CPPUNIT_ASSERT_EQUAL(String("Title"), f.ID3v2Tag()->title());
+      CPPUNIT_ASSERT(!f.isModified());
+
+      const size_t bytesWritten = stream.bytesWritten;
+      CPPUNIT_ASSERT(f.save(MPEG::File::AllTags, File::StripNone, ID3v2::v3));
+      CPPUNIT_ASSERT_EQUAL(bytesWritten, stream.bytesWritten);
+
+      // Without an explicit version, an unmodified tag is not converted.
+      f.setProperties(f.properties());
+      CPPUNIT_ASSERT(!f.isModified());
+      CPPUNIT_ASSERT(f.save());
+      CPPUNIT_ASSERT_EQUAL(bytesWritten, stream.bytesWritten);
+    }
+    {
+      MPEG::File f(&stream);
+      CPPUNIT_ASSERT_EQUAL(3U, f.ID3v2Tag()->header()->majorVersion());
+    }
+  }
+
+  void testIsModifiedKeepsPosition()
+  {
+    WriteCountingStream stream(PlainFile(TEST_FILE_PATH_C("itunes10.mp3")).readAll());
+    MPEG::File f(&stream);
+    CPPUNIT_ASSERT_EQUAL(2U, f.ID3v2Tag()->header()->majorVersion());
+    f.ID3v2Tag()->setProperties(f.ID3v2Tag()->properties());
+
+    f.seek(100);
+    CPPUNIT_ASSERT(!f.isModified());
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(100), f.tell());
+    CPPUNIT_ASSERT(!f.ID3v2Tag()->isModified(&stream, 0, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<offset_t>(100), f.tell());
+
+    CPPUNIT_ASSERT(f.save());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), stream.bytesWritten);
+    CPPUNIT_ASSERT_EQUAL(2U, f.ID3v2Tag()->header()->majorVersion());
+  }
+
+  void testTagUnionBasicFields()
+  {
+    ByteVectorStream stream(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+    MPEG::File f(&stream);
+    f.ID3v2Tag(true)->setTitle("Title 2");
+    f.ID3v2Tag()->setYear(2001);
+    f.ID3v1Tag(true)->setTitle("Title 1");
+    f.ID3v1Tag()->setArtist("Artist 1");
+    f.ID3v1Tag()->setTrack(7);
+    f.APETag(true)->setGenre("Genre");
+
+    auto tag = dynamic_cast<TagUnion *>(f.tag());
+    CPPUNIT_ASSERT(tag);
+    Tag::BasicFields fields;
+    tag->basicFields(fields);
+    CPPUNIT_ASSERT_EQUAL(String("Title 2"), fields.title);
+    CPPUNIT_ASSERT_EQUAL(String("Artist 1"), fields.artist);
+    CPPUNIT_ASSERT_EQUAL(String(), fields.album);
+    CPPUNIT_ASSERT_EQUAL(String("Genre"), fields.genre);
+    CPPUNIT_ASSERT_EQUAL(2001U, fields.year);
+    CPPUNIT_ASSERT_EQUAL(7U, fields.track);
+    CPPUNIT_ASSERT_EQUAL(tag->title(), fields.title);
+    CPPUNIT_ASSERT_EQUAL(tag->artist(), fields.artist);
+    CPPUNIT_ASSERT_EQUAL(tag->genre(), fields.genre);
+    CPPUNIT_ASSERT_EQUAL(tag->track(), fields.track);
+    CPPUNIT_ASSERT_EQUAL(StringList("Title 2"), tag->properties()["TITLE"]);
+  }
+
+  void testReadTailTags()
+  {
+    ByteVector data;
+    {
+      ByteVectorStream stream(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+      MPEG::File f(&stream);
+      f.ID3v2Tag(true)->setTitle("Title 2");
+      f.ID3v1Tag(true)->setTitle("Title 1");
+      f.APETag(true)->setTitle("Title APE");
+      CPPUNIT_ASSERT(f.save(MPEG::File::AllTags));
+      data = *stream.data();
+    }
+    {
+      // The ID3v1 tag and the APE footer are read in one block.
+      ReadCountingStream stream(data);
+      MPEG::File f(&stream, MPEG::File::TagSelection(MPEG::File::ID3v1));
+      CPPUNIT_ASSERT(f.isValid());
+      CPPUNIT_ASSERT_EQUAL(1, stream.readCount);
+      CPPUNIT_ASSERT(f.hasID3v1Tag());
+      CPPUNIT_ASSERT(!f.hasID3v2Tag());
+      CPPUNIT_ASSERT(!f.hasAPETag());
+      CPPUNIT_ASSERT(!f.audioProperties());
+      CPPUNIT_ASSERT_EQUAL(String("Title 1"), f.tag()->title());
+      CPPUNIT_ASSERT(!f.save());
+      CPPUNIT_ASSERT(!f.strip());
+      CPPUNIT_ASSERT_EQUAL(data, *stream.data());
+    }
+    {
+      ReadCountingStream stream(data);
+      MPEG::File f(&stream, MPEG::File::TagSelection(MPEG::File::ID3v1 | MPEG::File::APE));
+      CPPUNIT_ASSERT_EQUAL(2, stream.readCount);
+      CPPUNIT_ASSERT(f.hasID3v1Tag());
+      CPPUNIT_ASSERT(!f.hasID3v2Tag());
+      CPPUNIT_ASSERT(f.hasAPETag());
+      CPPUNIT_ASSERT_EQUAL(String("Title APE"), f.APETag()->title());
+    }
+    {
+      ReadCountingStream stream(data);
+      MPEG::File f(&stream, MPEG::File::TagSelection(MPEG::File::AllTags));
+      CPPUNIT_ASSERT(f.hasID3v2Tag());
+      CPPUNIT_ASSERT_EQUAL(String("Title 2"), f.tag()->title());
+      CPPUNIT_ASSERT(!f.audioProperties());
+      CPPUNIT_ASSERT(f.save());
+    }
+    {
+      ByteVectorStream stream(data);
+      MPEG::File f(&stream, MPEG::File::TagSelection(
+        MPEG::File::ID3v1 | MPEG::File::ID3v2 | MPEG::File::APE));
+      CPPUNIT_ASSERT(f.hasAPETag());
+      CPPUNIT_ASSERT(f.save());
+      ByteVectorStream target((ByteVector()));
+      CPPUNIT_ASSERT(f.stripTo(MPEG::File::APE, &target));
+    }
+    {
+      ByteVectorStream stream(data);
+      MPEG::File f(&stream, MPEG::File::TagSelection(MPEG::File::ID3v2 | MPEG::File::APE));
+      ByteVectorStream target((ByteVector()));
+      CPPUNIT_ASSERT(!f.stripTo(MPEG::File::APE, &target));
+    }
+    {
+      // A small APE tag without ID3v1 tag is completely in the tail block.
+      ByteVectorStream stream(PlainFile(TEST_FILE_PATH_C("xing.mp3")).readAll());
+      {
+        MPEG::File f(&stream);
+        f.APETag(true)->setTitle("APE");
+        CPPUNIT_ASSERT(f.save(MPEG::File::APE));
+      }
+      ReadCountingStream tailStream(*stream.data());
+      MPEG::File f(&tailStream, MPEG::File::TagSelection(MPEG::File::APE));
+      CPPUNIT_ASSERT_EQUAL(1, tailStream.readCount);
+      CPPUNIT_ASSERT(!f.hasID3v1Tag());
+      CPPUNIT_ASSERT(f.hasAPETag());
+      CPPUNIT_ASSERT_EQUAL(String("APE"), f.APETag()->title());
+    }
+  }
+
+  void testStripTo()
+  {
+    const ScopedFileCopy copy("xing", ".mp3");
+    const ByteVector original = PlainFile(copy.fileName().c_str()).readAll();
+    {
+      MPEG::File f(copy.fileName().c_str());
+      f.ID3v2Tag(true)->setTitle("ID3v2");
+      f.APETag(true)->setTitle("APE");
+      f.ID3v1Tag(true)->setTitle("ID3v1");
+      CPPUNIT_ASSERT(f.save(MPEG::File::AllTags));
+    }
+    const ByteVector data = PlainFile(copy.fileName().c_str()).readAll();
+
+    MPEG::File f(copy.fileName().c_str());
+    ByteVectorStream target(ByteVector(10, 'x'));
+    CPPUNIT_ASSERT(f.stripTo(MPEG::File::ID3v2 | MPEG::File::ID3v1, &target));
+    CPPUNIT_ASSERT(f.hasID3v2Tag());
+    CPPUNIT_ASSERT_EQUAL(data, PlainFile(copy.fileName().c_str()).readAll());
+    {
+      MPEG::File stripped(&target);
+      CPPUNIT_ASSERT(!stripped.hasID3v2Tag());
+      CPPUNIT_ASSERT(!stripped.hasID3v1Tag());
+      CPPUNIT_ASSERT(stripped.hasAPETag());
+      CPPUNIT_ASSERT_EQUAL(String("APE"), stripped.APETag()->title());
+      CPPUNIT_ASSERT_EQUAL(f.firstFrameOffset() - f.ID3v2Tag()->header()->completeTagSize(),
+                           stripped.firstFrameOffset());
+    }
+
+    CPPUNIT_ASSERT(f.stripTo(MPEG::File::AllTags, &target));
+    CPPUNIT_ASSERT_EQUAL(original, *target.data());
+
+    // The result equals the file stripped in place.
+    CPPUNIT_ASSERT(f.stripTo(MPEG::File::APE, &target));
+    f.strip(MPEG::File::APE);
+    CPPUNIT_ASSERT_EQUAL(PlainFile(copy.fileName().c_str()).readAll(), *target.data());
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMPEG);
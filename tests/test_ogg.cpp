@@ -32,6 +32,7 @@
 #include "oggfile.h"
 #include "vorbisfile.h"
 #include "oggpageheader.h"
+#include "plainfile.h"
 #include <cppunit/extensions/HelperMacros.h>
 #include "utils.h"
 
@@ -49,6 +50,8 @@ class TestOGG : public CppUnit::TestFixture
   CPPUNIT_TEST(testAudioProperties);
   CPPUNIT_TEST(testPageChecksum);
   CPPUNIT_TEST(testPageGranulePosition);
+  CPPUNIT_TEST(testPaddingPolicy);
+  CPPUNIT_TEST(testIsModified);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -250,6 +253,70 @@ public:
       CPPUNIT_ASSERT_EQUAL(static_cast<long long>(0), f.readBlock(8).toLongLong());
     }
   }
+
+  void testPaddingPolicy()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+
+    PaddingPolicy policy;
+    policy.setReserve(2048);
+    policy.setShrinkMode(PaddingPolicy::NeverShrink);
+
+    offset_t length;
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      f.setPaddingPolicy(policy);
+      f.tag()->setTitle("A");
+      f.save();
+      CPPUNIT_ASSERT(f.packet(1).size() > 2048);
+      length = f.length();
+    }
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT_EQUAL(String("A"), f.tag()->title());
+      f.setPaddingPolicy(policy);
+      f.tag()->setTitle(longText(1024));
+      f.save();
+      CPPUNIT_ASSERT_EQUAL(length, f.length());
+    }
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT_EQUAL(longText(1024), f.tag()->title());
+      CPPUNIT_ASSERT_EQUAL(3, f.audioProperties()->lengthInSeconds());
+      f.tag()->setTitle("B");
+      f.save();
+      CPPUNIT_ASSERT(f.packet(1).size() < 1024);
+    }
+  }
+
+  void testIsModified()
+  {
+    ScopedFileCopy copy("empty", ".ogg");
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      f.tag()->setTitle("Title");
+      CPPUNIT_ASSERT(f.isModified());
+      f.save();
+      CPPUNIT_ASSERT(!f.isModified());
+    }
+    const ByteVector fileData = PlainFile(copy.fileName().c_str()).readAll();
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.setProperties(f.properties());
+      CPPUNIT_ASSERT(!f.isModified());
+      f.save();
+    }
+    CPPUNIT_ASSERT_EQUAL(fileData, PlainFile(copy.fileName().c_str()).readAll());
+    {
+      Vorbis::File f(copy.fileName().c_str());
+      const ByteVector packet = f.packet(1);
+      f.tag()->setTitle("Other");
+      CPPUNIT_ASSERT(f.isModified());
+      CPPUNIT_ASSERT_EQUAL(packet, f.packet(1));
+    }
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestOGG);
@@ -0,0 +1,165 @@
+/***************************************************************************
+    copyright            : (C) 2026 by agent
+    email                : agent@local
+ ***************************************************************************/
+
+/***************************************************************************
+ *   This library is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Lesser General Public License version   *
+ *   2.1 as published by the Free Software Foundation.                     *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful, but   *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA         *
+ *   02110-1301  USA                                                       *
+ *                                                                         *
+ *   Alternatively, this file is available under the Mozilla Public        *
+ *   License Version 1.1.  You may obtain a copy of the License at         *
+ *   http://www.mozilla.org/MPL/                                           *
+ ***************************************************************************/
+
+#include "tserialization.h"
+#include "tstringlist.h"
+#include "tbytevectorlist.h"
+#include "tpropertymap.h"
+#include "fileref.h"
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils.h"
+
+using namespace TagLib;
+
+class TestSerialization : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TestSerialization);
+  CPPUNIT_TEST(testPropertyMap);
+  CPPUNIT_TEST(testPropertyMapView);
+  CPPUNIT_TEST(testComplexProperties);
+  CPPUNIT_TEST(testAudioProperties);
+  CPPUNIT_TEST(testInvalidData);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testPropertyMap()
+  {
+    PropertyMap props;
+    props["TITLE"] = StringList("Title");
+    props["ARTIST"] = StringList({"Artist 1", L"K\x00fcnstler 2"});
+    props["EMPTY"] = StringList();
+    props.addUnsupportedData("APIC");
+
+    const ByteVector data = Serialization::serialize(props);
+    CPPUNIT_ASSERT(data.startsWith("TLSR"));
+
+    PropertyMap result;
+    result["OTHER"] = StringList("value");
+    CPPUNIT_ASSERT(Serialization::deserialize(data, result));
+    CPPUNIT_ASSERT(props == result);
+    CPPUNIT_ASSERT_EQUAL(StringList("APIC"), result.unsupportedData());
+    CPPUNIT_ASSERT(!result.contains("OTHER"));
+  }
+
+  void testPropertyMapView()
+  {
+    PropertyMap props;
+    props["TITLE"] = StringList("Title");
+    props["ARTIST"] = StringList({"Artist 1", L"K\x00fcnstler 2"});
+    props.addUnsupportedData("PRIV");
+
+    const ByteVector data = Serialization::serialize(props);
+    Serialization::PropertyMapView view(data);
+    CPPUNIT_ASSERT(view.isValid());
+    CPPUNIT_ASSERT_EQUAL(2U, view.size());
+    CPPUNIT_ASSERT_EQUAL(ByteVector("ARTIST"), view.key(0));
+    CPPUNIT_ASSERT_EQUAL(ByteVectorList({"Artist 1", "K\xc3\xbcnstler 2"}),
+                         view.values(0));
+    CPPUNIT_ASSERT_EQUAL(1, view.find("title"));
+    CPPUNIT_ASSERT_EQUAL(-1, view.find("ALBUM"));
+    CPPUNIT_ASSERT_EQUAL(StringList("Title"), view.value("Title"));
+    CPPUNIT_ASSERT(view.value("ALBUM").isEmpty());
+    CPPUNIT_ASSERT_EQUAL(ByteVectorList({"PRIV"}), view.unsupportedData());
+    CPPUNIT_ASSERT(props == view.toPropertyMap());
+  }
+
+  void testComplexProperties()
+  {
+    List<VariantMap> props {
+      {
+        {"data", ByteVector("\x89PNG\x0d\x0a\x1a\x0a", 8)},
+        {"mimeType", "image/png"},
+        {"description", String(L"Cover \x2665")},
+        {"pictureType", "Front Cover"},
+        {"width", 100},
+        {"height", 200U},
+        {"flag", true},
+        {"position", -5LL},
+        {"size", 123456789012ULL},
+        {"gain", -2.5},
+        {"nothing", Variant()},
+        {"tags", StringList({"a", "b"})},
+        {"chunks", ByteVectorList({"x", "yz"})},
+        {"nested", VariantList({1, "two", VariantMap {{"three", 3}}})}
+      },
+      {}
+    };
+
+    const ByteVector data = Serialization::serialize(props);
+    List<VariantMap> result;
+    CPPUNIT_ASSERT(Serialization::deserialize(data, result));
+    CPPUNIT_ASSERT_EQUAL(2U, result.size());
+    CPPUNIT_ASSERT(props == result);
+    CPPUNIT_ASSERT_EQUAL(Variant::Int, result.front()["width"].type());
+    CPPUNIT_ASSERT_EQUAL(Variant::UInt, result.front()["height"].type());
+  }
+
+  void testAudioProperties()
+  {
+    FileRef f(TEST_FILE_PATH_C("mpeg2.mp3"));
+    CPPUNIT_ASSERT(f.audioProperties());
+    const ByteVector data = Serialization::serialize(*f.audioProperties());
+
+    AudioPropertiesSnapshot snapshot;
+    CPPUNIT_ASSERT_EQUAL(0, snapshot.lengthInMilliseconds());
+    CPPUNIT_ASSERT(Serialization::deserialize(data, snapshot));
+    CPPUNIT_ASSERT_EQUAL(f.audioProperties()->lengthInMilliseconds(), snapshot.lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(f.audioProperties()->bitrate(), snapshot.bitrate());
+    CPPUNIT_ASSERT_EQUAL(f.audioProperties()->sampleRate(), snapshot.sampleRate());
+    CPPUNIT_ASSERT_EQUAL(f.audioProperties()->channels(), snapshot.channels());
+
+    AudioPropertiesSnapshot copy(static_cast<const AudioProperties &>(snapshot));
+    CPPUNIT_ASSERT_EQUAL(snapshot.lengthInMilliseconds(), copy.lengthInMilliseconds());
+    CPPUNIT_ASSERT_EQUAL(data, Serialization::serialize(copy));
+  }
+
+  void testInvalidData()
+  {
+    PropertyMap props;
+    props["TITLE"] = StringList("Title");
+    const ByteVector data = Serialization::serialize(props);
+
+    PropertyMap result;
+    result["ALBUM"] = StringList("Album");
+    CPPUNIT_ASSERT(!Serialization::deserialize(data.mid(0, data.size() - 1), result));
+    CPPUNIT_ASSERT(!Serialization::deserialize(data + ByteVector("x"), result));
+    CPPUNIT_ASSERT(!Serialization::deserialize(ByteVector("garbage"), result));
+    CPPUNIT_ASSERT_EQUAL(StringList("Album"), result["ALBUM"]);
+    CPPUNIT_ASSERT(!Serialization::PropertyMapView(data.mid(0, 12)).isValid());
+    CPPUNIT_ASSERT_EQUAL(0U, Serialization::PropertyMapView(data.mid(0, 12)).size());
+
+    // Data of another kind is rejected.
+    List<VariantMap> complex;
+    CPPUNIT_ASSERT(!Serialization::deserialize(data, complex));
+
+    // Element count which cannot fit into the data.
+    ByteVector corrupt = Serialization::serialize(List<VariantMap>());
+    corrupt = corrupt.mid(0, 6) + ByteVector::fromUInt(0xffffffffU, false);
+    CPPUNIT_ASSERT(!Serialization::deserialize(corrupt, complex));
+  }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSerialization);
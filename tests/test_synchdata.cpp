@@ -23,6 +23,8 @@
  *   http://www.mozilla.org/MPL/                                           *
  ***************************************************************************/
 
+#include <utility>
+
 #include "id3v2synchdata.h"
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -41,6 +43,9 @@ class TestID3v2SynchData : public CppUnit::TestFixture
   CPPUNIT_TEST(testDecode2);
   CPPUNIT_TEST(testDecode3);
   CPPUNIT_TEST(testDecode4);
+  CPPUNIT_TEST(testDecodeInPlace);
+  CPPUNIT_TEST(testEncode);
+  CPPUNIT_TEST(testEncodeDecodeLarge);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -121,6 +126,54 @@ public:
     CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\xff\xff", 3), a);
   }
 
+  void testDecodeInPlace()
+  {
+    ByteVector a("\x01\xff\x00\x00\xff\xff\x00\x02\xff", 9);
+    ID3v2::SynchData::decodeInPlace(a);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\x01\xff\x00\xff\xff\x02\xff", 7), a);
+
+    // Data without synchronisation bytes is not modified or copied.
+    const ByteVector b("\x01\xff\x02\xff", 4);
+    ByteVector c = b;
+    ID3v2::SynchData::decodeInPlace(c);
+    CPPUNIT_ASSERT(b.data() == std::as_const(c).data());
+    const ByteVector decoded = ID3v2::SynchData::decode(b);
+    CPPUNIT_ASSERT(b.data() == decoded.data());
+
+    // Shared data is not modified.
+    ByteVector d("\xff\x00", 2);
+    ByteVector e = d;
+    ID3v2::SynchData::decodeInPlace(e);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00", 2), d);
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff", 1), e);
+  }
+
+  void testEncode()
+  {
+    CPPUNIT_ASSERT_EQUAL(ByteVector("\xff\x00\x00\xff\x00\xe0\xff\x1f\xff\x00", 10),
+                         ID3v2::SynchData::encode(ByteVector("\xff\x00\xff\xe0\xff\x1f\xff", 7)));
+
+    const ByteVector a("\x01\xff\x02", 3);
+    const ByteVector encoded = ID3v2::SynchData::encode(a);
+    CPPUNIT_ASSERT(a.data() == encoded.data());
+    CPPUNIT_ASSERT_EQUAL(ByteVector(), ID3v2::SynchData::encode(ByteVector()));
+  }
+
+  void testEncodeDecodeLarge()
+  {
+    ByteVector data;
+    for(unsigned int i = 0; i < 100000; ++i)
+      data.append(static_cast<char>(i % 5 == 0 ? 0xff : (i * 37) % 256));
+
+    const ByteVector encoded = ID3v2::SynchData::encode(data);
+    CPPUNIT_ASSERT(encoded.size() > data.size());
+    for(unsigned int i = 0; i + 1 < encoded.size(); ++i) {
+      if(static_cast<unsigned char>(encoded[i]) == 0xff)
+        CPPUNIT_ASSERT((static_cast<unsigned char>(encoded[i + 1]) & 0xe0) != 0xe0);
+    }
+    CPPUNIT_ASSERT_EQUAL(data, ID3v2::SynchData::decode(encoded));
+  }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestID3v2SynchData);
@@ -129,6 +129,16 @@ public:
       CPPUNIT_ASSERT_EQUAL(2U, taglib_tag_track(tag));
       CPPUNIT_ASSERT_EQUAL(2023U, taglib_tag_year(tag));
 
+      TagLib_Basic_Fields fields;
+      taglib_tag_basic_fields(tag, &fields);
+      CPPUNIT_ASSERT_EQUAL("Album"s, std::string(fields.album));
+      CPPUNIT_ASSERT_EQUAL("Artist"s, std::string(fields.artist));
+      CPPUNIT_ASSERT_EQUAL("Comment"s, std::string(fields.comment));
+      CPPUNIT_ASSERT_EQUAL("Genre"s, std::string(fields.genre));
+      CPPUNIT_ASSERT_EQUAL("Title"s, std::string(fields.title));
+      CPPUNIT_ASSERT_EQUAL(2U, fields.track);
+      CPPUNIT_ASSERT_EQUAL(2023U, fields.year);
+
       std::unordered_map<std::string, std::list<std::string>> propertyMap;
       propertiesToMap(file, propertyMap);
       const std::unordered_map<std::string, std::list<std::string>> expected {